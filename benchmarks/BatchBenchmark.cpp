@@ -0,0 +1,117 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * BATCH BENCHMARK
+ *
+ * Compares three ways of recording the same stream of matches:
+ * 1. recordMatch by name (one call per match, two name lookups)
+ * 2. recordMatch by id (one call per match)
+ * 3. recordMatches on the whole batch
+ *
+ * Usage:
+ *   ./batch_benchmark [players] [matches]     defaults 100,000 and 1,000,000
+ */
+
+/**
+ * Build a system with the given number of players
+ */
+void populate(RankingSystem& system, size_t playerCount)
+{
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        system.addPlayer(benchmarkName(i));
+    }
+}
+
+/**
+ * Print one result line
+ */
+void report(const char* label, size_t matches, double seconds)
+{
+    std::cout << std::left << std::setw(24) << label
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << seconds * 1e9 / static_cast<double>(matches)
+              << std::setprecision(2) << static_cast<double>(matches) / seconds / 1e6 << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 100'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 1'000'000);
+
+    /**
+     * The same random matches are used for every variant
+     */
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+
+    std::vector<MatchRecord> batch;
+    batch.reserve(matchCount);
+    while (batch.size() < matchCount)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            batch.push_back({a, b, static_cast<MatchResult>(pickResult(rng))});
+        }
+    }
+
+    std::vector<std::string> names;
+    names.reserve(playerCount);
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        names.push_back(benchmarkName(i));
+    }
+
+    std::cout << "Players: " << playerCount << ", matches: " << matchCount << "\n\n";
+    std::cout << std::left << std::setw(24) << "Path"
+              << std::setw(14) << "ns/match" << "Mmatches/s" << "\n";
+
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        Stopwatch timer;
+        for (const MatchRecord& match : batch)
+        {
+            system.recordMatch(names[match.player1], names[match.player2],
+                               static_cast<int>(match.result));
+        }
+        report("single, by name", matchCount, timer.seconds());
+    }
+
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        Stopwatch timer;
+        for (const MatchRecord& match : batch)
+        {
+            system.recordMatch(match.player1, match.player2, match.result);
+        }
+        report("single, by id", matchCount, timer.seconds());
+    }
+
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        Stopwatch timer;
+        const std::vector<MatchStatus> statuses = system.recordMatches(batch);
+        const double elapsed = timer.seconds();
+        doNotOptimize(statuses.data());
+        report("batch", matchCount, elapsed);
+    }
+
+    return 0;
+}
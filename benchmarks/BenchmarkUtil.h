@@ -0,0 +1,85 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef BENCHMARKUTIL_H
+#define BENCHMARKUTIL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+/**
+ * Small helpers shared by the benchmark programs
+ *
+ * The benchmarks are plain executables like the tests:
+ * no external library, just a timer and some printing
+ *
+ * Build them in Release mode for meaningful numbers:
+ *   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+ */
+
+/**
+ * Stopwatch
+ *
+ * Starts timing when created
+ * seconds() returns the time elapsed since construction
+ */
+class Stopwatch
+{
+
+private:
+
+    std::chrono::steady_clock::time_point start;
+
+public:
+
+    Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+/**
+ * Keeps the optimizer from deleting work whose result is never used
+ *
+ * The empty asm statement claims to read the value, so the compiler
+ * has to compute it; other compilers fall back to a volatile read
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile T copy = value;
+    (void)copy;
+#endif
+}
+
+/**
+ * Read an optional size argument from the command line
+ *
+ * Example: ./lookup_benchmark 1000000
+ * Falls back to defaultValue when the argument is missing
+ */
+inline size_t sizeArgument(int argc, char* argv[], int index, size_t defaultValue)
+{
+    if (argc > index)
+    {
+        return static_cast<size_t>(std::strtoull(argv[index], nullptr, 10));
+    }
+    return defaultValue;
+}
+
+/**
+ * Generate a unique player name for benchmark populations
+ */
+inline std::string benchmarkName(size_t i)
+{
+    return "player" + std::to_string(i);
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * CONSOLE BENCHMARK
+ *
+ * Shows what printing a message per operation costs
+ *
+ * 1. silent:  recordMatch only, as the library works now
+ * 2. console: recordMatch plus "Match recorded successfully!" on std::cout,
+ *             which is what every call used to do inside the library
+ *
+ * The console messages go to standard output and the results go to
+ * standard error, so run it as:
+ *   ./console_benchmark > /dev/null        (cost of the stream itself)
+ *   ./console_benchmark > out.txt          (cost including a real file)
+ *
+ * Usage:
+ *   ./console_benchmark [players] [matches]     defaults 10,000 and 1,000,000
+ */
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 10'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 1'000'000);
+
+    std::mt19937_64 rng{11};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+
+    std::vector<MatchRecord> matches;
+    matches.reserve(matchCount);
+    while (matches.size() < matchCount)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            matches.push_back({a, b, MatchResult::Player1Wins});
+        }
+    }
+
+    std::cerr << std::left << std::setw(12) << "Path"
+              << std::setw(14) << "ns/match" << "Mmatches/s" << "\n";
+
+    for (const bool console : {false, true})
+    {
+        RankingSystem system;
+        for (size_t i = 0; i < playerCount; i++)
+        {
+            system.addPlayer(benchmarkName(i));
+        }
+
+        Stopwatch timer;
+        for (const MatchRecord& match : matches)
+        {
+            const MatchStatus status = system.recordMatch(match.player1, match.player2, match.result);
+            if (console && status == MatchStatus::Recorded)
+            {
+                std::cout << "Match recorded successfully!\n";
+            }
+        }
+        const double elapsed = timer.seconds();
+
+        std::cerr << std::left << std::setw(12) << (console ? "console" : "silent")
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << elapsed * 1e9 / static_cast<double>(matchCount)
+                  << std::setprecision(2) << static_cast<double>(matchCount) / elapsed / 1e6 << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+/**
+ * DELTA BENCHMARK
+ *
+ * What a save costs when only some players changed
+ *
+ * For different shares of active players (1%, 5%, 20%, 50%):
+ * 1. Save a full snapshot
+ * 2. Record matches until about that share of players has played
+ * 3. Time saveDelta and saveSnapshot, and compare the file sizes
+ * 4. Time loading the snapshot plus the delta
+ *
+ * The delta's size follows the number of active players,
+ * the snapshot's the number of players
+ *
+ * Usage:
+ *   ./delta_benchmark [players]     default 1,000,000
+ */
+
+double fileMegabytes(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+
+    const char* snapshotPath = "delta_benchmark.bin";
+    const char* deltaPath = "delta_benchmark_delta.bin";
+    const char* fullPath = "delta_benchmark_full.bin";
+
+    std::mt19937_64 rng{5};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+
+    RankingSystem system;
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        system.addPlayer(benchmarkName(i));
+    }
+
+    std::cout << "Players: " << playerCount << "\n\n";
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(10) << "Active"
+              << std::setw(14) << "Delta ms" << std::setw(14) << "Delta MB"
+              << std::setw(14) << "Snapshot ms" << std::setw(14) << "Snapshot MB"
+              << "Load both ms\n";
+
+    for (const double share : {0.01, 0.05, 0.20, 0.50})
+    {
+        system.saveSnapshot(snapshotPath);
+
+        while (static_cast<double>(system.getDeltaSize()) < share * static_cast<double>(playerCount))
+        {
+            system.recordMatch(pickPlayer(rng), pickPlayer(rng), static_cast<MatchResult>(pickResult(rng)));
+        }
+
+        Stopwatch deltaTimer;
+        const std::expected<size_t, RankingError> written = system.saveDelta(deltaPath);
+        const double deltaSeconds = deltaTimer.seconds();
+
+        Stopwatch fullTimer;
+        system.saveSnapshot(fullPath);
+        const double fullSeconds = fullTimer.seconds();
+
+        Stopwatch loadTimer;
+        RankingSystem loaded;
+        loaded.loadSnapshot(snapshotPath);
+        const std::expected<size_t, RankingError> applied = loaded.loadDelta(deltaPath);
+        const double loadSeconds = loadTimer.seconds();
+
+        if (!written || !applied || loaded.getChangeSequence() != system.getChangeSequence())
+        {
+            std::cerr << "Delta did not round trip\n";
+            return 1;
+        }
+
+        std::cout << std::setw(10) << (std::to_string(static_cast<int>(share * 100)) + "%")
+                  << std::setw(14) << deltaSeconds * 1e3 << std::setw(14) << fileMegabytes(deltaPath)
+                  << std::setw(14) << fullSeconds * 1e3 << std::setw(14) << fileMegabytes(fullPath)
+                  << loadSeconds * 1e3 << "\n";
+    }
+
+    std::remove(snapshotPath);
+    std::remove(deltaPath);
+    std::remove(fullPath);
+    return 0;
+}
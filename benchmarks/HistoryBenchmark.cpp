@@ -0,0 +1,112 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/MatchHistory.h"
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * HISTORY BENCHMARK
+ *
+ * What keeping every match costs, in memory and time
+ *
+ * 1. Play matches between random players with real Elo updates,
+ *    a few milliseconds apart, and append each one to a MatchHistory
+ * 2. Report the bytes per match, next to the size of a plain struct
+ * 3. Time a full sequential scan, and a scan of the newest 1%
+ *    (the chunks before it are skipped)
+ *
+ * Usage:
+ *   ./history_benchmark [players] [matches]     defaults 1,000,000 and 10,000,000
+ */
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 10'000'000);
+
+    std::mt19937_64 rng{11};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+    std::uniform_int_distribution<int> pickGap{0, 3};
+
+    /**
+     * Step 1: Generate the matches first, so only append is timed
+     */
+    std::vector<double> ratings(playerCount, 1200.0);
+    std::vector<MatchHistoryEntry> matches;
+    matches.reserve(matchCount);
+
+    std::int64_t now = 1'700'000'000'000;
+    while (matches.size() < matchCount)
+    {
+        MatchHistoryEntry match;
+        match.player1 = pickPlayer(rng);
+        match.player2 = pickPlayer(rng);
+        if (match.player1 == match.player2)
+        {
+            continue;
+        }
+
+        now += pickGap(rng);
+        match.timestamp = now;
+        match.result = static_cast<MatchResult>(pickResult(rng));
+        match.rating1 = ratings[match.player1];
+        match.rating2 = ratings[match.player2];
+
+        const double expected1 = 1.0 / (1.0 + std::pow(10.0, (match.rating2 - match.rating1) / 400.0));
+        const double score1 = (static_cast<int>(match.result) + 1) / 2.0;
+        match.change1 = 32.0 * (score1 - expected1);
+        match.change2 = -match.change1;
+
+        ratings[match.player1] += match.change1;
+        ratings[match.player2] += match.change2;
+        matches.push_back(match);
+    }
+
+    /**
+     * Step 2: Append and measure
+     */
+    MatchHistory history;
+    Stopwatch appendTimer;
+    for (const MatchHistoryEntry& match : matches)
+    {
+        history.append(match);
+    }
+    const double appendSeconds = appendTimer.seconds();
+
+    const double perMatch = static_cast<double>(history.memoryBytes()) / static_cast<double>(matchCount);
+
+    /**
+     * Step 3: Scans
+     */
+    double total = 0.0;
+    Stopwatch scanTimer;
+    history.forEach([&total](const MatchHistoryEntry& match) { total += match.change1; });
+    const double scanSeconds = scanTimer.seconds();
+    doNotOptimize(total);
+
+    const std::int64_t from = matches[matchCount - matchCount / 100].timestamp;
+    size_t recent = 0;
+    Stopwatch rangeTimer;
+    history.forEachBetween(from, now, [&recent](const MatchHistoryEntry&) { recent++; });
+    const double rangeSeconds = rangeTimer.seconds();
+
+    std::cout << "Players: " << playerCount << "\n";
+    std::cout << "Matches: " << matchCount << " in " << history.chunkCount() << " chunks\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Memory:            " << static_cast<double>(history.memoryBytes()) / (1024.0 * 1024.0)
+              << " MB, " << perMatch << " bytes per match\n";
+    std::cout << "As structs:        " << static_cast<double>(matchCount * sizeof(MatchHistoryEntry)) / (1024.0 * 1024.0)
+              << " MB, " << sizeof(MatchHistoryEntry) << " bytes per match\n\n";
+    std::cout << "Append:            " << appendSeconds * 1e9 / static_cast<double>(matchCount) << " ns per match\n";
+    std::cout << "Full scan:         " << scanSeconds * 1e3 << " ms, "
+              << scanSeconds * 1e9 / static_cast<double>(matchCount) << " ns per match\n";
+    std::cout << "Newest 1% scan:    " << rangeSeconds * 1e3 << " ms, " << recent << " matches\n";
+
+    return 0;
+}
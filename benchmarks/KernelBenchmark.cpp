@@ -0,0 +1,120 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/EloKernel.h"
+#include "../src/ExpectedScoreTable.h"
+#include "../src/Match.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * KERNEL BENCHMARK
+ *
+ * Expected scores for many rating pairs:
+ * a loop over Match::calculateExpectedScore (one std::pow per pair)
+ * against the constexpr lookup table (ExpectedScoreTable)
+ * and EloKernel at every SIMD level the CPU supports
+ *
+ * Also prints the largest difference from the scalar formula
+ *
+ * Usage:
+ *   ./kernel_benchmark [pairs]     default 10,000,000
+ */
+int main(int argc, char* argv[])
+{
+    const size_t count = sizeArgument(argc, argv, 1, 10'000'000);
+
+    std::mt19937_64 rng{3};
+    std::uniform_real_distribution<double> rating{800.0, 2800.0};
+
+    std::vector<double> a(count);
+    std::vector<double> b(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        a[i] = rating(rng);
+        b[i] = rating(rng);
+    }
+
+    std::vector<double> reference(count);
+    std::vector<double> expected(count);
+
+    std::cout << "Pairs: " << count << "\n\n";
+    std::cout << std::left << std::setw(12) << "Version"
+              << std::setw(14) << "ns/pair"
+              << std::setw(14) << "Mpairs/s" << "max error" << "\n";
+
+    {
+        Stopwatch timer;
+        for (size_t i = 0; i < count; i++)
+        {
+            reference[i] = Match::calculateExpectedScore(a[i], b[i]);
+        }
+        const double elapsed = timer.seconds();
+        doNotOptimize(reference.data());
+
+        std::cout << std::left << std::setw(12) << "std::pow"
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << elapsed * 1e9 / static_cast<double>(count)
+                  << std::setw(14) << static_cast<double>(count) / elapsed / 1e6 << "0" << "\n";
+    }
+
+    {
+        Stopwatch timer;
+        for (size_t i = 0; i < count; i++)
+        {
+            expected[i] = DefaultExpectedScoreTable(a[i], b[i]);
+        }
+        const double elapsed = timer.seconds();
+        doNotOptimize(expected.data());
+
+        double maxError = 0.0;
+        for (size_t i = 0; i < count; i++)
+        {
+            maxError = std::max(maxError, std::abs(expected[i] - reference[i]));
+        }
+
+        std::cout << std::left << std::setw(12) << "table"
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << elapsed * 1e9 / static_cast<double>(count)
+                  << std::setw(14) << static_cast<double>(count) / elapsed / 1e6
+                  << std::scientific << std::setprecision(2) << maxError << "\n";
+    }
+
+    const std::pair<EloKernel::SimdLevel, const char*> levels[] = {
+        {EloKernel::SimdLevel::Scalar, "scalar"},
+        {EloKernel::SimdLevel::SSE2, "sse2"},
+        {EloKernel::SimdLevel::AVX2, "avx2"}
+    };
+
+    for (const auto& [level, label] : levels)
+    {
+        if (level > EloKernel::detectSimdLevel())
+        {
+            continue;
+        }
+
+        Stopwatch timer;
+        EloKernel::expectedScores(a, b, expected, level);
+        const double elapsed = timer.seconds();
+        doNotOptimize(expected.data());
+
+        double maxError = 0.0;
+        for (size_t i = 0; i < count; i++)
+        {
+            maxError = std::max(maxError, std::abs(expected[i] - reference[i]));
+        }
+
+        std::cout << std::left << std::setw(12) << label
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << elapsed * 1e9 / static_cast<double>(count)
+                  << std::setw(14) << static_cast<double>(count) / elapsed / 1e6
+                  << std::scientific << std::setprecision(2) << maxError << "\n";
+    }
+
+    return 0;
+}
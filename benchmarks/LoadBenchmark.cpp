@@ -0,0 +1,141 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/MappedFile.h"
+#include "../src/PlayerCsv.h"
+#include "../src/RankingSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/**
+ * LOAD BENCHMARK
+ *
+ * Startup cost of reading players.csv
+ *
+ * Writes a file with the given number of players, then times:
+ * 1. Parsing it the old way: std::getline + std::stringstream + operator>>
+ * 2. Parsing it with MappedFile + PlayerCsv (std::from_chars)
+ * 3. RankingSystem::loadFromFile, which builds the whole system,
+ *    with 1, 2, 4, ... threads up to the given maximum
+ *
+ * Usage:
+ *   ./load_benchmark [players] [max threads]
+ *   defaults 1,000,000 players and one thread per CPU core
+ *   (a 50,000,000 player file needs several GB of memory)
+ */
+
+/**
+ * The old parsing loop, without building anything
+ */
+size_t parseWithStreams(const char* path)
+{
+    std::ifstream file(path);
+    std::string line;
+    size_t total = 0;
+
+    while (std::getline(file, line))
+    {
+        std::stringstream ss(line);
+        std::string name;
+        double rating;
+        int games, wins, losses, draws;
+
+        std::getline(ss, name, ',');
+        ss >> rating;
+        ss.ignore();
+        ss >> games;
+        ss.ignore();
+        ss >> wins;
+        ss.ignore();
+        ss >> losses;
+        ss.ignore();
+        ss >> draws;
+
+        total += name.size() + static_cast<size_t>(rating) + games + wins + losses + draws;
+    }
+
+    return total;
+}
+
+/**
+ * The new parsing loop, without building anything
+ */
+size_t parseWithFromChars(const char* path)
+{
+    MappedFile file(path);
+    size_t total = 0;
+
+    PlayerCsv::forEachRow(file.text(),
+        [&total](const PlayerCsvRow& row)
+        {
+            total += row.name.size() + static_cast<size_t>(row.rating) + row.gamesPlayed +
+                     row.wins + row.losses + row.draws;
+        });
+
+    return total;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+    const size_t maxThreads = sizeArgument(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+    const char* path = "load_benchmark_players.csv";
+
+    /**
+     * Players with a realistic mix of ratings and a few hundred games at most
+     */
+    {
+        std::mt19937_64 rng{7};
+        std::normal_distribution<double> pickRating{1500.0, 300.0};
+        std::uniform_int_distribution<int> pickCount{0, 100};
+
+        std::ofstream file(path);
+        for (size_t i = 0; i < playerCount; i++)
+        {
+            const int wins = pickCount(rng);
+            const int losses = pickCount(rng);
+            const int draws = pickCount(rng) / 4;
+            file << benchmarkName(i) << "," << pickRating(rng) << ","
+                 << wins + losses + draws << "," << wins << "," << losses << "," << draws << "\n";
+        }
+    }
+
+    std::cout << "Players: " << playerCount << "\n\n";
+    std::cout << std::left << std::fixed << std::setprecision(1);
+
+    {
+        Stopwatch timer;
+        doNotOptimize(parseWithStreams(path));
+        std::cout << std::setw(32) << "parse: getline + stringstream" << timer.seconds() * 1e3 << " ms\n";
+    }
+
+    {
+        Stopwatch timer;
+        doNotOptimize(parseWithFromChars(path));
+        std::cout << std::setw(32) << "parse: mmap + from_chars" << timer.seconds() * 1e3 << " ms\n";
+    }
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        RankingSystem system;
+        Stopwatch timer;
+        const std::expected<size_t, RankingError> loaded =
+            system.loadFromFile(path, static_cast<unsigned>(threads));
+        const double elapsed = timer.seconds();
+
+        const std::string label = "loadFromFile, " + std::to_string(threads) + " thread(s)";
+        std::cout << std::setw(32) << label << elapsed * 1e3 << " ms"
+                  << " (" << loaded.value_or(0) << " players)\n";
+    }
+
+    std::remove(path);
+    return 0;
+}
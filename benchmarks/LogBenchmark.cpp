@@ -0,0 +1,124 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * LOG BENCHMARK
+ *
+ * What the match log costs per match, for different group sizes
+ *
+ * Records the same random matches:
+ * 1. Without a match log
+ * 2. With a match log, syncing every 1, 16, 256 and 4096 records
+ *    (the interval is set high, so only the group size decides)
+ * Then times recovery: loading nothing and replaying the whole log
+ *
+ * With one record per group, every match waits for an fsync, which is
+ * what group commit avoids; that run uses at most 2,000 matches
+ *
+ * Usage:
+ *   ./log_benchmark [players] [matches]     defaults 100,000 and 1,000,000
+ */
+
+void populate(RankingSystem& system, size_t playerCount)
+{
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        system.addPlayer(benchmarkName(i));
+    }
+}
+
+void report(const std::string& label, size_t matches, double seconds)
+{
+    std::cout << std::left << std::setw(28) << label
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << seconds * 1e9 / static_cast<double>(matches)
+              << std::setprecision(2) << static_cast<double>(matches) / seconds / 1e6 << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 100'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 1'000'000);
+    const char* logPath = "log_benchmark.wal";
+
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+
+    std::vector<MatchRecord> batch;
+    batch.reserve(matchCount);
+    while (batch.size() < matchCount)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            batch.push_back({a, b, static_cast<MatchResult>(pickResult(rng))});
+        }
+    }
+
+    std::cout << "Players: " << playerCount << ", matches: " << matchCount << "\n\n";
+    std::cout << std::left << std::setw(28) << "Log"
+              << std::setw(14) << "ns/match" << "Mmatches/s" << "\n";
+
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        Stopwatch timer;
+        for (const MatchRecord& match : batch)
+        {
+            system.recordMatch(match.player1, match.player2, match.result);
+        }
+        report("none", matchCount, timer.seconds());
+    }
+
+    for (const size_t groupSize : {size_t{1}, size_t{16}, size_t{256}, size_t{4096}})
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        std::remove(logPath);
+        MatchLogOptions options;
+        options.syncEveryRecords = groupSize;
+        options.syncInterval = std::chrono::hours(1);
+        system.openMatchLog(logPath, options);
+
+        const size_t count = groupSize == 1 ? std::min<size_t>(matchCount, 2'000) : matchCount;
+
+        Stopwatch timer;
+        for (size_t i = 0; i < count; i++)
+        {
+            system.recordMatch(batch[i].player1, batch[i].player2, batch[i].result);
+        }
+        system.syncMatchLog();
+        report("sync every " + std::to_string(groupSize), count, timer.seconds());
+    }
+
+    /**
+     * The last run left the whole batch in the log
+     */
+    {
+        RankingSystem system;
+        populate(system, playerCount);
+
+        Stopwatch timer;
+        const std::expected<size_t, RankingError> replayed = system.openMatchLog(logPath);
+        const double elapsed = timer.seconds();
+
+        std::cout << "\nReplaying " << replayed.value_or(0) << " records: "
+                  << std::setprecision(1) << elapsed * 1e3 << " ms\n";
+    }
+
+    std::remove(logPath);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * LOOKUP BENCHMARK
+ *
+ * Measures RankingSystem::findPlayer as the population grows
+ * With the name index the cost per lookup should stay roughly flat
+ * (only cache effects make large tables a little slower)
+ *
+ * Usage:
+ *   ./lookup_benchmark [maxPlayers]     default 10,000,000
+ */
+int main(int argc, char* argv[])
+{
+    const size_t maxPlayers = sizeArgument(argc, argv, 1, 10'000'000);
+    const size_t lookups = 1'000'000;
+
+    std::cout << std::left << std::setw(12) << "Players"
+              << std::setw(16) << "ns/lookup" << "\n";
+
+    for (size_t n = 1'000; n <= maxPlayers; n *= 10)
+    {
+        RankingSystem system;
+        for (size_t i = 0; i < n; i++)
+        {
+            system.addPlayer(benchmarkName(i));
+        }
+
+        /**
+         * Pick the names up front so string building is not timed
+         */
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<size_t> pick{0, n - 1};
+        std::vector<std::string> queries;
+        queries.reserve(lookups);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            queries.push_back(benchmarkName(pick(rng)));
+        }
+
+        size_t found = 0;
+        Stopwatch timer;
+        for (const auto& name : queries)
+        {
+            found += system.findPlayer(name) != nullptr;
+        }
+        const double elapsed = timer.seconds();
+        doNotOptimize(found);
+
+        std::cout << std::left << std::setw(12) << n
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << elapsed * 1e9 / lookups << "\n";
+    }
+
+    return 0;
+}
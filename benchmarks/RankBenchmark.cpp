@@ -0,0 +1,142 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * RANK BENCHMARK
+ *
+ * A mixed read/write workload on a large population:
+ * - rankOf (what is my rank?)
+ * - neighborhood with radius 10 (the players around me)
+ * - recordMatch by id (ratings change, the leaderboard index follows)
+ *
+ * For comparison, it also times the old way of answering a rank
+ * question: sorting every player by rating
+ *
+ * Usage:
+ *   ./rank_benchmark [players] [operations] [write percent]
+ *   defaults 1,000,000 players, 1,000,000 operations, 20% writes
+ */
+
+/**
+ * Print one result line
+ */
+void report(const char* label, size_t operations, double seconds)
+{
+    std::cout << std::left << std::setw(24) << label
+              << std::setw(12) << operations
+              << std::fixed << std::setprecision(1)
+              << seconds * 1e9 / static_cast<double>(operations) << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+    const size_t operationCount = sizeArgument(argc, argv, 2, 1'000'000);
+    const size_t writePercent = sizeArgument(argc, argv, 3, 20);
+
+    std::mt19937_64 rng{7};
+    std::normal_distribution<double> pickRating{1500.0, 300.0};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+    std::uniform_int_distribution<size_t> pickPercent{0, 99};
+
+    RankingSystem system;
+    {
+        Stopwatch timer;
+        for (size_t i = 0; i < playerCount; i++)
+        {
+            system.addPlayer(benchmarkName(i), pickRating(rng));
+        }
+        std::cout << "Players: " << playerCount << " (added in "
+                  << std::fixed << std::setprecision(2) << timer.seconds() << " s)\n";
+    }
+
+    /**
+     * Baseline: one full sort of the rating column,
+     * which is what every rank question used to cost
+     */
+    {
+        const std::span<const RatingValue> ratings = system.getPlayerTable().getRatingColumn();
+        std::vector<PlayerId> order(playerCount);
+        std::iota(order.begin(), order.end(), PlayerId{0});
+
+        Stopwatch timer;
+        std::sort(order.begin(), order.end(),
+            [&ratings](PlayerId a, PlayerId b)
+            {
+                return ratings[a] > ratings[b];
+            });
+        const double elapsed = timer.seconds();
+        doNotOptimize(order.data());
+
+        std::cout << "One full sort: " << std::setprecision(1) << elapsed * 1e3 << " ms\n\n";
+    }
+
+    std::cout << std::left << std::setw(24) << "Operation"
+              << std::setw(12) << "count" << "ns/op" << "\n";
+
+    /**
+     * The mixed workload
+     * Each kind of operation is timed separately, interleaved in one loop
+     */
+    double rankSeconds = 0.0;
+    double neighborhoodSeconds = 0.0;
+    double writeSeconds = 0.0;
+    size_t ranks = 0;
+    size_t neighborhoods = 0;
+    size_t writes = 0;
+    size_t checksum = 0;
+
+    Stopwatch total;
+    for (size_t i = 0; i < operationCount; i++)
+    {
+        const PlayerId player = pickPlayer(rng);
+
+        if (pickPercent(rng) < writePercent)
+        {
+            PlayerId opponent = pickPlayer(rng);
+            if (opponent == player)
+            {
+                opponent = (opponent + 1) % static_cast<PlayerId>(playerCount);
+            }
+            const MatchResult result = static_cast<MatchResult>(pickResult(rng));
+
+            Stopwatch timer;
+            system.recordMatch(player, opponent, result);
+            writeSeconds += timer.seconds();
+            writes++;
+        }
+        else if (i % 2 == 0)
+        {
+            Stopwatch timer;
+            checksum += *system.rankOf(player);
+            rankSeconds += timer.seconds();
+            ranks++;
+        }
+        else
+        {
+            Stopwatch timer;
+            checksum += system.neighborhood(player, 10)->size();
+            neighborhoodSeconds += timer.seconds();
+            neighborhoods++;
+        }
+    }
+    const double totalSeconds = total.seconds();
+    doNotOptimize(checksum);
+
+    report("rankOf", ranks, rankSeconds);
+    report("neighborhood(10)", neighborhoods, neighborhoodSeconds);
+    report("recordMatch", writes, writeSeconds);
+    report("all (incl. loop)", operationCount, totalSeconds);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/CheckpointManager.h"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * RECOVERY BENCHMARK
+ *
+ * How long a restart takes with checkpoints, for different amounts
+ * of log after the last snapshot
+ *
+ * For each log length:
+ * 1. Add the players and take a checkpoint (the snapshot)
+ * 2. Record that many matches, which only go to the log
+ * 3. Recover into a new RankingSystem and time it
+ *
+ * The run with no log is the cost of loading the snapshot alone;
+ * the last column is what each log record adds on top of it
+ *
+ * Usage:
+ *   ./recovery_benchmark [players] [matches]     defaults 1,000,000 and 4,000,000
+ *   (matches is the longest log; shorter ones are 0, 1/16 and 1/4 of it)
+ */
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 4'000'000);
+    const char* directory = "recovery_benchmark";
+
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+
+    std::vector<MatchRecord> batch;
+    batch.reserve(matchCount);
+    while (batch.size() < matchCount)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            batch.push_back({a, b, static_cast<MatchResult>(pickResult(rng))});
+        }
+    }
+
+    /**
+     * Big groups: the benchmark is about reading the log, not writing it
+     */
+    CheckpointOptions options;
+    options.changesPerCheckpoint = UINT64_MAX;
+    options.interval = std::chrono::hours(24);
+    options.log.syncEveryRecords = 4096;
+    options.log.syncInterval = std::chrono::hours(1);
+
+    std::cout << "Players: " << playerCount << "\n\n";
+    std::cout << std::left << std::setw(16) << "Log matches"
+              << std::setw(16) << "Recovery ms"
+              << std::setw(16) << "Log ns/record" << "\n";
+
+    double snapshotOnly = 0.0;
+
+    for (const size_t logLength : {size_t{0}, matchCount / 16, matchCount / 4, matchCount})
+    {
+        std::filesystem::remove_all(directory);
+
+        {
+            RankingSystem system;
+            CheckpointManager checkpoints(system, directory, options);
+            checkpoints.recover();
+
+            for (size_t i = 0; i < playerCount; i++)
+            {
+                system.addPlayer(benchmarkName(i));
+            }
+            checkpoints.checkpoint();
+            checkpoints.wait();
+
+            for (size_t i = 0; i < logLength; i++)
+            {
+                system.recordMatch(batch[i].player1, batch[i].player2, batch[i].result);
+            }
+            system.closeMatchLog();
+        }
+
+        RankingSystem recovered;
+        CheckpointManager checkpoints(recovered, directory, options);
+
+        Stopwatch timer;
+        const std::expected<RecoveryResult, RankingError> result = checkpoints.recover();
+        const double elapsed = timer.seconds();
+
+        if (!result || result->playersLoaded != playerCount || result->recordsReplayed != logLength)
+        {
+            std::cerr << "Recovery failed for a log of " << logLength << " matches\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(16) << logLength
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << elapsed * 1e3;
+        if (logLength == 0)
+        {
+            snapshotOnly = elapsed;
+        }
+        else
+        {
+            std::cout << std::setw(16) << (elapsed - snapshotOnly) * 1e9 / static_cast<double>(logLength);
+        }
+        std::cout << "\n";
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+/**
+ * RENDER BENCHMARK
+ *
+ * Prints the whole leaderboard to a file in two ways:
+ * 1. The old way: stream manipulators and std::endl per row (Player::displayStats)
+ * 2. displayLeaderboard, which formats into one buffer and writes in chunks
+ *
+ * Both outputs are compared afterwards; they must be identical
+ *
+ * Usage:
+ *   ./render_benchmark [players]     default 100,000
+ */
+
+/**
+ * The leaderboard as it used to be printed, for comparison
+ */
+void oldDisplayLeaderboard(const RankingSystem& system, std::ostream& out)
+{
+    const PlayerTable& table = system.getPlayerTable();
+    const std::span<const RatingValue> ratings = table.getRatingColumn();
+
+    std::vector<PlayerId> rows(table.size());
+    std::iota(rows.begin(), rows.end(), PlayerId{0});
+    std::stable_sort(rows.begin(), rows.end(),
+        [&ratings](PlayerId a, PlayerId b)
+        {
+            return ratings[a] > ratings[b];
+        });
+
+    out << "\n";
+    out << "========== LEADERBOARD ==========\n";
+    out << std::left
+        << std::setw(20) << "Name"
+        << std::setw(10) << "Rating"
+        << std::setw(8) << "Games"
+        << std::setw(6) << "Wins"
+        << std::setw(6) << "Loses"
+        << std::setw(6) << "Draws" << std::endl;
+    out << std::string(56, '-') << std::endl;
+
+    for (const PlayerId row : rows)
+    {
+        system.getPlayer(row).displayStats(out);
+    }
+
+    out << "=================================\n\n";
+}
+
+/**
+ * Read a whole file into a string
+ */
+std::string readFile(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 100'000);
+
+    const char* oldPath = "render_benchmark_old.txt";
+    const char* newPath = "render_benchmark_new.txt";
+
+    std::mt19937_64 rng{7};
+    std::normal_distribution<double> pickRating{1500.0, 300.0};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+
+    RankingSystem system;
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        system.addPlayer(benchmarkName(i), pickRating(rng));
+    }
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            system.recordMatch(a, b, MatchResult::Player1Wins);
+        }
+    }
+
+    std::cout << "Players: " << playerCount << "\n\n";
+
+    double oldSeconds;
+    {
+        std::ofstream out(oldPath);
+        Stopwatch timer;
+        oldDisplayLeaderboard(system, out);
+        out.flush();
+        oldSeconds = timer.seconds();
+    }
+
+    double newSeconds;
+    {
+        std::ofstream out(newPath);
+        Stopwatch timer;
+        system.displayLeaderboard(out);
+        out.flush();
+        newSeconds = timer.seconds();
+    }
+
+    const bool identical = readFile(oldPath) == readFile(newPath);
+    std::remove(oldPath);
+    std::remove(newPath);
+
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(28) << "displayStats + std::endl" << oldSeconds * 1e3 << " ms\n"
+              << std::setw(28) << "buffered renderer" << newSeconds * 1e3 << " ms\n"
+              << "Output identical: " << (identical ? "yes" : "NO") << "\n";
+
+    return identical ? 0 : 1;
+}
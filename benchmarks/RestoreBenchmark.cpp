@@ -0,0 +1,119 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/MappedFile.h"
+#include "../src/PlayerCsv.h"
+#include "../src/RankingSystem.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+/**
+ * RESTORE BENCHMARK
+ *
+ * Loading players with long histories
+ *
+ * Writes two files with the same number of players:
+ * - "fresh": nobody has played yet
+ * - "veteran": around 50,000 games per player
+ *
+ * Then times:
+ * 1. Restoring the veteran counters the old way, one recordWin /
+ *    recordLoss / recordDraw call per game
+ * 2. loadFromFile on both files; with counters restored in one step
+ *    the two should take about the same time
+ *
+ * Usage:
+ *   ./restore_benchmark [players] [average games]     defaults 10,000 and 50,000
+ */
+
+/**
+ * Write a player file; every player gets about averageGames games
+ */
+void writePlayers(const char* path, size_t playerCount, int averageGames)
+{
+    std::mt19937_64 rng{7};
+    std::normal_distribution<double> pickRating{1500.0, 300.0};
+    std::uniform_int_distribution<int> pickGames{0, 2 * averageGames};
+
+    std::ofstream file(path);
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        const int games = pickGames(rng);
+        const int wins = games / 2;
+        const int losses = games / 3;
+        const int draws = games - wins - losses;
+        file << benchmarkName(i) << "," << pickRating(rng) << ","
+             << games << "," << wins << "," << losses << "," << draws << "\n";
+    }
+}
+
+/**
+ * The old way: add the row, then replay every game on it
+ */
+size_t replayCounters(const char* path)
+{
+    MappedFile file(path);
+    PlayerTable table;
+
+    PlayerCsv::forEachRow(file.text(),
+        [&table](const PlayerCsvRow& row)
+        {
+            const size_t id = table.addRow(std::string(row.name), row.rating);
+            for (int i = 0; i < row.wins; i++)
+            {
+                table.recordWin(id);
+            }
+            for (int i = 0; i < row.losses; i++)
+            {
+                table.recordLoss(id);
+            }
+            for (int i = 0; i < row.draws; i++)
+            {
+                table.recordDraw(id);
+            }
+        });
+
+    return table.size();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 10'000);
+    const int averageGames = static_cast<int>(sizeArgument(argc, argv, 2, 50'000));
+
+    const char* freshPath = "restore_benchmark_fresh.csv";
+    const char* veteranPath = "restore_benchmark_veteran.csv";
+    writePlayers(freshPath, playerCount, 0);
+    writePlayers(veteranPath, playerCount, averageGames);
+
+    std::cout << "Players: " << playerCount << ", average games: " << averageGames << "\n\n";
+    std::cout << std::left << std::fixed << std::setprecision(1);
+
+    {
+        Stopwatch timer;
+        doNotOptimize(replayCounters(veteranPath));
+        std::cout << std::setw(36) << "veteran, replay every game" << timer.seconds() * 1e3 << " ms\n";
+    }
+
+    {
+        RankingSystem system;
+        Stopwatch timer;
+        doNotOptimize(system.loadFromFile(veteranPath).value_or(0));
+        std::cout << std::setw(36) << "veteran, loadFromFile (restore)" << timer.seconds() * 1e3 << " ms\n";
+    }
+
+    {
+        RankingSystem system;
+        Stopwatch timer;
+        doNotOptimize(system.loadFromFile(freshPath).value_or(0));
+        std::cout << std::setw(36) << "fresh, loadFromFile (restore)" << timer.seconds() * 1e3 << " ms\n";
+    }
+
+    std::remove(freshPath);
+    std::remove(veteranPath);
+    return 0;
+}
@@ -0,0 +1,187 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+/**
+ * SAVE BENCHMARK
+ *
+ * Writing players.csv
+ *
+ * Builds a system with the given number of players, then times:
+ * 1. Writing the file the old way: operator<< for every field
+ * 2. RankingSystem::saveToFile (std::to_chars into a buffer, big block writes,
+ *    temporary file + fsync + rename)
+ * 3. The same with a CRC-32 checksum line
+ * 4. RankingSystem::saveToFileAsync after some matches: how long the
+ *    caller waits (copying the changed players), and the slowest
+ *    recordMatch while the file is being written in the background
+ *    (with saveToFile, a match would wait for the whole save; on a
+ *    single core the slowest one still waits for a scheduler time slice)
+ *
+ * Also reloads the new file and counts ratings that did not come back
+ * exactly; the old format keeps only 6 significant digits, so it
+ * loses almost all of them
+ *
+ * Usage:
+ *   ./save_benchmark [players]     default 1,000,000
+ */
+
+/**
+ * The old writing loop
+ */
+void saveWithStreams(const PlayerTable& table, const char* path)
+{
+    std::ofstream file(path);
+
+    for (size_t row = 0; row < table.size(); row++)
+    {
+        file << table.getName(row) << ","
+             << table.getRating(row) << ","
+             << table.getGamesPlayed(row) << ","
+             << table.getWins(row) << ","
+             << table.getLosses(row) << ","
+             << table.getDraws(row) << "\n";
+    }
+
+    file.flush();
+}
+
+/**
+ * Size of a file in bytes
+ */
+double fileMegabytes(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+}
+
+/**
+ * Count the players whose rating changed on the way through a file
+ */
+size_t countChangedRatings(const RankingSystem& system, const char* path)
+{
+    RankingSystem loaded;
+    loaded.loadFromFile(path);
+
+    size_t changed = 0;
+    for (PlayerId id = 0; id < system.getPlayerCount(); id++)
+    {
+        if (loaded.getPlayer(id).getRating() != system.getPlayer(id).getRating())
+        {
+            changed++;
+        }
+    }
+    return changed;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+
+    const char* oldPath = "save_benchmark_old.csv";
+    const char* newPath = "save_benchmark_new.csv";
+
+    std::mt19937_64 rng{11};
+    std::normal_distribution<double> pickRating{1500.0, 300.0};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+
+    RankingSystem system;
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        system.addPlayer(benchmarkName(i), pickRating(rng));
+    }
+    for (size_t i = 0; i < playerCount; i++)
+    {
+        const PlayerId a = pickPlayer(rng);
+        const PlayerId b = pickPlayer(rng);
+        if (a != b)
+        {
+            system.recordMatch(a, b, MatchResult::Player1Wins);
+        }
+    }
+
+    std::cout << "Players: " << playerCount << "\n\n";
+
+    Stopwatch oldTimer;
+    saveWithStreams(system.getPlayerTable(), oldPath);
+    const double oldSeconds = oldTimer.seconds();
+
+    Stopwatch newTimer;
+    const bool saved = system.saveToFile(newPath).has_value();
+    const double newSeconds = newTimer.seconds();
+
+    Stopwatch checksumTimer;
+    const bool checksummed = system.saveToFile(newPath, FileChecksum::Crc32Footer).has_value();
+    const double checksumSeconds = checksumTimer.seconds();
+
+    Stopwatch verifyTimer;
+    RankingSystem verified;
+    const bool verifiedOk = verified.loadFromFile(newPath).has_value();
+    const double verifySeconds = verifyTimer.seconds();
+
+
+    const double oldSize = fileMegabytes(oldPath);
+    const double newSize = fileMegabytes(newPath);
+
+    const size_t oldChanged = countChangedRatings(system, oldPath);
+    const size_t newChanged = countChangedRatings(system, newPath);
+
+    /**
+     * The first background save copies everyone; the second one only
+     * the players of the matches in between
+     */
+    const bool firstAsync = system.saveToFileAsync(newPath).get().has_value();
+    for (size_t i = 0; i < 10'000; i++)
+    {
+        system.recordMatch(pickPlayer(rng), pickPlayer(rng), MatchResult::Draw);
+    }
+
+    Stopwatch asyncTimer;
+    const auto background = system.saveToFileAsync(newPath);
+    const double asyncSeconds = asyncTimer.seconds();
+
+    size_t matchesDuringSave = 0;
+    double slowestMatch = 0.0;
+    while (background.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        Stopwatch matchTimer;
+        system.recordMatch(pickPlayer(rng), pickPlayer(rng), MatchResult::Player2Wins);
+        slowestMatch = std::max(slowestMatch, matchTimer.seconds());
+        matchesDuringSave++;
+    }
+    const bool asyncSaved = firstAsync && background.get().has_value();
+
+    std::remove(oldPath);
+    std::remove(newPath);
+
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(24) << "operator<< per field"
+              << std::setw(10) << oldSeconds * 1e3 << " ms  "
+              << std::setw(8) << oldSize / oldSeconds << " MB/s  "
+              << oldChanged << " ratings changed\n"
+              << std::setw(24) << "to_chars + block writes"
+              << std::setw(10) << newSeconds * 1e3 << " ms  "
+              << std::setw(8) << newSize / newSeconds << " MB/s  "
+              << newChanged << " ratings changed\n"
+              << std::setw(24) << "  + CRC-32 footer"
+              << std::setw(10) << checksumSeconds * 1e3 << " ms\n"
+              << std::setw(24) << "background save"
+              << std::setw(10) << asyncSeconds * 1e3 <<  " ms  copying the players of 10,000 matches\n"
+              << std::setw(24) << "  matches meanwhile"
+              << std::setw(10) << matchesDuringSave << "     slowest "
+              << slowestMatch * 1e6 << " us\n"
+              << std::setw(24) << "load + verify"
+              << std::setw(10) << verifySeconds * 1e3 << " ms\n";
+
+    return saved && checksummed && asyncSaved && verifiedOk && newChanged == 0 ? 0 : 1;
+}
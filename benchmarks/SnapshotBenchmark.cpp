@@ -0,0 +1,147 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * SNAPSHOT BENCHMARK
+ *
+ * Cold start: how long until a freshly started program has all
+ * players loaded, from the CSV file and from a binary snapshot
+ *
+ * Writes a population once, saves it in both formats, then loads each
+ * file into a new RankingSystem:
+ * 1. loadFromFile, one thread and one per core
+ * 2. loadSnapshot, without and with a checksum
+ *
+ * Before every load the file is dropped from the operating system's
+ * page cache (Linux only), so it really comes from disk as it would
+ * after a reboot; elsewhere the numbers are for a warm cache
+ *
+ * Usage:
+ *   ./snapshot_benchmark [players]     default 10,000,000
+ *   (10 million players need about 3 GB of memory)
+ */
+
+/**
+ * Ask the kernel to forget the cached pages of a file
+ * The files are fsync'ed by the save, so nothing dirty is lost
+ */
+void dropFromPageCache(const char* path)
+{
+#if defined(__linux__)
+    const int descriptor = ::open(path, O_RDONLY);
+    if (descriptor >= 0)
+    {
+        ::posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(descriptor);
+    }
+#else
+    (void)path;
+#endif
+}
+
+double fileMegabytes(const char* path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+}
+
+/**
+ * Load one file into a new system and print the time
+ */
+template <typename Load>
+void timeLoad(const char* label, const char* path, Load load)
+{
+    dropFromPageCache(path);
+
+    RankingSystem system;
+    Stopwatch timer;
+    const std::expected<size_t, RankingError> loaded = load(system);
+    const double elapsed = timer.seconds();
+
+    std::cout << std::setw(34) << label << std::setw(10) << elapsed * 1e3 << " ms"
+              << " (" << loaded.value_or(0) << " players)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 10'000'000);
+
+    const char* sourcePath = "snapshot_benchmark_source.csv";
+    const char* csvPath = "snapshot_benchmark.csv";
+    const char* snapshotPath = "snapshot_benchmark.bin";
+    const char* checkedPath = "snapshot_benchmark_crc.bin";
+
+    /**
+     * Players with a realistic mix of ratings and a few hundred games at most
+     */
+    {
+        std::mt19937_64 rng{7};
+        std::normal_distribution<double> pickRating{1500.0, 300.0};
+        std::uniform_int_distribution<int> pickCount{0, 100};
+
+        std::ofstream file(sourcePath);
+        for (size_t i = 0; i < playerCount; i++)
+        {
+            const int wins = pickCount(rng);
+            const int losses = pickCount(rng);
+            const int draws = pickCount(rng) / 4;
+            file << benchmarkName(i) << "," << pickRating(rng) << ","
+                 << wins + losses + draws << "," << wins << "," << losses << "," << draws << "\n";
+        }
+    }
+
+    std::cout << "Players: " << playerCount << "\n\n";
+    std::cout << std::left << std::fixed << std::setprecision(1);
+
+    {
+        RankingSystem system;
+        system.loadFromFile(sourcePath, 0);
+
+        Stopwatch csvTimer;
+        system.saveToFile(csvPath);
+        const double csvSeconds = csvTimer.seconds();
+
+        Stopwatch snapshotTimer;
+        system.saveSnapshot(snapshotPath);
+        const double snapshotSeconds = snapshotTimer.seconds();
+
+        Stopwatch checkedTimer;
+        system.saveSnapshot(checkedPath, FileChecksum::Crc32Footer);
+        const double checkedSeconds = checkedTimer.seconds();
+
+        std::cout << std::setw(34) << "saveToFile" << std::setw(10) << csvSeconds * 1e3 << " ms  "
+                  << fileMegabytes(csvPath) << " MB\n"
+                  << std::setw(34) << "saveSnapshot" << std::setw(10) << snapshotSeconds * 1e3 << " ms  "
+                  << fileMegabytes(snapshotPath) << " MB\n"
+                  << std::setw(34) << "saveSnapshot + CRC-32" << std::setw(10) << checkedSeconds * 1e3 << " ms\n\n";
+    }
+    std::remove(sourcePath);
+
+    timeLoad("loadFromFile, 1 thread", csvPath,
+        [csvPath](RankingSystem& system) { return system.loadFromFile(csvPath); });
+    timeLoad("loadFromFile, 1 thread per core", csvPath,
+        [csvPath](RankingSystem& system) { return system.loadFromFile(csvPath, 0); });
+    timeLoad("loadSnapshot", snapshotPath,
+        [snapshotPath](RankingSystem& system) { return system.loadSnapshot(snapshotPath); });
+    timeLoad("loadSnapshot + CRC-32", checkedPath,
+        [checkedPath](RankingSystem& system) { return system.loadSnapshot(checkedPath); });
+
+    std::remove(csvPath);
+    std::remove(snapshotPath);
+    std::remove(checkedPath);
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/MatchHistory.h"
+#include "../src/RatingTimeline.h"
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/**
+ * TIMELINE BENCHMARK
+ *
+ * "Rating over the last 90 days" for one player: from the player's
+ * RatingTimeline blocks, against filtering the MatchHistory
+ *
+ * 1. Play matches between random players with real Elo updates,
+ *    spread evenly over 180 days, and add them to both stores
+ * 2. Report the timeline's bytes per point, next to one vector of
+ *    RatingPoint per player
+ * 3. Query the last 90 days for a sample of players both ways:
+ *    time, bytes read and points found
+ *
+ * Usage:
+ *   ./timeline_benchmark [players] [matches]     defaults 1,000,000 and 10,000,000
+ */
+
+int main(int argc, char* argv[])
+{
+    const size_t playerCount = sizeArgument(argc, argv, 1, 1'000'000);
+    const size_t matchCount = sizeArgument(argc, argv, 2, 10'000'000);
+    const size_t sampleCount = 10'000;
+    const size_t historySamples = 5;
+
+    const std::int64_t day = 86'400'000;
+    const std::int64_t start = 1'700'000'000'000;
+    const std::int64_t end = start + 180 * day;
+    const std::int64_t step = (end - start) / static_cast<std::int64_t>(matchCount);
+
+    std::mt19937_64 rng{13};
+    std::uniform_int_distribution<PlayerId> pickPlayer{0, static_cast<PlayerId>(playerCount - 1)};
+    std::uniform_int_distribution<int> pickResult{-1, 1};
+
+    /**
+     * Step 1: Play the matches
+     */
+    std::vector<double> ratings(playerCount, 1200.0);
+    MatchHistory history;
+    RatingTimeline timeline;
+
+    double appendSeconds = 0.0;
+    for (size_t i = 0; i < matchCount; i++)
+    {
+        MatchHistoryEntry match;
+        match.player1 = pickPlayer(rng);
+        match.player2 = pickPlayer(rng);
+        if (match.player1 == match.player2)
+        {
+            continue;
+        }
+
+        match.timestamp = start + static_cast<std::int64_t>(i) * step;
+        match.result = static_cast<MatchResult>(pickResult(rng));
+        match.rating1 = ratings[match.player1];
+        match.rating2 = ratings[match.player2];
+
+        const double expected1 = 1.0 / (1.0 + std::pow(10.0, (match.rating2 - match.rating1) / 400.0));
+        const double score1 = (static_cast<int>(match.result) + 1) / 2.0;
+        match.change1 = 32.0 * (score1 - expected1);
+        match.change2 = -match.change1;
+
+        ratings[match.player1] += match.change1;
+        ratings[match.player2] += match.change2;
+        history.append(match);
+
+        Stopwatch appendTimer;
+        timeline.append(match.player1, match.timestamp, ratings[match.player1]);
+        timeline.append(match.player2, match.timestamp, ratings[match.player2]);
+        appendSeconds += appendTimer.seconds();
+    }
+
+    const double perPoint = static_cast<double>(timeline.memoryBytes()) / static_cast<double>(timeline.size());
+    const double structBytes = static_cast<double>(playerCount * sizeof(std::vector<RatingPoint>) +
+                                                   timeline.size() * sizeof(RatingPoint));
+
+    std::cout << "Players: " << playerCount << "\n";
+    std::cout << "Matches: " << history.size() << " over 180 days, "
+              << timeline.size() << " timeline points\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Timeline memory:   " << static_cast<double>(timeline.memoryBytes()) / (1024.0 * 1024.0)
+              << " MB, " << perPoint << " bytes per point\n";
+    std::cout << "As vectors:        " << structBytes / (1024.0 * 1024.0) << " MB at least, "
+              << structBytes / static_cast<double>(timeline.size()) << " bytes per point\n";
+    std::cout << "Append:            " << appendSeconds * 1e9 / static_cast<double>(timeline.size())
+              << " ns per point (timer included)\n\n";
+
+    /**
+     * Step 2: The last 90 days from the timeline
+     */
+    const std::int64_t from = end - 90 * day;
+    std::vector<PlayerId> sample;
+    for (size_t i = 0; i < sampleCount; i++)
+    {
+        sample.push_back(pickPlayer(rng));
+    }
+
+    size_t timelinePoints = 0;
+    size_t timelineBytes = 0;
+    Stopwatch timelineTimer;
+    for (const PlayerId player : sample)
+    {
+        timelinePoints += timeline.pointsBetween(player, from, end).size();
+    }
+    const double timelineSeconds = timelineTimer.seconds();
+    for (const PlayerId player : sample)
+    {
+        timelineBytes += timeline.bytesBetween(player, from, end);
+    }
+
+    /**
+     * Step 3: The same from the match history, for a few players
+     * (each query decodes every match in the range)
+     */
+    size_t historyPoints = 0;
+    Stopwatch historyTimer;
+    for (size_t i = 0; i < historySamples; i++)
+    {
+        const PlayerId player = sample[i];
+        history.forEachBetween(from, end, [&historyPoints, player](const MatchHistoryEntry& match)
+        {
+            historyPoints += match.player1 == player || match.player2 == player ? 1 : 0;
+        });
+    }
+    const double historySeconds = historyTimer.seconds();
+    doNotOptimize(historyPoints);
+
+    std::cout << "Last 90 days for one player:\n";
+    std::cout << std::setprecision(2);
+    std::cout << "  Timeline:        " << timelineSeconds * 1e6 / sampleCount << " us, "
+              << static_cast<double>(timelineBytes) / sampleCount << " bytes read, "
+              << static_cast<double>(timelinePoints) / sampleCount << " points\n";
+    std::cout << "  Match history:   " << historySeconds * 1e6 / historySamples << " us, "
+              << "about " << static_cast<double>(history.memoryBytes()) / 2 / (1024.0 * 1024.0)
+              << " MB read (half the history)\n";
+
+    return 0;
+}
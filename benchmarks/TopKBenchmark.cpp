@@ -0,0 +1,114 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "BenchmarkUtil.h"
+#include "../src/RankingSystem.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * TOP-K BENCHMARK
+ *
+ * Four ways to get the best k players, for growing populations:
+ * 1. Full sort of every row by rating (what displayLeaderboard used to do)
+ * 2. std::partial_sort: only the first k rows end up sorted
+ * 3. std::nth_element to find the top k, then sort just those
+ * 4. RankingSystem::topK, reading the maintained leaderboard index
+ *
+ * Usage:
+ *   ./topk_benchmark [k] [largest n]     defaults 100 and 1,000,000
+ *   n runs through 10^4, 10^5, ... up to the largest n
+ *   (10^7 works too, but needs a few GB of memory and some patience)
+ */
+
+/**
+ * Time a function a few times and report the fastest run in microseconds
+ * (the first run pays for page faults and cold caches)
+ */
+template <typename Function>
+double fastestMicroseconds(Function function)
+{
+    double best = 1e30;
+    for (int run = 0; run < 3; run++)
+    {
+        Stopwatch timer;
+        function();
+        best = std::min(best, timer.seconds());
+    }
+    return best * 1e6;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t k = sizeArgument(argc, argv, 1, 100);
+    const size_t largest = sizeArgument(argc, argv, 2, 1'000'000);
+
+    std::cout << "k = " << k << ", times in microseconds\n\n";
+    std::cout << std::left << std::setw(12) << "n"
+              << std::setw(14) << "full sort"
+              << std::setw(14) << "partial_sort"
+              << std::setw(14) << "nth_element"
+              << std::setw(14) << "topK" << "\n";
+
+    for (size_t n = 10'000; n <= largest; n *= 10)
+    {
+        std::mt19937_64 rng{7};
+        std::normal_distribution<double> pickRating{1500.0, 300.0};
+
+        RankingSystem system;
+        for (size_t i = 0; i < n; i++)
+        {
+            system.addPlayer(benchmarkName(i), pickRating(rng));
+        }
+
+        const std::span<const RatingValue> ratings = system.getPlayerTable().getRatingColumn();
+        const auto higher = [&ratings](PlayerId a, PlayerId b)
+        {
+            return ratings[a] > ratings[b];
+        };
+
+        std::vector<PlayerId> rows(n);
+        const size_t count = std::min(k, n);
+
+        const double fullSort = fastestMicroseconds([&]
+        {
+            std::iota(rows.begin(), rows.end(), PlayerId{0});
+            std::sort(rows.begin(), rows.end(), higher);
+            doNotOptimize(rows.data());
+        });
+
+        const double partialSort = fastestMicroseconds([&]
+        {
+            std::iota(rows.begin(), rows.end(), PlayerId{0});
+            std::partial_sort(rows.begin(), rows.begin() + count, rows.end(), higher);
+            doNotOptimize(rows.data());
+        });
+
+        const double nthElement = fastestMicroseconds([&]
+        {
+            std::iota(rows.begin(), rows.end(), PlayerId{0});
+            std::nth_element(rows.begin(), rows.begin() + (count - 1), rows.end(), higher);
+            std::sort(rows.begin(), rows.begin() + count, higher);
+            doNotOptimize(rows.data());
+        });
+
+        const double index = fastestMicroseconds([&]
+        {
+            const std::vector<LeaderboardRow> top = system.topK(k);
+            doNotOptimize(top.data());
+        });
+
+        std::cout << std::left << std::setw(12) << n
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << fullSort
+                  << std::setw(14) << partialSort
+                  << std::setw(14) << nthElement
+                  << std::setw(14) << index << "\n";
+    }
+
+    return 0;
+}
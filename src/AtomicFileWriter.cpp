@@ -0,0 +1,154 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "AtomicFileWriter.h"
+#include <filesystem>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ELO_HAVE_FSYNC 1
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The temporary file is created empty, replacing any leftover
+ * from an earlier save that crashed
+ */
+AtomicFileWriter::AtomicFileWriter(const std::string& path)
+    : path(path),
+      tempPath(path + ".tmp")
+{
+#ifdef ELO_HAVE_FSYNC
+    descriptor = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    open = descriptor >= 0;
+#else
+    stream.open(tempPath, std::ios::binary | std::ios::trunc);
+    open = static_cast<bool>(stream);
+#endif
+}
+
+AtomicFileWriter::~AtomicFileWriter()
+{
+    if (!open || committed)
+    {
+        return;
+    }
+
+#ifdef ELO_HAVE_FSYNC
+    if (descriptor >= 0)
+    {
+        ::close(descriptor);
+    }
+    ::unlink(tempPath.c_str());
+#else
+    stream.close();
+    std::error_code ignored;
+    std::filesystem::remove(tempPath, ignored);
+#endif
+}
+
+bool AtomicFileWriter::isOpen() const
+{
+    return open;
+}
+
+/**
+ * write() may take less than the whole block (or be interrupted
+ * by a signal), so keep going until everything is written
+ */
+bool AtomicFileWriter::write(std::string_view data)
+{
+    if (!open || failed)
+    {
+        return false;
+    }
+
+#ifdef ELO_HAVE_FSYNC
+    while (!data.empty())
+    {
+        const ssize_t written = ::write(descriptor, data.data(), data.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            failed = true;
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+#else
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!stream)
+    {
+        failed = true;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * Steps:
+ * 1. fsync: the file's data is on the disk, not just in the page cache
+ * 2. rename over the real file
+ * 3. fsync the directory: the new directory entry is on the disk too
+ *
+ * Until step 2 the real file still has its old contents
+ */
+bool AtomicFileWriter::commit()
+{
+    if (!open || failed || committed)
+    {
+        return false;
+    }
+
+#ifdef ELO_HAVE_FSYNC
+    const bool synced = ::fsync(descriptor) == 0;
+    const bool closed = ::close(descriptor) == 0;
+    descriptor = -1;
+
+    if (!synced || !closed || std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        failed = true;
+        return false;
+    }
+    committed = true;
+
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (directory.empty())
+    {
+        directory = ".";
+    }
+    const int directoryDescriptor = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (directoryDescriptor >= 0)
+    {
+        ::fsync(directoryDescriptor);
+        ::close(directoryDescriptor);
+    }
+#else
+    stream.flush();
+    stream.close();
+    if (!stream)
+    {
+        failed = true;
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        failed = true;
+        return false;
+    }
+    committed = true;
+#endif
+
+    return true;
+}
@@ -0,0 +1,106 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef ATOMICFILEWRITER_H
+#define ATOMICFILEWRITER_H
+
+#include <string>
+#include <string_view>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#include <fstream>
+#endif
+
+/**
+ * AtomicFileWriter Class
+ *
+ * Replaces a file so that, even after a crash or power cut,
+ * the file holds either all of the old contents or all of the new ones
+ *
+ * Writing straight into the real file is not safe: if the program
+ * dies half way, the old data is already gone and the new data is
+ * incomplete. Instead:
+ * 1. Everything is written to a temporary file next to it (path + ".tmp")
+ * 2. commit() forces the temporary file onto the disk (fsync)
+ * 3. Then renames it over the real file; a rename within one directory
+ *    is atomic, so readers see the old file or the new one, never a mix
+ * 4. Finally the directory itself is synced, so the rename survives a crash
+ *
+ * If commit() is never called (an error, an early return), the
+ * destructor deletes the temporary file and the real file is untouched
+ *
+ * On Linux and macOS this uses open/write/fsync/rename directly
+ * Elsewhere (for example Windows with MinGW) it falls back to
+ * std::ofstream and std::filesystem::rename, which still keeps the
+ * old file intact until the new one is complete, but cannot force
+ * the data onto the disk
+ *
+ * Usage:
+ *   AtomicFileWriter file("players.csv");
+ *   if (file.isOpen() && file.write(text) && file.commit()) { saved }
+ */
+class AtomicFileWriter
+{
+
+private:
+
+    std::string path;
+    std::string tempPath;
+
+#if defined(__unix__) || defined(__APPLE__)
+    int descriptor = -1;
+#else
+    std::ofstream stream;
+#endif
+
+    bool open = false;
+    bool failed = false;
+    bool committed = false;
+
+public:
+
+    /**
+     * Create the temporary file for path; check isOpen() afterwards
+     */
+    explicit AtomicFileWriter(const std::string& path);
+
+    /**
+     * Deletes the temporary file unless commit() succeeded
+     */
+    ~AtomicFileWriter();
+
+    /**
+     * The temporary file belongs to exactly one object, so no copies
+     */
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    /**
+     * False if the temporary file could not be created
+     * (missing directory, no permission, ...)
+     */
+    bool isOpen() const;
+
+    /**
+     * Append data to the temporary file
+     *
+     * Returns: false if writing failed (disk full, ...);
+     *          after a failure, commit() fails as well
+     *
+     * Each call is one system call for the whole block,
+     * so pass large blocks rather than single lines
+     */
+    bool write(std::string_view data);
+
+    /**
+     * Sync the temporary file and rename it over the real file
+     *
+     * Returns: true if the real file now holds everything written
+     *
+     * Call it once, after the last write
+     */
+    bool commit();
+
+};
+
+#endif
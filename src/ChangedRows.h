@@ -0,0 +1,108 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef CHANGEDROWS_H
+#define CHANGEDROWS_H
+
+#include "PlayerTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * ChangedRows Class
+ *
+ * Remembers which players changed since some earlier moment
+ * (the last background save, the last snapshot or delta, ...)
+ *
+ * At that moment start(rowCount) is called; from then on:
+ * - mark(id) notes a change to one of those rowCount players
+ * - players added later (id >= trackedRows()) count as new
+ *   and are not marked; the caller takes them whole
+ *
+ * Each player is listed once however often they change, so the work
+ * done with the list grows with the number of players that changed,
+ * not with the number of matches or the number of players
+ *
+ * Usage:
+ *   ChangedRows changed;
+ *   changed.start(table.size());
+ *   changed.mark(id1); changed.mark(id2);      // after every match
+ *   for (PlayerId id : changed.rows()) { ... } // then start again
+ */
+class ChangedRows
+{
+
+private:
+
+    /**
+     * One flag per tracked row, so a row is never listed twice
+     */
+    std::vector<std::uint8_t> flags;
+    std::vector<PlayerId> changed;
+    bool tracking = false;
+
+public:
+
+    /**
+     * Forget every change and track the first rowCount rows from now on
+     */
+    void start(size_t rowCount)
+    {
+        for (const PlayerId id : changed)
+        {
+            flags[id] = 0;
+        }
+        changed.clear();
+        flags.resize(rowCount, 0);
+        tracking = true;
+    }
+
+    /**
+     * Stop tracking and free the memory
+     */
+    void stop()
+    {
+        flags = {};
+        changed = {};
+        tracking = false;
+    }
+
+    bool isTracking() const
+    {
+        return tracking;
+    }
+
+    /**
+     * Note a change to a player; does nothing for new players
+     * or while not tracking
+     */
+    void mark(PlayerId id)
+    {
+        if (id < flags.size() && flags[id] == 0)
+        {
+            flags[id] = 1;
+            changed.push_back(id);
+        }
+    }
+
+    /**
+     * The changed players, in the order they first changed
+     */
+    std::span<const PlayerId> rows() const
+    {
+        return changed;
+    }
+
+    /**
+     * Rows that existed at start(); the ones after it are new
+     */
+    size_t trackedRows() const
+    {
+        return flags.size();
+    }
+
+};
+
+#endif
@@ -0,0 +1,410 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "CheckpointManager.h"
+#include "PlayerSnapshot.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <system_error>
+
+namespace
+{
+    const std::string SnapshotPrefix = "snapshot-";
+    const std::string SnapshotSuffix = ".bin";
+    const std::string DeltaPrefix = "delta-";
+    const std::string LogPrefix = "matches-";
+    const std::string LogSuffix = ".wal";
+
+    /**
+     * prefix + 20-digit sequence + suffix
+     * 20 digits hold any 64-bit number, so names sort like the numbers
+     */
+    std::string fileName(const std::string& prefix, std::uint64_t sequence, const std::string& suffix)
+    {
+        char digits[21];
+        std::snprintf(digits, sizeof(digits), "%020llu", static_cast<unsigned long long>(sequence));
+        return prefix + digits + suffix;
+    }
+}
+
+/**
+ * The directory is created here so that every later step can assume it exists
+ */
+CheckpointManager::CheckpointManager(RankingSystem& system, const std::string& directory,
+                                     CheckpointOptions options)
+    : system(system),
+      directory(directory),
+      options(options),
+      startedTime(std::chrono::steady_clock::now())
+{
+    std::error_code ignored;
+    std::filesystem::create_directories(this->directory, ignored);
+}
+
+CheckpointManager::~CheckpointManager()
+{
+    (void)finish();
+}
+
+std::filesystem::path CheckpointManager::snapshotPath(std::uint64_t sequence) const
+{
+    return directory / fileName(SnapshotPrefix, sequence, SnapshotSuffix);
+}
+
+std::filesystem::path CheckpointManager::deltaPath(std::uint64_t sequence) const
+{
+    return directory / fileName(DeltaPrefix, sequence, SnapshotSuffix);
+}
+
+std::filesystem::path CheckpointManager::logPath(std::uint64_t sequence) const
+{
+    return directory / fileName(LogPrefix, sequence, LogSuffix);
+}
+
+/**
+ * Anything that does not parse (a leftover ".tmp", other files)
+ * is ignored
+ */
+std::vector<std::uint64_t> CheckpointManager::listFiles(const std::string& prefix, const std::string& suffix) const
+{
+    std::vector<std::uint64_t> sequences;
+
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(directory, error))
+    {
+        const std::string name = file.path().filename().string();
+        if (name.size() <= prefix.size() + suffix.size() || !name.starts_with(prefix) || !name.ends_with(suffix))
+        {
+            continue;
+        }
+
+        const char* first = name.data() + prefix.size();
+        const char* last = name.data() + name.size() - suffix.size();
+        std::uint64_t sequence = 0;
+        const std::from_chars_result parsed = std::from_chars(first, last, sequence);
+        if (parsed.ec == std::errc{} && parsed.ptr == last)
+        {
+            sequences.push_back(sequence);
+        }
+    }
+
+    std::sort(sequences.begin(), sequences.end());
+    return sequences;
+}
+
+/**
+ * Steps:
+ * 1. Try the snapshots from newest to oldest (then, if there are none,
+ *    the system as it is): load it, the deltas after it, and replay
+ *    every log in order
+ * 2. The first one that works is kept
+ * 3. Open the log for new changes
+ */
+std::expected<RecoveryResult, RankingError> CheckpointManager::recover()
+{
+    (void)finish();
+
+    const std::vector<std::uint64_t> snapshots = listFiles(SnapshotPrefix, SnapshotSuffix);
+    const std::vector<std::uint64_t> deltas = listFiles(DeltaPrefix, SnapshotSuffix);
+    const std::vector<std::uint64_t> logs = listFiles(LogPrefix, LogSuffix);
+
+    /**
+     * Step 1: Snapshot candidates, newest first
+     *
+     * A log that ends before the snapshot is skipped by the replay
+     * (all of its records are already in it); one that starts after
+     * the snapshot's next change means changes are missing, and the
+     * next older snapshot is tried
+     *
+     * Deltas are loaded while each continues the last; the first one
+     * that does not (damaged, or from a chain that broke) ends them,
+     * and the logs take over from there
+     */
+    const auto applyDeltas = [this, &deltas](std::uint64_t after)
+    {
+        size_t applied = 0;
+        for (const std::uint64_t sequence : deltas)
+        {
+            if (sequence <= after)
+            {
+                continue;
+            }
+            if (!system.loadDelta(deltaPath(sequence).string()))
+            {
+                break;
+            }
+            applied++;
+        }
+        return applied;
+    };
+
+    const auto replayLogs = [this, &logs]() -> std::expected<size_t, RankingError>
+    {
+        size_t replayed = 0;
+        for (const std::uint64_t first : logs)
+        {
+            const std::expected<size_t, RankingError> records = system.replayMatchLog(logPath(first).string());
+            if (!records)
+            {
+                return records;
+            }
+            replayed += *records;
+        }
+        return replayed;
+    };
+
+    RecoveryResult result;
+    std::expected<size_t, RankingError> replayed = std::unexpected(RankingError::FileOpenFailed);
+
+    for (auto snapshot = snapshots.rbegin(); snapshot != snapshots.rend(); ++snapshot)
+    {
+        const std::expected<size_t, RankingError> players = system.loadSnapshot(snapshotPath(*snapshot).string());
+        if (!players)
+        {
+            replayed = std::unexpected(players.error());
+            continue;
+        }
+
+        const size_t applied = applyDeltas(*snapshot);
+        replayed = replayLogs();
+        if (replayed)
+        {
+            result.snapshotSequence = *snapshot;
+            result.playersLoaded = *players;
+            result.deltasApplied = applied;
+            break;
+        }
+    }
+
+    if (snapshots.empty())
+    {
+        replayed = replayLogs();
+    }
+
+    /**
+     * Step 2: Give up if nothing fit
+     */
+    if (!replayed)
+    {
+        return std::unexpected(replayed.error());
+    }
+    result.recordsReplayed = *replayed;
+
+    /**
+     * Step 3: Log from the next change on
+     *
+     * If the newest log ends exactly here and its name says so, it is
+     * empty and is simply reused; otherwise a new log file is started,
+     * and the older ones stay until a checkpoint covers them
+     */
+    const std::uint64_t sequence = system.getChangeSequence();
+    const std::expected<size_t, RankingError> opened =
+        system.openMatchLog(logPath(sequence + 1).string(), options.log);
+    if (!opened)
+    {
+        return std::unexpected(opened.error());
+    }
+
+    /**
+     * The next delta only makes sense on top of everything on disk:
+     * the newest snapshot and every delta after it
+     */
+    const size_t newerDeltas = snapshots.empty() ? 0 : static_cast<size_t>(
+        std::count_if(deltas.begin(), deltas.end(),
+                      [&result](std::uint64_t delta) { return delta > result.snapshotSequence; }));
+    needSnapshot = snapshots.empty() || result.snapshotSequence != snapshots.back() ||
+                   result.deltasApplied != newerDeltas;
+    deltasSinceSnapshot = result.deltasApplied;
+
+    startedSequence = system.getChangeSequence() - result.recordsReplayed;
+    startedTime = std::chrono::steady_clock::now();
+
+    return result;
+}
+
+/**
+ * Two triggers: enough changes, or enough time with at least one change
+ * The clock is read only when the change count alone does not decide
+ */
+std::expected<bool, RankingError> CheckpointManager::checkpointIfDue()
+{
+    if (running.valid())
+    {
+        if (running.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return false;
+        }
+
+        const std::expected<void, RankingError> finished = finish();
+        if (!finished)
+        {
+            return std::unexpected(finished.error());
+        }
+    }
+
+    const std::uint64_t changes = system.getChangeSequence() - startedSequence;
+    const bool due = changes >= options.changesPerCheckpoint ||
+                     (changes > 0 && std::chrono::steady_clock::now() - startedTime >= options.interval);
+    if (!due)
+    {
+        return false;
+    }
+
+    const std::expected<void, RankingError> started = checkpoint();
+    if (!started)
+    {
+        return std::unexpected(started.error());
+    }
+
+    return true;
+}
+
+std::expected<void, RankingError> CheckpointManager::checkpoint()
+{
+    /**
+     * Step 1: One checkpoint at a time
+     */
+    const std::expected<void, RankingError> previous = finish();
+    if (!previous)
+    {
+        return previous;
+    }
+
+    const std::uint64_t sequence = system.getChangeSequence();
+    if (sequence == startedSequence && !listFiles(SnapshotPrefix, SnapshotSuffix).empty())
+    {
+        return {};
+    }
+
+    /**
+     * Step 2: Copy the players
+     *
+     * This is the only part that holds up the caller besides opening a file
+     *
+     * A delta if the last snapshot can take one more and it holds at
+     * most half the players; otherwise a full snapshot, which also
+     * makes every delta before it unnecessary (the compaction)
+     */
+    const bool deltaDue = !needSnapshot && deltasSinceSnapshot < options.deltasPerSnapshot &&
+                          system.getDeltaSize() * 2 <= system.getPlayerCount();
+
+    std::expected<SnapshotCapture, RankingError> capture = std::unexpected(RankingError::NoSnapshot);
+    if (deltaDue)
+    {
+        capture = system.captureDelta();
+    }
+    if (!capture)
+    {
+        capture = system.captureSnapshot();
+    }
+    const bool delta = capture->delta;
+
+    /**
+     * Step 3: Switch to a new log
+     *
+     * Changes after the copy go to the new file, so once the snapshot is
+     * written, every older log file holds only changes it contains
+     * The old log is synced and closed by openMatchLog
+     */
+    const std::expected<size_t, RankingError> opened =
+        system.openMatchLog(logPath(sequence + 1).string(), options.log);
+    if (!opened)
+    {
+        return std::unexpected(opened.error());
+    }
+
+    /**
+     * Step 4: Write the delta or snapshot in the background
+     *
+     * The task owns the copy, so nothing it touches is shared
+     */
+    const std::string path = (delta ? deltaPath(sequence) : snapshotPath(sequence)).string();
+    const FileChecksum checksum = options.checksum;
+
+    running = std::async(std::launch::async,
+        [capture = std::move(*capture), path, checksum]()
+        {
+            return PlayerSnapshot::save(path, capture, checksum);
+        });
+    runningSequence = sequence;
+    startedSequence = sequence;
+    startedTime = std::chrono::steady_clock::now();
+    deltasSinceSnapshot = delta ? deltasSinceSnapshot + 1 : 0;
+    needSnapshot = false;
+
+    return {};
+}
+
+std::expected<void, RankingError> CheckpointManager::wait()
+{
+    return finish();
+}
+
+bool CheckpointManager::isRunning() const
+{
+    return running.valid() && running.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+/**
+ * Old files are only deleted once the new snapshot is complete;
+ * if it failed, everything stays as it was, and the next checkpoint
+ * is a full snapshot (later deltas would build on the missing file)
+ */
+std::expected<void, RankingError> CheckpointManager::finish()
+{
+    if (!running.valid())
+    {
+        return {};
+    }
+
+    const std::expected<void, RankingError> saved = running.get();
+    if (saved)
+    {
+        removeOldFiles();
+    }
+    else
+    {
+        needSnapshot = true;
+    }
+
+    return saved;
+}
+
+/**
+ * Log file i holds changes logs[i] .. logs[i + 1] - 1
+ * (the newest one is still being written and always stays)
+ * Logs are kept back to the oldest snapshot, not the newest delta:
+ * they are what recovery falls back on when a delta is damaged
+ */
+void CheckpointManager::removeOldFiles()
+{
+    const std::vector<std::uint64_t> snapshots = listFiles(SnapshotPrefix, SnapshotSuffix);
+    const size_t keep = std::max<size_t>(options.keepSnapshots, 1);
+    if (snapshots.empty())
+    {
+        return;
+    }
+
+    std::error_code ignored;
+    const size_t firstKept = snapshots.size() > keep ? snapshots.size() - keep : 0;
+    for (size_t i = 0; i < firstKept; i++)
+    {
+        std::filesystem::remove(snapshotPath(snapshots[i]), ignored);
+    }
+
+    const std::uint64_t oldestKept = snapshots[firstKept];
+    for (const std::uint64_t delta : listFiles(DeltaPrefix, SnapshotSuffix))
+    {
+        if (delta <= oldestKept)
+        {
+            std::filesystem::remove(deltaPath(delta), ignored);
+        }
+    }
+
+    const std::vector<std::uint64_t> logs = listFiles(LogPrefix, LogSuffix);
+    for (size_t i = 0; i + 1 < logs.size() && logs[i + 1] - 1 <= oldestKept; i++)
+    {
+        std::filesystem::remove(logPath(logs[i]), ignored);
+    }
+}
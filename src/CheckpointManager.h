@@ -0,0 +1,239 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef CHECKPOINTMANAGER_H
+#define CHECKPOINTMANAGER_H
+
+#include "MatchLog.h"
+#include "PlayerCsv.h"
+#include "RankingError.h"
+#include "RankingSystem.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
+/**
+ * CheckpointOptions
+ *
+ * When CheckpointManager takes a snapshot, and what it keeps
+ *
+ *   changesPerCheckpoint - after this many changes (players and matches)
+ *   interval - or after this much time, if anything changed at all
+ *   deltasPerSnapshot - checkpoints that write only the changed players
+ *                       (a delta, see RankingSystem::saveDelta) between
+ *                       two full snapshots; 0 writes a full snapshot
+ *                       every time
+ *   keepSnapshots - snapshots kept on disk (at least 1); keeping 2 means
+ *                   a damaged newest snapshot can still be recovered from
+ *                   the one before it and a longer piece of log
+ *   checksum - written into every snapshot and delta
+ *   log - group commit settings for the match log
+ */
+struct CheckpointOptions
+{
+    std::uint64_t changesPerCheckpoint = 1'000'000;
+    std::chrono::seconds interval{300};
+    size_t deltasPerSnapshot = 7;
+    size_t keepSnapshots = 2;
+    FileChecksum checksum = FileChecksum::Crc32Footer;
+    MatchLogOptions log;
+};
+
+/**
+ * RecoveryResult
+ *
+ * What CheckpointManager::recover did
+ *
+ *   snapshotSequence - change sequence of the snapshot loaded (0 if none)
+ *   playersLoaded - players in that snapshot
+ *   deltasApplied - deltas loaded on top of it
+ *   recordsReplayed - match log records applied after those
+ */
+struct RecoveryResult
+{
+    std::uint64_t snapshotSequence = 0;
+    size_t playersLoaded = 0;
+    size_t deltasApplied = 0;
+    size_t recordsReplayed = 0;
+};
+
+/**
+ * CheckpointManager Class
+ *
+ * Keeps a RankingSystem's data safe on disk with snapshots and a match
+ * log, and brings it back quickly at startup
+ *
+ * Why not just save more often?
+ * A full save rewrites every player, so saving often costs a lot of I/O
+ * and saving rarely loses a lot after a crash. Instead:
+ * - Every change goes to the match log as it happens (see MatchLog)
+ * - Now and then the players are saved (a checkpoint); they are copied
+ *   on the caller's thread and written on a background thread
+ * - Most checkpoints write a delta: only the players changed since the
+ *   previous checkpoint. After deltasPerSnapshot deltas (or when most
+ *   players changed) a full snapshot is written instead, which folds
+ *   the deltas before it back into one file
+ * - The log is split into files at every checkpoint, so the pieces a
+ *   snapshot makes unnecessary can simply be deleted
+ * - Recovery loads the newest snapshot and the deltas after it, and
+ *   replays only the log after those
+ *
+ * Files in the directory, numbered by change sequence
+ * (see RankingSystem::getChangeSequence), zero-padded so they sort:
+ *   snapshot-<sequence>.bin - a snapshot containing changes 1 .. sequence
+ *   delta-<sequence>.bin - the players changed from the previous
+ *                          checkpoint up to sequence
+ *   matches-<sequence>.wal - a log whose first record is change sequence
+ *
+ * Usage:
+ *   RankingSystem system;
+ *   CheckpointManager checkpoints(system, "data");
+ *   checkpoints.recover();
+ *   while (...) { system.recordMatch(...); checkpoints.checkpointIfDue(); }
+ *
+ * The manager and the system are used from one thread; only the
+ * snapshot writing runs on a background thread, on its own copy
+ */
+class CheckpointManager
+{
+
+private:
+
+    RankingSystem& system;
+    std::filesystem::path directory;
+    CheckpointOptions options;
+
+    /**
+     * The snapshot being written in the background, if any,
+     * and the change sequence it contains
+     */
+    std::future<std::expected<void, RankingError>> running;
+    std::uint64_t runningSequence = 0;
+
+    /**
+     * The last checkpoint started, to decide when the next one is due
+     */
+    std::uint64_t startedSequence = 0;
+    std::chrono::steady_clock::time_point startedTime;
+
+    /**
+     * Deltas written since the last full snapshot; needSnapshot is set
+     * when the next delta could not be recovered (no snapshot yet, or
+     * a snapshot or delta failed), so the next checkpoint is full
+     */
+    size_t deltasSinceSnapshot = 0;
+    bool needSnapshot = true;
+
+    std::filesystem::path snapshotPath(std::uint64_t sequence) const;
+    std::filesystem::path deltaPath(std::uint64_t sequence) const;
+    std::filesystem::path logPath(std::uint64_t sequence) const;
+
+    /**
+     * Sequences of the files named prefix<sequence>suffix, in order
+     */
+    std::vector<std::uint64_t> listFiles(const std::string& prefix, const std::string& suffix) const;
+
+    /**
+     * Wait for the running snapshot, and delete the files it replaced
+     */
+    std::expected<void, RankingError> finish();
+
+    /**
+     * Delete the snapshots beyond keepSnapshots, and the deltas
+     * and logs that only hold changes the oldest kept snapshot contains
+     */
+    void removeOldFiles();
+
+public:
+
+    /**
+     * Parameters:
+     *   system - The system to protect; it must outlive the manager
+     *   directory - Where the files go (created if missing)
+     *   options - See CheckpointOptions
+     */
+    CheckpointManager(RankingSystem& system, const std::string& directory, CheckpointOptions options = {});
+
+    /**
+     * Waits for a snapshot that is still being written
+     */
+    ~CheckpointManager();
+
+    CheckpointManager(const CheckpointManager&) = delete;
+    CheckpointManager& operator=(const CheckpointManager&) = delete;
+
+    /**
+     * Bring the system back from the directory, then start logging
+     *
+     * Steps:
+     * 1. Load the newest snapshot that opens cleanly
+     * 2. Load the deltas after it, in order, as long as they continue
+     *    one another
+     * 3. Replay every log after those, in order; records already
+     *    contained are skipped
+     * 4. Open a log for the changes from now on
+     *
+     * If the newest snapshot is damaged, or the logs do not continue it,
+     * the next older snapshot is tried. A damaged delta ends step 2
+     * early; the logs still hold its changes. With no snapshot at all
+     * the logs are replayed onto the system as it is (normally empty)
+     *
+     * Call it once, on a new RankingSystem, before anything else
+     *
+     * Returns: What was loaded (see RecoveryResult), or the error of
+     *          the last snapshot or log that was tried
+     */
+    std::expected<RecoveryResult, RankingError> recover();
+
+    /**
+     * Start a checkpoint if one is due (see CheckpointOptions)
+     *
+     * Cheap enough to call after every match or batch
+     * Also finishes a checkpoint whose snapshot is written by now
+     *
+     * Returns: true if a checkpoint was started, or the error of
+     *          a checkpoint that failed (its files are kept)
+     */
+    std::expected<bool, RankingError> checkpointIfDue();
+
+    /**
+     * Start a checkpoint now
+     *
+     * Steps:
+     * 1. Wait for the previous checkpoint, if it is still running
+     * 2. Copy the changed players (RankingSystem::captureDelta), or all
+     *    of them (captureSnapshot) if a full snapshot is due
+     * 3. Switch the system to a new log file, starting at the next change
+     * 4. Write the delta or snapshot on a background thread
+     *
+     * When a snapshot is safely on disk (noticed by checkpointIfDue,
+     * wait or the next checkpoint), older snapshots and the deltas and
+     * logs they cover are deleted
+     *
+     * Returns: Nothing if the checkpoint started (or nothing changed
+     *          since the last one), or the error of the previous
+     *          checkpoint or of opening the new log
+     */
+    std::expected<void, RankingError> checkpoint();
+
+    /**
+     * Wait until the running checkpoint is complete
+     *
+     * Returns: Nothing on success (or if none was running),
+     *          otherwise why writing the snapshot failed
+     */
+    std::expected<void, RankingError> wait();
+
+    /**
+     * True while a snapshot is being written
+     */
+    bool isRunning() const;
+
+};
+
+#endif
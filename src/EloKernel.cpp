@@ -0,0 +1,286 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "EloKernel.h"
+#include "Match.h"
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * The SIMD code below uses x86 intrinsics and GCC/Clang attributes
+ * On any other compiler or CPU only the scalar version is built
+ */
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && (defined(__GNUC__) || defined(__clang__))
+#define ELO_KERNEL_X86 1
+#include <immintrin.h>
+#else
+#define ELO_KERNEL_X86 0
+#endif
+
+namespace
+{
+
+/**
+ * Scalar version: one pair at a time with the exact formula
+ *
+ * Also used for the last few pairs that don't fill a whole SIMD register
+ *
+ * actualA == nullptr means "write expected scores",
+ * otherwise write the rating change K * (actual - expected)
+ */
+void kernelScalar(const double* ratingsA, const double* ratingsB, const double* actualA,
+                  double kFactor, double* out, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        const double expected = Match::calculateExpectedScore(ratingsA[i], ratingsB[i]);
+        out[i] = actualA == nullptr ? expected : kFactor * (actualA[i] - expected);
+    }
+}
+
+#if ELO_KERNEL_X86
+
+/**
+ * How the SIMD versions compute 10^x without std::pow
+ *
+ * 1. 10^x = 2^y with y = x * log2(10)
+ * 2. Split y into a whole number n and a fraction f in [-0.5, 0.5]
+ * 3. 2^n is built directly in the exponent bits of a double
+ * 4. 2^f = e^(f * ln 2) comes from a degree 11 polynomial (Taylor series)
+ *    On this small range the polynomial's relative error is below 1e-14
+ *
+ * y is clamped to [-1000, 1000] so 2^n always fits in a double;
+ * at that point the expected score is already exactly 0 or 1
+ */
+constexpr double Log2Of10Over400 = 3.321928094887362347870319429489 / 400.0;
+constexpr double Ln2 = 0.693147180559945309417232121458;
+constexpr double ExponentLimit = 1000.0;
+
+/**
+ * Adding 1.5 * 2^52 to a small double rounds it to a whole number,
+ * and leaves that whole number in the low bits of the result
+ */
+constexpr double RoundingMagic = 6755399441055744.0;
+
+/**
+ * 1/k! for k = 0..11, the Taylor coefficients of e^t
+ */
+constexpr double ExpCoefficients[12] = {
+    1.0,
+    1.0,
+    1.0 / 2.0,
+    1.0 / 6.0,
+    1.0 / 24.0,
+    1.0 / 120.0,
+    1.0 / 720.0,
+    1.0 / 5040.0,
+    1.0 / 40320.0,
+    1.0 / 362880.0,
+    1.0 / 3628800.0,
+    1.0 / 39916800.0
+};
+
+/**
+ * SSE2 version: 2 pairs per instruction
+ *
+ * Every x86-64 CPU has SSE2, so this is the minimum SIMD level there
+ */
+void kernelSse2(const double* ratingsA, const double* ratingsB, const double* actualA,
+                double kFactor, double* out, size_t count)
+{
+    const __m128d scale = _mm_set1_pd(Log2Of10Over400);
+    const __m128d low = _mm_set1_pd(-ExponentLimit);
+    const __m128d high = _mm_set1_pd(ExponentLimit);
+    const __m128d magic = _mm_set1_pd(RoundingMagic);
+    const __m128d ln2 = _mm_set1_pd(Ln2);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d k = _mm_set1_pd(kFactor);
+    const __m128i bias = _mm_set1_epi64x(1023);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d a = _mm_loadu_pd(ratingsA + i);
+        const __m128d b = _mm_loadu_pd(ratingsB + i);
+
+        __m128d y = _mm_mul_pd(_mm_sub_pd(b, a), scale);
+        y = _mm_min_pd(_mm_max_pd(y, low), high);
+
+        const __m128d shifted = _mm_add_pd(y, magic);
+        const __m128d n = _mm_sub_pd(shifted, magic);
+        const __m128d t = _mm_mul_pd(_mm_sub_pd(y, n), ln2);
+
+        __m128d p = _mm_set1_pd(ExpCoefficients[11]);
+        for (int c = 10; c >= 0; c--)
+        {
+            p = _mm_add_pd(_mm_mul_pd(p, t), _mm_set1_pd(ExpCoefficients[c]));
+        }
+
+        const __m128i exponent = _mm_slli_epi64(_mm_add_epi64(_mm_castpd_si128(shifted), bias), 52);
+        const __m128d powerOfTen = _mm_mul_pd(p, _mm_castsi128_pd(exponent));
+        const __m128d expected = _mm_div_pd(one, _mm_add_pd(one, powerOfTen));
+
+        if (actualA == nullptr)
+        {
+            _mm_storeu_pd(out + i, expected);
+        }
+        else
+        {
+            const __m128d actual = _mm_loadu_pd(actualA + i);
+            _mm_storeu_pd(out + i, _mm_mul_pd(k, _mm_sub_pd(actual, expected)));
+        }
+    }
+
+    kernelScalar(ratingsA, ratingsB, actualA, kFactor, out, i, count);
+}
+
+/**
+ * AVX2 version: 4 pairs per instruction, with fused multiply-add
+ *
+ * The target attribute lets this one function use AVX2 and FMA
+ * even though the rest of the program is compiled for any x86 CPU
+ * It is only called after detectSimdLevel() confirmed support
+ */
+__attribute__((target("avx2,fma")))
+void kernelAvx2(const double* ratingsA, const double* ratingsB, const double* actualA,
+                double kFactor, double* out, size_t count)
+{
+    const __m256d scale = _mm256_set1_pd(Log2Of10Over400);
+    const __m256d low = _mm256_set1_pd(-ExponentLimit);
+    const __m256d high = _mm256_set1_pd(ExponentLimit);
+    const __m256d magic = _mm256_set1_pd(RoundingMagic);
+    const __m256d ln2 = _mm256_set1_pd(Ln2);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d k = _mm256_set1_pd(kFactor);
+    const __m256i bias = _mm256_set1_epi64x(1023);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d a = _mm256_loadu_pd(ratingsA + i);
+        const __m256d b = _mm256_loadu_pd(ratingsB + i);
+
+        __m256d y = _mm256_mul_pd(_mm256_sub_pd(b, a), scale);
+        y = _mm256_min_pd(_mm256_max_pd(y, low), high);
+
+        const __m256d shifted = _mm256_add_pd(y, magic);
+        const __m256d n = _mm256_sub_pd(shifted, magic);
+        const __m256d t = _mm256_mul_pd(_mm256_sub_pd(y, n), ln2);
+
+        __m256d p = _mm256_set1_pd(ExpCoefficients[11]);
+        for (int c = 10; c >= 0; c--)
+        {
+            p = _mm256_fmadd_pd(p, t, _mm256_set1_pd(ExpCoefficients[c]));
+        }
+
+        const __m256i exponent = _mm256_slli_epi64(_mm256_add_epi64(_mm256_castpd_si256(shifted), bias), 52);
+        const __m256d powerOfTen = _mm256_mul_pd(p, _mm256_castsi256_pd(exponent));
+        const __m256d expected = _mm256_div_pd(one, _mm256_add_pd(one, powerOfTen));
+
+        if (actualA == nullptr)
+        {
+            _mm256_storeu_pd(out + i, expected);
+        }
+        else
+        {
+            const __m256d actual = _mm256_loadu_pd(actualA + i);
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(k, _mm256_sub_pd(actual, expected)));
+        }
+    }
+
+    kernelScalar(ratingsA, ratingsB, actualA, kFactor, out, i, count);
+}
+
+#endif
+
+/**
+ * Run the kernel for the chosen level
+ */
+void dispatch(const double* ratingsA, const double* ratingsB, const double* actualA,
+              double kFactor, double* out, size_t count, EloKernel::SimdLevel level)
+{
+    /**
+     * Never use more than the CPU supports
+     * The enum is ordered slowest to fastest, so std::min picks the safe one
+     */
+    level = std::min(level, EloKernel::detectSimdLevel());
+
+    switch (level)
+    {
+#if ELO_KERNEL_X86
+        case EloKernel::SimdLevel::AVX2:
+            kernelAvx2(ratingsA, ratingsB, actualA, kFactor, out, count);
+            return;
+        case EloKernel::SimdLevel::SSE2:
+            kernelSse2(ratingsA, ratingsB, actualA, kFactor, out, count);
+            return;
+#endif
+        default:
+            kernelScalar(ratingsA, ratingsB, actualA, kFactor, out, 0, count);
+            return;
+    }
+}
+
+}
+
+/**
+ * Asks the CPU which instruction sets it has
+ *
+ * A function-local static is initialised once, the first time through,
+ * so the check runs only once per program
+ */
+EloKernel::SimdLevel EloKernel::detectSimdLevel()
+{
+    static const SimdLevel level = []
+    {
+#if ELO_KERNEL_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+
+    return level;
+}
+
+void EloKernel::expectedScores(std::span<const double> ratingsA,
+                               std::span<const double> ratingsB,
+                               std::span<double> expectedA)
+{
+    expectedScores(ratingsA, ratingsB, expectedA, detectSimdLevel());
+}
+
+void EloKernel::expectedScores(std::span<const double> ratingsA,
+                               std::span<const double> ratingsB,
+                               std::span<double> expectedA,
+                               SimdLevel level)
+{
+    dispatch(ratingsA.data(), ratingsB.data(), nullptr, 0.0,
+             expectedA.data(), expectedA.size(), level);
+}
+
+void EloKernel::ratingDeltas(std::span<const double> ratingsA,
+                             std::span<const double> ratingsB,
+                             std::span<const double> actualA,
+                             double kFactor,
+                             std::span<double> deltaA)
+{
+    ratingDeltas(ratingsA, ratingsB, actualA, kFactor, deltaA, detectSimdLevel());
+}
+
+void EloKernel::ratingDeltas(std::span<const double> ratingsA,
+                             std::span<const double> ratingsB,
+                             std::span<const double> actualA,
+                             double kFactor,
+                             std::span<double> deltaA,
+                             SimdLevel level)
+{
+    dispatch(ratingsA.data(), ratingsB.data(), actualA.data(), kFactor,
+             deltaA.data(), deltaA.size(), level);
+}
@@ -0,0 +1,108 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef ELOKERNEL_H
+#define ELOKERNEL_H
+
+#include <span>
+
+/**
+ * EloKernel Class
+ *
+ * Computes expected scores and rating changes for many matches at once
+ *
+ * Match::calculateExpectedScore handles one pair of ratings with std::pow
+ * For replays and "what if" analysis we need millions of pairs,
+ * so these functions work on whole arrays and use SIMD instructions:
+ * one CPU instruction operates on 2 (SSE2) or 4 (AVX2) doubles together
+ *
+ * Which instruction set is used is decided at run time:
+ * the program checks what the CPU supports and picks the fastest option
+ * On other CPUs everything falls back to plain scalar code
+ *
+ * Accuracy:
+ * The SIMD versions replace std::pow with a polynomial approximation
+ * of 2^x. Compared to Match::calculateExpectedScore the expected score
+ * differs by at most 1e-13 (in practice a few units in the last digit),
+ * far below anything a rating could show
+ */
+class EloKernel
+{
+
+public:
+
+    /**
+     * The instruction sets the kernels can use, slowest to fastest
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * The fastest level this CPU supports
+     *
+     * Checked once, the answer is remembered
+     */
+    static SimdLevel detectSimdLevel();
+
+    /**
+     * Expected score of player A against player B, for every pair
+     *
+     * Parameters:
+     *   ratingsA - Rating of player A in each pair
+     *   ratingsB - Rating of player B in each pair
+     *   expectedA - Output: expected score of A in each pair
+     *
+     * Computes expectedA.size() pairs; both inputs must be at least that long
+     * Player B's expected score is simply 1 - expectedA[i]
+     */
+    static void expectedScores(std::span<const double> ratingsA,
+                               std::span<const double> ratingsB,
+                               std::span<double> expectedA);
+
+    /**
+     * Same as above, but with a chosen instruction set
+     *
+     * A level the CPU does not support is lowered to detectSimdLevel()
+     * Mainly useful for tests and benchmarks
+     */
+    static void expectedScores(std::span<const double> ratingsA,
+                               std::span<const double> ratingsB,
+                               std::span<double> expectedA,
+                               SimdLevel level);
+
+    /**
+     * Rating change of player A for every pair
+     *
+     * Parameters:
+     *   ratingsA - Rating of player A in each pair
+     *   ratingsB - Rating of player B in each pair
+     *   actualA - What A scored: 1.0 win, 0.5 draw, 0.0 loss
+     *   kFactor - How much ratings should change
+     *   deltaA - Output: K * (actual - expected) for player A
+     *
+     * Computes deltaA.size() pairs; all inputs must be at least that long
+     * Elo is zero-sum, so player B's change is -deltaA[i]
+     */
+    static void ratingDeltas(std::span<const double> ratingsA,
+                             std::span<const double> ratingsB,
+                             std::span<const double> actualA,
+                             double kFactor,
+                             std::span<double> deltaA);
+
+    /**
+     * Same as above, but with a chosen instruction set
+     */
+    static void ratingDeltas(std::span<const double> ratingsA,
+                             std::span<const double> ratingsB,
+                             std::span<const double> actualA,
+                             double kFactor,
+                             std::span<double> deltaA,
+                             SimdLevel level);
+
+};
+
+#endif
@@ -0,0 +1,237 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef EXPECTEDSCORETABLE_H
+#define EXPECTEDSCORETABLE_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * ExpectedScoreTable
+ *
+ * A precomputed table of the Elo expected score curve
+ *
+ * The expected score only depends on the rating difference:
+ *   E = 1 / (1 + 10^(difference / 400))
+ * So instead of calling std::pow for every match, we store E for
+ * difference = 0, Step, 2 * Step, ... MaxDifference once, and for any
+ * difference in between we draw a straight line between the two
+ * neighbouring entries (linear interpolation)
+ *
+ * The whole table is built by the compiler (constexpr), so it costs
+ * nothing at run time and lives in read-only memory
+ *
+ * Template parameters:
+ *   MaxDifference - Largest difference covered by the table (rating points)
+ *   Step - Distance between two table entries (rating points)
+ *
+ * Negative differences use the symmetry E(-d) = 1 - E(d),
+ * so the table only stores the half from 0 to MaxDifference
+ * Differences beyond MaxDifference fall back to the exact formula
+ *
+ * Error guarantee:
+ * Linear interpolation is off by at most Step^2 / 8 * max|E''|,
+ * and max|E''| = (ln 10 / 400)^2 / (6 * sqrt(3)) < 3.2e-6
+ * With Step = 1 that is at most 4e-7, well below 0.001 rating points
+ * for any K-factor up to 2000
+ */
+template <int MaxDifference = 2000, int Step = 1>
+class ExpectedScoreTable
+{
+
+    static_assert(MaxDifference > 0 && Step > 0 && MaxDifference % Step == 0,
+                  "MaxDifference must be a positive multiple of Step");
+
+public:
+
+    /**
+     * Number of stored entries (both ends included)
+     */
+    static constexpr int Size = MaxDifference / Step + 1;
+
+    /**
+     * Upper bound on the difference from the exact formula, see above
+     */
+    static constexpr double MaxError = static_cast<double>(Step) * Step / 8.0 * 3.2e-6;
+
+private:
+
+    std::array<double, Size> values{};
+
+    /**
+     * e^x that the compiler can evaluate (std::exp is not constexpr)
+     *
+     * 1. Write x = n * ln 2 + r with |r| <= ln 2 / 2
+     * 2. e^r from its Taylor series, which converges quickly for small r
+     * 3. Multiply by 2^n, one factor of 2 at a time
+     */
+    static constexpr double constexprExp(double x)
+    {
+        constexpr double ln2 = 0.693147180559945309417232121458;
+
+        const double scaled = x / ln2;
+        const int n = static_cast<int>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        const double r = x - n * ln2;
+
+        double term = 1.0;
+        double sum = 1.0;
+        for (int k = 1; k < 25; k++)
+        {
+            term *= r / k;
+            sum += term;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            sum *= 2.0;
+        }
+        for (int i = 0; i > n; i--)
+        {
+            sum /= 2.0;
+        }
+        return sum;
+    }
+
+public:
+
+    /**
+     * Builds the table; runs at compile time for constexpr objects
+     */
+    constexpr ExpectedScoreTable()
+    {
+        constexpr double ln10Over400 = 2.302585092994045684017991454684 / 400.0;
+
+        for (int i = 0; i < Size; i++)
+        {
+            const double difference = static_cast<double>(i) * Step;
+            values[i] = 1.0 / (1.0 + constexprExp(difference * ln10Over400));
+        }
+    }
+
+    /**
+     * Stored value for a difference of index * Step
+     */
+    constexpr double entry(int index) const
+    {
+        return values[index];
+    }
+
+    /**
+     * Expected score of player A against player B
+     *
+     * Same meaning as Match::calculateExpectedScore(ratingA, ratingB)
+     */
+    double operator()(double ratingA, double ratingB) const
+    {
+        const double difference = ratingB - ratingA;
+        const double distance = difference < 0 ? -difference : difference;
+
+        /**
+         * Outside the table: use the exact formula
+         * (the ! form also sends NaN down this path)
+         */
+        if (!(distance < MaxDifference))
+        {
+            return 1.0 / (1.0 + std::pow(10.0, difference / 400.0));
+        }
+
+        /**
+         * Find the two neighbouring entries and interpolate
+         * distance < MaxDifference, so index + 1 is always inside the table
+         */
+        const double position = distance / Step;
+        const int index = static_cast<int>(position);
+        const double fraction = position - index;
+        const double expected = values[index] + (values[index + 1] - values[index]) * fraction;
+
+        /**
+         * The table holds the case where B is stronger (or equal)
+         * If A is stronger, flip it with E(-d) = 1 - E(d)
+         */
+        return difference < 0 ? 1.0 - expected : expected;
+    }
+
+};
+
+/**
+ * The table used by Match and RankingSystem
+ *
+ * inline constexpr means: built at compile time, one copy in the program
+ */
+inline constexpr ExpectedScoreTable<> DefaultExpectedScoreTable{};
+
+/**
+ * FixedExpectedScoreTable
+ *
+ * The same curve for fixed-point ratings (see Rating.h), with integers only
+ *
+ * Each entry is E * 2^30, rounded, taken from DefaultExpectedScoreTable
+ * A lookup receives the rating difference in thousandths of a point and
+ * interpolates between whole-point entries with integer arithmetic,
+ * so every machine gets exactly the same answer
+ *
+ * Beyond 2000 points the table end is used: E is already below 1.2e-5
+ * there, which moves a rating by less than 0.001 points for K up to 80
+ */
+class FixedExpectedScoreTable
+{
+
+public:
+
+    /**
+     * The stored scores are E * 2^FractionBits
+     */
+    static constexpr int FractionBits = 30;
+    static constexpr std::int64_t One = std::int64_t{1} << FractionBits;
+
+    /**
+     * Units per rating point in the difference passed to operator()
+     */
+    static constexpr std::int64_t UnitsPerPoint = 1000;
+
+private:
+
+    static constexpr int Size = ExpectedScoreTable<>::Size;
+
+    std::array<std::int32_t, Size> values{};
+
+public:
+
+    constexpr FixedExpectedScoreTable()
+    {
+        for (int i = 0; i < Size; i++)
+        {
+            values[i] = static_cast<std::int32_t>(DefaultExpectedScoreTable.entry(i) * One + 0.5);
+        }
+    }
+
+    /**
+     * Expected score (times 2^30) of a player whose opponent is rated
+     * difference thousandths of a point higher
+     */
+    constexpr std::int64_t operator()(std::int64_t difference) const
+    {
+        const std::int64_t distance = difference < 0 ? -difference : difference;
+
+        std::int64_t expected;
+        if (distance >= (Size - 1) * UnitsPerPoint)
+        {
+            expected = values[Size - 1];
+        }
+        else
+        {
+            const std::int64_t index = distance / UnitsPerPoint;
+            const std::int64_t fraction = distance % UnitsPerPoint;
+            expected = values[index] + (values[index + 1] - values[index]) * fraction / UnitsPerPoint;
+        }
+
+        return difference < 0 ? One - expected : expected;
+    }
+
+};
+
+inline constexpr FixedExpectedScoreTable DefaultFixedExpectedScoreTable{};
+
+#endif
@@ -0,0 +1,440 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "LeaderboardIndex.h"
+#include <algorithm>
+#include <numeric>
+
+/**
+ * Leaderboard order: rating descending, then id ascending
+ *
+ * The id tie-break makes the order total, so every player has
+ * exactly one place in the tree even when ratings are equal
+ */
+bool LeaderboardIndex::before(PlayerId a, PlayerId b) const
+{
+    const RatingValue ratingA = nodes[a].rating;
+    const RatingValue ratingB = nodes[b].rating;
+
+    if (ratingA != ratingB)
+    {
+        return ratingA > ratingB;
+    }
+    return a < b;
+}
+
+std::uint32_t LeaderboardIndex::sizeOf(PlayerId node) const
+{
+    return node == None ? 0 : nodes[node].size;
+}
+
+void LeaderboardIndex::updateSize(PlayerId node)
+{
+    nodes[node].size = sizeOf(nodes[node].left) + sizeOf(nodes[node].right) + 1;
+}
+
+/**
+ * Priorities only have to look random; they do not have to be random
+ *
+ * This is the final mixing step of the MurmurHash3 hash:
+ * consecutive ids end up with unrelated priorities
+ */
+std::uint32_t LeaderboardIndex::priorityFor(PlayerId id)
+{
+    std::uint32_t h = id + 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * SPLIT
+ *
+ * After the call:
+ * - lower holds every node of the subtree that comes before pivot
+ * - upper holds every node that comes after it
+ *
+ * Walks down one path of the tree, so it is O(depth)
+ */
+void LeaderboardIndex::split(PlayerId node, PlayerId pivot, PlayerId& lower, PlayerId& upper)
+{
+    if (node == None)
+    {
+        lower = None;
+        upper = None;
+        return;
+    }
+
+    if (before(node, pivot))
+    {
+        /**
+         * node and its left subtree belong to lower;
+         * its right subtree still has to be divided
+         */
+        split(nodes[node].right, pivot, nodes[node].right, upper);
+        lower = node;
+    }
+    else
+    {
+        split(nodes[node].left, pivot, lower, nodes[node].left);
+        upper = node;
+    }
+
+    updateSize(node);
+}
+
+/**
+ * MERGE
+ *
+ * Every node of a comes before every node of b
+ * The root with the higher priority stays on top,
+ * and the other tree is merged into its inner side
+ */
+PlayerId LeaderboardIndex::merge(PlayerId a, PlayerId b)
+{
+    if (a == None)
+    {
+        return b;
+    }
+    if (b == None)
+    {
+        return a;
+    }
+
+    if (nodes[a].priority > nodes[b].priority)
+    {
+        nodes[a].right = merge(nodes[a].right, b);
+        updateSize(a);
+        return a;
+    }
+
+    nodes[b].left = merge(a, nodes[b].left);
+    updateSize(b);
+    return b;
+}
+
+/**
+ * INSERT NODE
+ *
+ * Walk down like a normal search tree until we reach a node whose
+ * priority is lower than the new one; the new node takes its place and
+ * that subtree is split into the new node's left and right children
+ *
+ * node is a reference to the parent's child link (or to root),
+ * so assigning to it relinks the tree
+ */
+void LeaderboardIndex::insertNode(PlayerId& node, PlayerId id)
+{
+    if (node == None)
+    {
+        node = id;
+        return;
+    }
+
+    if (nodes[id].priority > nodes[node].priority)
+    {
+        split(node, id, nodes[id].left, nodes[id].right);
+        updateSize(id);
+        node = id;
+        return;
+    }
+
+    nodes[node].size++;
+    insertNode(before(id, node) ? nodes[node].left : nodes[node].right, id);
+}
+
+/**
+ * ERASE NODE
+ *
+ * Find the node on its search path, then replace it by its two
+ * children merged together; every node passed on the way loses one
+ */
+void LeaderboardIndex::eraseNode(PlayerId& node, PlayerId id)
+{
+    if (node == id)
+    {
+        node = merge(nodes[id].left, nodes[id].right);
+        return;
+    }
+
+    nodes[node].size--;
+    eraseNode(before(id, node) ? nodes[node].left : nodes[node].right, id);
+}
+
+void LeaderboardIndex::clear()
+{
+    nodes.clear();
+    root = None;
+}
+
+void LeaderboardIndex::reserve(size_t playerCount)
+{
+    nodes.reserve(playerCount);
+}
+
+size_t LeaderboardIndex::size() const
+{
+    return sizeOf(root);
+}
+
+/**
+ * A node that is in the tree always has a size of at least 1
+ */
+bool LeaderboardIndex::contains(PlayerId id) const
+{
+    return id < nodes.size() && nodes[id].size != 0;
+}
+
+void LeaderboardIndex::insert(PlayerId id, RatingValue rating)
+{
+    if (id >= nodes.size())
+    {
+        nodes.resize(static_cast<size_t>(id) + 1);
+    }
+
+    Node& node = nodes[id];
+    node.rating = rating;
+    node.left = None;
+    node.right = None;
+    node.size = 1;
+    node.priority = priorityFor(id);
+
+    insertNode(root, id);
+}
+
+/**
+ * Reset the nodes to players 0 .. ratings.size() - 1, not yet linked
+ */
+void LeaderboardIndex::resetNodes(std::span<const RatingValue> ratings)
+{
+    const size_t count = ratings.size();
+
+    nodes.assign(count, Node{});
+    root = None;
+
+    for (PlayerId id = 0; id < count; id++)
+    {
+        nodes[id].rating = ratings[id];
+        nodes[id].priority = priorityFor(id);
+    }
+}
+
+void LeaderboardIndex::build(std::span<const RatingValue> ratings)
+{
+    resetNodes(ratings);
+
+    std::vector<PlayerId> order(ratings.size());
+    std::iota(order.begin(), order.end(), PlayerId{0});
+
+    std::sort(order.begin(), order.end(),
+        [this](PlayerId a, PlayerId b)
+        {
+            return before(a, b);
+        });
+
+    link(order);
+}
+
+/**
+ * The order is only trusted after checking it:
+ * every id in range and each one strictly before the next
+ * Strictly increasing also means no id appears twice,
+ * so with the right count it holds every player exactly once
+ */
+void LeaderboardIndex::build(std::span<const RatingValue> ratings, std::span<const PlayerId> order)
+{
+    resetNodes(ratings);
+
+    bool valid = order.size() == ratings.size();
+    for (size_t i = 0; valid && i < order.size(); i++)
+    {
+        valid = order[i] < ratings.size() && (i == 0 || before(order[i - 1], order[i]));
+    }
+
+    if (!valid)
+    {
+        build(ratings);
+        return;
+    }
+
+    link(order);
+}
+
+/**
+ * Building a treap from nodes already in order:
+ *
+ * Go through the nodes from first to last, keeping the "right spine"
+ * (the path from the root always going right) on a stack
+ * A new node belongs at the end of that spine, below the last node
+ * with a higher priority; nodes with lower priority are popped off
+ * and become its left subtree
+ *
+ * Every node is pushed and popped at most once, so this is O(n)
+ */
+void LeaderboardIndex::link(std::span<const PlayerId> order)
+{
+    std::vector<PlayerId> spine;
+    for (const PlayerId id : order)
+    {
+        PlayerId lastPopped = None;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[id].priority)
+        {
+            lastPopped = spine.back();
+            spine.pop_back();
+        }
+
+        nodes[id].left = lastPopped;
+        if (!spine.empty())
+        {
+            nodes[spine.back()].right = id;
+        }
+        spine.push_back(id);
+    }
+
+    if (!spine.empty())
+    {
+        root = spine.front();
+        computeSizes(root);
+    }
+}
+
+/**
+ * Post-order: a node's size is known once both children are done
+ * The recursion is as deep as the tree, which stays around 2 log n
+ */
+std::uint32_t LeaderboardIndex::computeSizes(PlayerId node)
+{
+    if (node == None)
+    {
+        return 0;
+    }
+
+    nodes[node].size = computeSizes(nodes[node].left) + computeSizes(nodes[node].right) + 1;
+    return nodes[node].size;
+}
+
+/**
+ * The node is removed while it still holds the old rating
+ * (that is how eraseNode finds it), then filed under the new one
+ */
+void LeaderboardIndex::update(PlayerId id, RatingValue newRating)
+{
+    if (nodes[id].rating == newRating)
+    {
+        return;
+    }
+
+    eraseNode(root, id);
+    insert(id, newRating);
+}
+
+/**
+ * Walk down from the root
+ * If the left subtree holds more than position players, the answer is in it
+ * Otherwise skip the left subtree and the node itself and go right
+ */
+PlayerId LeaderboardIndex::at(size_t position) const
+{
+    PlayerId node = root;
+
+    while (node != None)
+    {
+        const size_t leftSize = sizeOf(nodes[node].left);
+
+        if (position < leftSize)
+        {
+            node = nodes[node].left;
+        }
+        else if (position == leftSize)
+        {
+            return node;
+        }
+        else
+        {
+            position -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+
+    return None;
+}
+
+/**
+ * Search for the player from the root
+ * Every time the search goes right, the left subtree and the node
+ * passed are all ahead of the player, so they are added to the count
+ */
+size_t LeaderboardIndex::positionOf(PlayerId id) const
+{
+    size_t position = 0;
+    PlayerId node = root;
+
+    while (node != id)
+    {
+        if (before(id, node))
+        {
+            node = nodes[node].left;
+        }
+        else
+        {
+            position += sizeOf(nodes[node].left) + 1;
+            node = nodes[node].right;
+        }
+    }
+
+    return position + sizeOf(nodes[id].left);
+}
+
+/**
+ * In-order walk restricted to positions [first, first + count)
+ *
+ * A left subtree that ends before first is skipped entirely,
+ * and the walk stops as soon as count players have been collected
+ */
+void LeaderboardIndex::collectRange(PlayerId node, size_t first, size_t count, std::vector<PlayerId>& out) const
+{
+    if (node == None || out.size() == count)
+    {
+        return;
+    }
+
+    const size_t leftSize = sizeOf(nodes[node].left);
+
+    if (first < leftSize)
+    {
+        collectRange(nodes[node].left, first, count, out);
+    }
+
+    if (out.size() < count && first <= leftSize)
+    {
+        out.push_back(node);
+    }
+
+    if (out.size() < count)
+    {
+        const size_t skipped = leftSize + 1;
+        collectRange(nodes[node].right, first > skipped ? first - skipped : 0, count, out);
+    }
+}
+
+std::vector<PlayerId> LeaderboardIndex::range(size_t first, size_t count) const
+{
+    std::vector<PlayerId> out;
+
+    if (first >= size())
+    {
+        return out;
+    }
+
+    if (count > size() - first)
+    {
+        count = size() - first;
+    }
+
+    out.reserve(count);
+    collectRange(root, first, count, out);
+    return out;
+}
@@ -0,0 +1,262 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef LEADERBOARDINDEX_H
+#define LEADERBOARDINDEX_H
+
+#include "PlayerTable.h"
+#include "Rating.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * LeaderboardIndex Class
+ *
+ * Keeps every player in leaderboard order at all times,
+ * so the leaderboard never has to be sorted from scratch
+ *
+ * Leaderboard order:
+ * - Higher rating first
+ * - Equal ratings: lower id (the player added earlier) first
+ *
+ * How it works: a treap
+ * A treap is a binary search tree where every node also gets a "priority"
+ * Nodes are ordered like a search tree by (rating, id), and like a heap by
+ * priority (a parent's priority is higher than its children's)
+ * With priorities that look random, the tree stays balanced on average,
+ * so inserting, removing and finding a player take O(log n) steps
+ *
+ * Order statistics:
+ * Every node also stores the size of its subtree
+ * That answers "who is at position k?" and "at which position is this
+ * player?" in O(log n) as well, by skipping whole subtrees at a time
+ *
+ * Storage:
+ * There are no heap-allocated nodes: node N is player N
+ * (ids are dense row numbers), so the tree is one vector of small
+ * structs and "pointers" are just player ids
+ */
+class LeaderboardIndex
+{
+
+private:
+
+    /**
+     * Marks a missing child (an empty subtree)
+     */
+    static constexpr PlayerId None = InvalidPlayerId;
+
+    /**
+     * One tree node per player id
+     *
+     * rating is the key the node is currently filed under
+     * It is a copy of the table's rating, kept here so the node
+     * can still be found after the table has already changed
+     */
+    struct Node
+    {
+        RatingValue rating{};
+        PlayerId left = None;
+        PlayerId right = None;
+        std::uint32_t size = 0;
+        std::uint32_t priority = 0;
+    };
+
+    std::vector<Node> nodes;
+
+    PlayerId root = None;
+
+    /**
+     * True if a comes before b on the leaderboard
+     */
+    bool before(PlayerId a, PlayerId b) const;
+
+    /**
+     * Subtree size, 0 for an empty subtree
+     */
+    std::uint32_t sizeOf(PlayerId node) const;
+
+    /**
+     * Recompute a node's size from its children
+     */
+    void updateSize(PlayerId node);
+
+    /**
+     * A fixed, well-mixed priority for each id
+     * Deterministic, so the same players always build the same tree
+     */
+    static std::uint32_t priorityFor(PlayerId id);
+
+    /**
+     * The recursive treap operations
+     *
+     * split: divide a subtree into the nodes before pivot and the rest
+     * merge: join two subtrees where everything in a comes before b
+     * insertNode / eraseNode: add or remove one node below node
+     */
+    void split(PlayerId node, PlayerId pivot, PlayerId& lower, PlayerId& upper);
+    PlayerId merge(PlayerId a, PlayerId b);
+    void insertNode(PlayerId& node, PlayerId id);
+    void eraseNode(PlayerId& node, PlayerId id);
+
+    /**
+     * Bulk build helpers
+     *
+     * resetNodes: one unlinked node per rating
+     * link: connect the nodes, given every id in leaderboard order
+     */
+    void resetNodes(std::span<const RatingValue> ratings);
+    void link(std::span<const PlayerId> order);
+
+    /**
+     * Fill in subtree sizes below node after a bulk build
+     */
+    std::uint32_t computeSizes(PlayerId node);
+
+    /**
+     * In-order walk of the positions [first, first + count) below node
+     */
+    void collectRange(PlayerId node, size_t first, size_t count, std::vector<PlayerId>& out) const;
+
+public:
+
+    /**
+     * Remove every player
+     */
+    void clear();
+
+    /**
+     * Reserve room for this many player ids
+     */
+    void reserve(size_t playerCount);
+
+    /**
+     * Number of players in the index
+     */
+    size_t size() const;
+
+    /**
+     * Check whether a player id is in the index
+     */
+    bool contains(PlayerId id) const;
+
+    /**
+     * Add a player with their current rating
+     *
+     * The id must not be in the index yet
+     * O(log n)
+     */
+    void insert(PlayerId id, RatingValue rating);
+
+    /**
+     * Replace the whole index with players 0 .. ratings.size() - 1
+     *
+     * Parameters:
+     *   ratings - Rating of every player, indexed by id
+     *
+     * Gives the same tree as inserting them one by one, but much faster
+     * for a whole population (used when loading a file):
+     * 1. Sort the ids into leaderboard order - one sort instead of
+     *    n separate walks down the tree with a cache miss at every step
+     * 2. Build the tree from left to right with a stack in O(n),
+     *    since the order and the priorities fix its shape
+     */
+    void build(std::span<const RatingValue> ratings);
+
+    /**
+     * Same as build above, for a caller that already knows the order
+     *
+     * Parameters:
+     *   ratings - Rating of every player, indexed by id
+     *   order - Every id in leaderboard order (for example saved in a snapshot)
+     *
+     * Skips the sort: the order is checked in one pass, O(n), and used
+     * as it is; if it is not exactly the leaderboard order for these
+     * ratings, the ids are sorted as usual, so a wrong order never
+     * produces a wrong tree
+     */
+    void build(std::span<const RatingValue> ratings, std::span<const PlayerId> order);
+
+    /**
+     * Move a player to the place that matches a new rating
+     *
+     * The id must be in the index
+     * O(log n): the node is taken out and put back in
+     */
+    void update(PlayerId id, RatingValue newRating);
+
+    /**
+     * The player at a leaderboard position
+     *
+     * Parameters:
+     *   position - 0 is the top of the leaderboard; must be below size()
+     *
+     * O(log n)
+     */
+    PlayerId at(size_t position) const;
+
+    /**
+     * The leaderboard position of a player
+     *
+     * Returns: 0 for the top player, size() - 1 for the last
+     *          The id must be in the index
+     *
+     * O(log n)
+     */
+    size_t positionOf(PlayerId id) const;
+
+    /**
+     * Players at positions first, first + 1, ... in leaderboard order
+     *
+     * Parameters:
+     *   first - Position of the first player to return
+     *   count - How many players to return (fewer if the end is reached)
+     *
+     * O(log n + count): subtrees before first are skipped, not visited
+     */
+    std::vector<PlayerId> range(size_t first, size_t count) const;
+
+    /**
+     * Visit players in leaderboard order, from the top
+     *
+     * Parameters:
+     *   visit - Called as visit(id) for each player; return false to stop
+     *
+     * Only the players visited before stopping are touched, so asking for
+     * the first few players that meet some condition is cheap when the
+     * condition is common
+     *
+     * Uses an explicit stack instead of recursion; the stack holds
+     * one entry per level of the tree
+     */
+    template <typename Visitor>
+    void visitInOrder(Visitor visit) const
+    {
+        std::vector<PlayerId> stack;
+        PlayerId node = root;
+
+        while (node != None || !stack.empty())
+        {
+            while (node != None)
+            {
+                stack.push_back(node);
+                node = nodes[node].left;
+            }
+
+            node = stack.back();
+            stack.pop_back();
+
+            if (!visit(node))
+            {
+                return;
+            }
+
+            node = nodes[node].right;
+        }
+    }
+
+};
+
+#endif
@@ -0,0 +1,99 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "LeaderboardPageCache.h"
+#include <utility>
+
+void LeaderboardPageCache::invalidatePages(size_t firstPage, size_t lastPage)
+{
+    for (size_t page = firstPage; page <= lastPage && page < pages.size(); page++)
+    {
+        if (valid[page])
+        {
+            valid[page] = 0;
+            validCount--;
+        }
+    }
+}
+
+void LeaderboardPageCache::clear()
+{
+    pageSize = 0;
+    pages.clear();
+    valid.clear();
+    validCount = 0;
+}
+
+bool LeaderboardPageCache::empty() const
+{
+    return validCount == 0;
+}
+
+size_t LeaderboardPageCache::getPageSize() const
+{
+    return pageSize;
+}
+
+const std::string* LeaderboardPageCache::find(size_t page, size_t pageSize) const
+{
+    if (page == 0 || pageSize != this->pageSize)
+    {
+        return nullptr;
+    }
+
+    const size_t index = page - 1;
+    if (index >= pages.size() || !valid[index])
+    {
+        return nullptr;
+    }
+
+    return &pages[index];
+}
+
+/**
+ * The vectors grow to cover the page; pages in between stay invalid
+ */
+const std::string& LeaderboardPageCache::store(size_t page, size_t pageSize, std::string text)
+{
+    if (pageSize != this->pageSize)
+    {
+        clear();
+        this->pageSize = pageSize;
+    }
+
+    const size_t index = page - 1;
+    if (index >= pages.size())
+    {
+        pages.resize(index + 1);
+        valid.resize(index + 1, 0);
+    }
+
+    pages[index] = std::move(text);
+    if (!valid[index])
+    {
+        valid[index] = 1;
+        validCount++;
+    }
+
+    return pages[index];
+}
+
+void LeaderboardPageCache::invalidatePositions(size_t first, size_t last)
+{
+    if (validCount == 0)
+    {
+        return;
+    }
+
+    invalidatePages(first / pageSize, last / pageSize);
+}
+
+void LeaderboardPageCache::invalidateFrom(size_t first)
+{
+    if (validCount == 0)
+    {
+        return;
+    }
+
+    invalidatePages(first / pageSize, pages.size() - 1);
+}
@@ -0,0 +1,125 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef LEADERBOARDPAGECACHE_H
+#define LEADERBOARDPAGECACHE_H
+
+#include "PlayerTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * LeaderboardRow
+ *
+ * One line of the leaderboard as plain data,
+ * for callers that want to build their own display
+ *
+ * rank starts at 1 like RankingSystem::rankOf
+ * name is a copy, so a row stays valid after more players are added
+ */
+struct LeaderboardRow
+{
+    size_t rank;
+    PlayerId id;
+    std::string name;
+    double rating;
+    int gamesPlayed;
+    int wins;
+    int losses;
+    int draws;
+};
+
+/**
+ * LeaderboardPageCache Class
+ *
+ * Remembers the rendered text of leaderboard pages
+ *
+ * A page is pageSize consecutive leaderboard positions:
+ *   page 1 = positions 0 .. pageSize - 1, page 2 = the next pageSize, ...
+ *
+ * When a match or a new player changes some positions, only the pages
+ * holding those positions are dropped; every other page is served from
+ * the stored text as is, without looking at the players again
+ *
+ * The cache only stores and forgets text; RankingSystem decides
+ * what to render and which positions changed
+ */
+class LeaderboardPageCache
+{
+
+private:
+
+    /**
+     * Rows per page; 0 until the first page is stored
+     */
+    size_t pageSize = 0;
+
+    /**
+     * Text and validity per page (index 0 is page 1)
+     *
+     * A dropped page keeps its string, so rendering it again
+     * can reuse the memory already allocated for it
+     */
+    std::vector<std::string> pages;
+    std::vector<std::uint8_t> valid;
+
+    /**
+     * How many pages are currently valid
+     */
+    size_t validCount = 0;
+
+    /**
+     * Drop pages firstPage .. lastPage (0-based, inclusive; pages past the end are ignored)
+     */
+    void invalidatePages(size_t firstPage, size_t lastPage);
+
+public:
+
+    /**
+     * Drop every page and forget the page size
+     */
+    void clear();
+
+    /**
+     * True if no page is stored
+     *
+     * RankingSystem checks this first, so keeping the cache up to date
+     * costs nothing while nobody is reading pages
+     */
+    bool empty() const;
+
+    /**
+     * The page size the stored pages were rendered with
+     */
+    size_t getPageSize() const;
+
+    /**
+     * The stored text of a page (1-based), or nullptr if it has to be rendered
+     *
+     * Also returns nullptr when pageSize differs from the stored pages
+     */
+    const std::string* find(size_t page, size_t pageSize) const;
+
+    /**
+     * Store a freshly rendered page and return the stored text
+     *
+     * A different pageSize than before drops every stored page first
+     */
+    const std::string& store(size_t page, size_t pageSize, std::string text);
+
+    /**
+     * Leaderboard positions first .. last (0-based, inclusive) changed
+     */
+    void invalidatePositions(size_t first, size_t last);
+
+    /**
+     * Every position from first onwards changed
+     * (a new player pushes everyone below them down by one)
+     */
+    void invalidateFrom(size_t first);
+
+};
+
+#endif
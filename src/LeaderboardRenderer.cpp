@@ -0,0 +1,100 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "LeaderboardRenderer.h"
+#include <charconv>
+
+/**
+ * The buffer gets a little more than one chunk, so the row that
+ * crosses the chunk size still fits without growing it
+ */
+LeaderboardRenderer::LeaderboardRenderer(size_t chunkSize)
+    : chunkSize(chunkSize)
+{
+    buffer.reserve(chunkSize + 256);
+}
+
+void LeaderboardRenderer::appendField(std::string_view text, size_t width)
+{
+    buffer.append(text);
+    if (text.size() < width)
+    {
+        buffer.append(width - text.size(), ' ');
+    }
+}
+
+void LeaderboardRenderer::appendField(int value, size_t width)
+{
+    char digits[16];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    appendField(std::string_view(digits, result.ptr - digits), width);
+}
+
+void LeaderboardRenderer::appendText(std::string_view text)
+{
+    buffer.append(text);
+}
+
+/**
+ * Same titles and widths as the leaderboard has always used
+ */
+void LeaderboardRenderer::appendHeader()
+{
+    appendField("Name", 20);
+    appendField("Rating", 10);
+    appendField("Games", 8);
+    appendField("Wins", 6);
+    appendField("Loses", 6);
+    appendField("Draws", 6);
+    buffer.push_back('\n');
+
+    buffer.append(56, '-');
+    buffer.push_back('\n');
+}
+
+/**
+ * Columns: name 20, rating 10, games 8, wins / losses / draws 6 each
+ *
+ * The rating uses std::chars_format::fixed with precision 1,
+ * which rounds exactly like std::fixed with std::setprecision(1)
+ */
+void LeaderboardRenderer::appendRow(std::string_view name, double rating, int gamesPlayed, int wins, int losses,
+                                    int draws)
+{
+    appendField(name, 20);
+
+    /**
+     * Large enough for any double in fixed notation (about 310 digits at most)
+     */
+    char digits[328];
+    const std::to_chars_result result =
+        std::to_chars(digits, digits + sizeof(digits), rating, std::chars_format::fixed, 1);
+    appendField(std::string_view(digits, result.ptr - digits), 10);
+
+    appendField(gamesPlayed, 8);
+    appendField(wins, 6);
+    appendField(losses, 6);
+    appendField(draws, 6);
+    buffer.push_back('\n');
+}
+
+bool LeaderboardRenderer::full() const
+{
+    return buffer.size() >= chunkSize;
+}
+
+std::string_view LeaderboardRenderer::text() const
+{
+    return buffer;
+}
+
+void LeaderboardRenderer::writeTo(std::ostream& out)
+{
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void LeaderboardRenderer::clear()
+{
+    buffer.clear();
+}
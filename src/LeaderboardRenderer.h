@@ -0,0 +1,104 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef LEADERBOARDRENDERER_H
+#define LEADERBOARDRENDERER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * LeaderboardRenderer Class
+ *
+ * Formats leaderboard text into one reusable buffer
+ *
+ * Printing a row with Player::displayStats goes through a chain of
+ * stream manipulators and ends with std::endl, which flushes the stream:
+ * for a 100,000 player leaderboard that is 100,000 separate writes
+ *
+ * The renderer instead:
+ * - Converts numbers with std::to_chars (no locale, no stream state)
+ * - Pads the columns by hand to the same widths
+ * - Collects many rows in its buffer and hands them to the stream
+ *   in one write per chunk
+ *
+ * The text is byte for byte what displayStats and displayLeaderboard
+ * have always printed
+ *
+ * The buffer keeps its memory between uses, so once it has grown
+ * to the chunk size, rendering does not allocate at all
+ */
+class LeaderboardRenderer
+{
+
+private:
+
+    std::string buffer;
+
+    /**
+     * full() becomes true once the buffer holds this many bytes
+     */
+    size_t chunkSize;
+
+    /**
+     * Append text, then spaces up to width characters
+     * (like std::left with std::setw: longer text is not cut)
+     */
+    void appendField(std::string_view text, size_t width);
+
+    /**
+     * Append an integer in a column of the given width
+     */
+    void appendField(int value, size_t width);
+
+public:
+
+    /**
+     * 64 KB per write is large enough that the cost of each
+     * write disappears, and small enough to stay in the cache
+     */
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    explicit LeaderboardRenderer(size_t chunkSize = DefaultChunkSize);
+
+    /**
+     * Append text as it is
+     */
+    void appendText(std::string_view text);
+
+    /**
+     * Append the column titles and the separator line
+     */
+    void appendHeader();
+
+    /**
+     * Append one player's line, formatted like Player::displayStats
+     */
+    void appendRow(std::string_view name, double rating, int gamesPlayed, int wins, int losses, int draws);
+
+    /**
+     * True when the buffer has reached the chunk size
+     * and should be written out
+     */
+    bool full() const;
+
+    /**
+     * Everything appended since the last clear or writeTo
+     */
+    std::string_view text() const;
+
+    /**
+     * Write the buffered text to a stream in one call, then empty the buffer
+     */
+    void writeTo(std::ostream& out);
+
+    /**
+     * Empty the buffer (its memory is kept for the next use)
+     */
+    void clear();
+
+};
+
+#endif
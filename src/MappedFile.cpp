@@ -0,0 +1,96 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ELO_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+/**
+ * mmap version:
+ * 1. open() the file and ask fstat() for its size
+ * 2. mmap() it read-only; the descriptor can be closed right away,
+ *    the mapping keeps the file alive
+ * 3. madvise(MADV_SEQUENTIAL) tells the kernel we read front to back,
+ *    so it reads ahead aggressively
+ *
+ * An empty file cannot be mapped, but it is still a valid (empty) file
+ */
+MappedFile::MappedFile(const std::string& path)
+{
+#ifdef ELO_HAVE_MMAP
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    struct stat info{};
+    if (::fstat(descriptor, &info) != 0)
+    {
+        ::close(descriptor);
+        return;
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0)
+    {
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED)
+        {
+            ::close(descriptor);
+            size = 0;
+            return;
+        }
+        ::madvise(address, size, MADV_SEQUENTIAL);
+
+        data = static_cast<const char*>(address);
+        mapped = true;
+    }
+
+    ::close(descriptor);
+    open = true;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return;
+    }
+
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = std::move(buffer).str();
+
+    data = contents.data();
+    size = contents.size();
+    open = true;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef ELO_HAVE_MMAP
+    if (mapped)
+    {
+        ::munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+bool MappedFile::isOpen() const
+{
+    return open;
+}
+
+std::string_view MappedFile::text() const
+{
+    return std::string_view(data, size);
+}
@@ -0,0 +1,81 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * MappedFile Class
+ *
+ * Gives read-only access to a whole file as one block of memory
+ *
+ * On Linux and macOS the file is memory-mapped (mmap):
+ * the operating system makes the file's pages appear in our address
+ * space and reads them from disk as they are touched
+ * Nothing is copied into a buffer of our own, and no read() call
+ * is needed per line or per block
+ *
+ * Elsewhere (for example Windows with MinGW) the file is read into
+ * memory in one go, which is still far cheaper than reading it line by line
+ *
+ * Usage:
+ *   MappedFile file("players.csv");
+ *   if (file.isOpen()) { parse file.text() }
+ *
+ * The text stays valid as long as the MappedFile exists
+ */
+class MappedFile
+{
+
+private:
+
+    const char* data = nullptr;
+    size_t size = 0;
+
+    /**
+     * True if data points at a mapping that has to be unmapped
+     */
+    bool mapped = false;
+
+    /**
+     * Used instead of a mapping when mmap is not available
+     */
+    std::string contents;
+
+    bool open = false;
+
+public:
+
+    /**
+     * Open and map the file; check isOpen() afterwards
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * Unmaps the file
+     */
+    ~MappedFile();
+
+    /**
+     * A mapping belongs to exactly one object, so no copies
+     */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * False if the file does not exist or could not be read
+     */
+    bool isOpen() const;
+
+    /**
+     * The whole file (empty for an empty file)
+     */
+    std::string_view text() const;
+
+};
+
+#endif
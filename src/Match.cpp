@@ -2,7 +2,10 @@
 // Version 1.0
 
 #include "Match.h"
+#include "ExpectedScoreTable.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 /**
  * Creates a new Match with references to two players and the result
@@ -79,28 +82,37 @@ double Match::calculateExpectedScore(double ratingA, double ratingB)
 }
 
 /**
- * This is the main method that runs the entire Elo calculation
- * and updates both players
+ * Picks the exact formula or the lookup table
  *
- * Steps:
- * 1. Get current ratings
- * 2. Calculate expected scores
- * 3. Determine actual scores
- * 4. Calculate new ratings
- * 5. Update players
+ * The table is built at compile time, so using it is just
+ * two array reads and a multiply-add
  */
-void Match::processMatch() const
+double Match::calculateExpectedScore(double ratingA, double ratingB, ExpectedScoreMode mode)
 {
-    /**
-     * STEP 1: Get current ratings
-     *
-     * We need both players' current ratings to calculate expected scores
-     */
-    const double rating1 = player1.getRating();
-    const double rating2 = player2.getRating();
+    if (mode == ExpectedScoreMode::LookupTable)
+    {
+        return DefaultExpectedScoreTable(ratingA, ratingB);
+    }
+
+    return calculateExpectedScore(ratingA, ratingB);
+}
 
+/**
+ * Calculates both new ratings from the old ones and the result
+ *
+ * Steps:
+ * 1. Calculate expected scores
+ * 2. Determine actual scores
+ * 3. Calculate new ratings
+ *
+ * Nothing is updated here; the caller decides where the ratings are stored
+ */
+Match::RatingUpdate Match::calculateNewRatings(const double rating1, const double rating2,
+                                               const int result, const double kFactor,
+                                               const ExpectedScoreMode mode)
+{
     /**
-     * STEP 2: Calculate expected scores
+     * STEP 1: Calculate expected scores
      *
      * What were the odds before the game started?
      *
@@ -109,17 +121,17 @@ void Match::processMatch() const
      *
      * If player1 has 0.75 expected (75% chance to win),
      * then player2 has 0.25 expected (25% chance to win)
+     *
+     * So only one std::pow is needed: expected2 is 1 - expected1
      */
-    const double expected1 = calculateExpectedScore(rating1, rating2);
-    const double expected2 = calculateExpectedScore(rating2, rating1);
+    const double expected1 = calculateExpectedScore(rating1, rating2, mode);
+    const double expected2 = 1.0 - expected1;
 
     /**
-     * STEP 3: Determine actual scores
+     * STEP 2: Determine actual scores
      *
      * What actually happened in the game?
      * Convert the result into scores (0 to 1)
-     *
-     * Also record the result in each player's statistics
      */
     double actual1, actual2;
 
@@ -132,8 +144,6 @@ void Match::processMatch() const
          */
         actual1 = 1.0;
         actual2 = 0.0;
-        player1.recordWin();
-        player2.recordLoss();
     }
     else if (result == -1)
         {
@@ -144,8 +154,6 @@ void Match::processMatch() const
          */
         actual1 = 0.0;
         actual2 = 1.0;
-        player1.recordLoss();
-        player2.recordWin();
     }
     else
         {
@@ -156,12 +164,10 @@ void Match::processMatch() const
          */
         actual1 = 0.5;
         actual2 = 0.5;
-        player1.recordDraw();
-        player2.recordDraw();
     }
 
     /**
-     * STEP 4: Calculate new ratings
+     * STEP 3: Calculate new ratings
      *
      * Apply the Elo formula to both players:
      * New Rating = Old Rating + K * (Actual - Expected)
@@ -174,15 +180,106 @@ void Match::processMatch() const
      *
      * This rewards beating favorites and punishes losses to underdogs
      */
-    const double newRating1 = rating1 + kFactor * (actual1 - expected1);
-    const double newRating2 = rating2 + kFactor * (actual2 - expected2);
+    return RatingUpdate{
+        rating1 + kFactor * (actual1 - expected1),
+        rating2 + kFactor * (actual2 - expected2)
+    };
+}
+
+/**
+ * Same update on stored ratings
+ *
+ * Fixed-point version, step by step:
+ * 1. expected1 = E * 2^30 from the integer table
+ * 2. actual1 = 1, 1/2 or 0, also times 2^30
+ * 3. change = K * (actual1 - expected1), with K in thousandths of a point,
+ *    shifted back down by 30 bits and rounded to the nearest 0.001 point
+ * 4. player1 gains the change, player2 loses exactly the same amount,
+ *    each held within what RatingValue can store
+ *
+ * 64-bit intermediates: K is at most MaxRating (about 2^31 thousandths,
+ * see RankingSystem::recordMatch), so K * 2^30 stays below 2^62
+ */
+Match::RatingValueUpdate Match::calculateNewRatingValues(const RatingValue rating1, const RatingValue rating2,
+                                                         const int result, const double kFactor,
+                                                         const ExpectedScoreMode mode)
+{
+#ifdef ELO_FIXED_POINT_RATINGS
+    (void)mode;
+
+    constexpr std::int64_t one = FixedExpectedScoreTable::One;
+
+    const std::int64_t expected1 = DefaultFixedExpectedScoreTable(std::int64_t{rating2} - rating1);
+    const std::int64_t actual1 = result == 1 ? one : (result == -1 ? 0 : one / 2);
+    const std::int64_t scaledK = toRatingValue(kFactor);
+
+    const std::int64_t change = (scaledK * (actual1 - expected1) + one / 2) >> FixedExpectedScoreTable::FractionBits;
+
+    constexpr std::int64_t lowest = std::numeric_limits<RatingValue>::min();
+    constexpr std::int64_t highest = std::numeric_limits<RatingValue>::max();
 
+    return RatingValueUpdate{
+        static_cast<RatingValue>(std::clamp(rating1 + change, lowest, highest)),
+        static_cast<RatingValue>(std::clamp(rating2 - change, lowest, highest))
+    };
+#else
+    const RatingUpdate update = calculateNewRatings(rating1, rating2, result, kFactor, mode);
+    return RatingValueUpdate{update.newRating1, update.newRating2};
+#endif
+}
+
+/**
+ * This is the main method that runs the entire Elo calculation
+ * and updates both players
+ *
+ * Steps:
+ * 1. Get current ratings
+ * 2. Calculate new ratings (see calculateNewRatings)
+ * 3. Record the result in each player's statistics
+ * 4. Update players
+ */
+void Match::processMatch() const
+{
     /**
-     * STEP 5: Update both players
+     * STEP 1: Get current ratings
+     *
+     * We need both players' current ratings to calculate expected scores
+     */
+    const RatingValue rating1 = player1.getRatingValue();
+    const RatingValue rating2 = player2.getRatingValue();
+
+    /**
+     * STEP 2: Calculate new ratings
+     *
+     * Stored form, so fixed-point builds stay in integers throughout
+     */
+    const RatingValueUpdate update = calculateNewRatingValues(rating1, rating2, result, kFactor);
+
+    /**
+     * STEP 3: Record the result in each player's statistics
+     */
+    if (result == 1)
+    {
+        player1.recordWin();
+        player2.recordLoss();
+    }
+    else if (result == -1)
+    {
+        player1.recordLoss();
+        player2.recordWin();
+    }
+    else
+    {
+        player1.recordDraw();
+        player2.recordDraw();
+    }
+
+    /**
+     * STEP 4: Update both players
      *
      * Call updateRating to set the new ratings
      * This is the only way ratings change in the system
      */
-    player1.updateRating(newRating1);
-    player2.updateRating(newRating2);
-}
\ No newline at end of file
+    player1.updateRatingValue(update.newRating1);
+    player2.updateRatingValue(update.newRating2);
+}
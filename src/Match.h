@@ -5,6 +5,39 @@
 #define MATCH_H
 
 #include "Player.h"
+#include "Rating.h"
+#include <cstdint>
+
+/**
+ * MatchResult
+ *
+ * The outcome of a match from player1's perspective
+ * The values match the integer codes used everywhere else:
+ *   1 = player1 won, 0 = draw, -1 = player2 won
+ *
+ * std::int8_t as the underlying type keeps it to a single byte
+ */
+enum class MatchResult : std::int8_t
+{
+    Player2Wins = -1,
+    Draw = 0,
+    Player1Wins = 1
+};
+
+/**
+ * ExpectedScoreMode
+ *
+ * How the expected score is calculated
+ *
+ *   Exact       - The formula with std::pow, as always
+ *   LookupTable - Interpolate in DefaultExpectedScoreTable
+ *                 (faster; differs from Exact by at most 4e-7)
+ */
+enum class ExpectedScoreMode : std::uint8_t
+{
+    Exact,
+    LookupTable
+};
 
 /**
  * Match Class
@@ -69,6 +102,13 @@ private:
      */
     double kFactor;
 
+public:
+
+    /**
+     * The K-factor used when none is given
+     */
+    static constexpr double DefaultKFactor = 32.0;
+
     /**
      * It uses the Elo formula:
      * Expected = 1 / (1 + 10^((opponent_rating - player_rating) / 400))
@@ -79,19 +119,77 @@ private:
      *
      * Returns: Expected score between 0 and 1
      *
-     * Why private?
-     * - This is an implementation detail
-     * - Only the Match class needs to call this
-     * - External code doesn't need to know about it
+     * Why public?
+     * - It is the reference formula for the faster batch versions
+     *   in EloKernel, and tests compare them against it
      *
      * Example calculations:
      * If A = 1200, B = 1200: Expected = 0.5 (even match)
      * If A = 1600, B = 1200: Expected = 0.91 (strong favorite)
      * If A = 1200, B = 1600: Expected = 0.09 (huge underdog)
      */
-    static double calculateExpectedScore(double ratingA, double ratingB) ;
+    static double calculateExpectedScore(double ratingA, double ratingB);
 
-public:
+    /**
+     * Same as above, but lets the caller choose the calculation
+     *
+     * ExpectedScoreMode::LookupTable skips std::pow and reads
+     * the precomputed table instead
+     */
+    static double calculateExpectedScore(double ratingA, double ratingB, ExpectedScoreMode mode);
+
+    /**
+     * Both players' ratings after a match
+     */
+    struct RatingUpdate
+    {
+        double newRating1;
+        double newRating2;
+    };
+
+    /**
+     * Calculate both players' new ratings without touching any Player
+     *
+     * Parameters:
+     *   rating1 - player1's rating before the match
+     *   rating2 - player2's rating before the match
+     *   result - 1 (player1 won), 0 (draw), -1 (player2 won)
+     *   kFactor - How much ratings should change
+     *   mode - How to calculate the expected score (exact by default)
+     *
+     * This is the pure Elo math used by processMatch
+     * RankingSystem also calls it directly on its rating column,
+     * so recording a match by id does not need to build a Match object
+     */
+    static RatingUpdate calculateNewRatings(double rating1, double rating2, int result, double kFactor,
+                                            ExpectedScoreMode mode = ExpectedScoreMode::Exact);
+
+    /**
+     * Both players' ratings after a match, in stored form (see Rating.h)
+     */
+    struct RatingValueUpdate
+    {
+        RatingValue newRating1;
+        RatingValue newRating2;
+    };
+
+    /**
+     * calculateNewRatings for ratings in their stored form
+     *
+     * In the default build this simply calls calculateNewRatings
+     *
+     * With ELO_FIXED_POINT_RATINGS the whole update is integer math:
+     * the expected score comes from DefaultFixedExpectedScoreTable,
+     * and the change is rounded to 0.001 points once, then added to one
+     * player and subtracted from the other - so ratings are exactly
+     * zero-sum and identical on every machine
+     * The mode parameter is ignored in that build (there is only one way)
+     *
+     * This is what processMatch and RankingSystem use
+     */
+    static RatingValueUpdate calculateNewRatingValues(RatingValue rating1, RatingValue rating2, int result,
+                                                      double kFactor,
+                                                      ExpectedScoreMode mode = ExpectedScoreMode::Exact);
 
     /**
      * Parameters:
@@ -112,7 +210,7 @@ public:
      *   Match m{alice, bob, 1, 32.0};  alice won, K=32
      *   Match m2{charlie, david, -1};   david won, K=default 32
      */
-    Match(Player& p1, Player& p2, int result, double kFactor = 32.0);
+    Match(Player& p1, Player& p2, int result, double kFactor = DefaultKFactor);
 
     /**
      * It does these steps:
@@ -0,0 +1,218 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "MatchHistory.h"
+#include "Rating.h"
+#include "Varint.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * Points <-> thousandths of a point
+     */
+    std::int64_t toMilli(double points)
+    {
+        return std::llround(points * RatingScale);
+    }
+
+    double fromMilli(std::int64_t milli)
+    {
+        return static_cast<double>(milli) / RatingScale;
+    }
+}
+
+/**
+ * Steps:
+ * 1. Start a new chunk if the open one is full
+ * 2. Append each value to its column
+ */
+void MatchHistory::append(const MatchHistoryEntry& match)
+{
+    /**
+     * Step 1: Seal a full chunk
+     */
+    if (openCount == ChunkMatches)
+    {
+        sealChunk();
+    }
+    if (openCount == 0)
+    {
+        openFirstTimestamp = match.timestamp;
+        openLastTimestamp = match.timestamp;
+        previousTimestamp = 0;
+        previousRating1 = 0;
+    }
+
+    /**
+     * Step 2: Encode the columns
+     *
+     * The changes are taken between the rounded ratings, so that
+     * rating + change gives the rounded rating after the match
+     */
+    const std::int64_t rating1 = toMilli(match.rating1);
+    const std::int64_t rating2 = toMilli(match.rating2);
+    const std::int64_t change1 = toMilli(match.rating1 + match.change1) - rating1;
+    const std::int64_t change2 = toMilli(match.rating2 + match.change2) - rating2;
+
+    Varint::append(open[Player1], match.player1);
+    Varint::append(open[Player2], match.player2);
+
+    const unsigned shift = (openCount % 4) * 2;
+    if (shift == 0)
+    {
+        open[Results].push_back(0);
+    }
+    open[Results].back() |= static_cast<std::uint8_t>((static_cast<int>(match.result) + 1) << shift);
+
+    Varint::appendSigned(open[Timestamps], match.timestamp - previousTimestamp);
+    Varint::appendSigned(open[Ratings1], rating1 - previousRating1);
+    Varint::appendSigned(open[Ratings2], rating2 - rating1);
+    Varint::appendSigned(open[Changes1], change1);
+    Varint::appendSigned(open[Changes2], change1 + change2);
+
+    previousTimestamp = match.timestamp;
+    previousRating1 = rating1;
+
+    openFirstTimestamp = std::min(openFirstTimestamp, match.timestamp);
+    openLastTimestamp = std::max(openLastTimestamp, match.timestamp);
+    openCount++;
+}
+
+/**
+ * The open buffers are cleared, not freed: the next chunk
+ * fills them again without reallocating
+ */
+void MatchHistory::sealChunk()
+{
+    Chunk chunk;
+    chunk.count = openCount;
+    chunk.firstTimestamp = openFirstTimestamp;
+    chunk.lastTimestamp = openLastTimestamp;
+
+    size_t total = 0;
+    for (size_t c = 0; c < ColumnCount; c++)
+    {
+        chunk.offsets[c] = static_cast<std::uint32_t>(total);
+        total += open[c].size();
+    }
+    chunk.offsets[ColumnCount] = static_cast<std::uint32_t>(total);
+
+    chunk.bytes.reserve(total);
+    for (std::vector<std::uint8_t>& column : open)
+    {
+        chunk.bytes.insert(chunk.bytes.end(), column.begin(), column.end());
+        column.clear();
+    }
+
+    chunks.push_back(std::move(chunk));
+    openCount = 0;
+}
+
+MatchHistory::Columns MatchHistory::columnsOf(size_t i) const
+{
+    Columns columns;
+    for (size_t c = 0; c < ColumnCount; c++)
+    {
+        if (i == chunks.size())
+        {
+            columns[c] = open[c];
+        }
+        else
+        {
+            const Chunk& chunk = chunks[i];
+            columns[c] = std::span<const std::uint8_t>(chunk.bytes).subspan(
+                chunk.offsets[c], chunk.offsets[c + 1] - chunk.offsets[c]);
+        }
+    }
+    return columns;
+}
+
+/**
+ * One pass per column: each loop reads a single byte stream
+ * front to back and writes one field of the entries
+ */
+void MatchHistory::decode(const Columns& columns, size_t count, std::vector<MatchHistoryEntry>& out)
+{
+    out.resize(count);
+
+    const std::uint8_t* in = columns[Player1].data();
+    for (MatchHistoryEntry& match : out)
+    {
+        match.player1 = static_cast<PlayerId>(Varint::read(in));
+    }
+
+    in = columns[Player2].data();
+    for (MatchHistoryEntry& match : out)
+    {
+        match.player2 = static_cast<PlayerId>(Varint::read(in));
+    }
+
+    in = columns[Results].data();
+    for (size_t i = 0; i < count; i++)
+    {
+        const int code = (in[i / 4] >> ((i % 4) * 2)) & 3;
+        out[i].result = static_cast<MatchResult>(code - 1);
+    }
+
+    std::int64_t timestamp = 0;
+    in = columns[Timestamps].data();
+    for (MatchHistoryEntry& match : out)
+    {
+        timestamp += Varint::readSigned(in);
+        match.timestamp = timestamp;
+    }
+
+    std::int64_t rating1 = 0;
+    const std::uint8_t* ratings1 = columns[Ratings1].data();
+    const std::uint8_t* ratings2 = columns[Ratings2].data();
+    const std::uint8_t* changes1 = columns[Changes1].data();
+    const std::uint8_t* changes2 = columns[Changes2].data();
+    for (MatchHistoryEntry& match : out)
+    {
+        rating1 += Varint::readSigned(ratings1);
+        const std::int64_t rating2 = rating1 + Varint::readSigned(ratings2);
+        const std::int64_t change1 = Varint::readSigned(changes1);
+        const std::int64_t change2 = Varint::readSigned(changes2) - change1;
+
+        match.rating1 = fromMilli(rating1);
+        match.rating2 = fromMilli(rating2);
+        match.change1 = fromMilli(change1);
+        match.change2 = fromMilli(change2);
+    }
+}
+
+size_t MatchHistory::size() const
+{
+    return chunks.size() * ChunkMatches + openCount;
+}
+
+size_t MatchHistory::chunkCount() const
+{
+    return chunks.size() + (openCount > 0 ? 1 : 0);
+}
+
+size_t MatchHistory::memoryBytes() const
+{
+    size_t bytes = sizeof(*this) + chunks.capacity() * sizeof(Chunk);
+    for (const Chunk& chunk : chunks)
+    {
+        bytes += chunk.bytes.capacity();
+    }
+    for (const std::vector<std::uint8_t>& column : open)
+    {
+        bytes += column.capacity();
+    }
+    return bytes;
+}
+
+void MatchHistory::clear()
+{
+    chunks = std::vector<Chunk>();
+    for (std::vector<std::uint8_t>& column : open)
+    {
+        column = std::vector<std::uint8_t>();
+    }
+    openCount = 0;
+}
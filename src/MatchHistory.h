@@ -0,0 +1,240 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef MATCHHISTORY_H
+#define MATCHHISTORY_H
+
+#include "Match.h"
+#include "PlayerTable.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * MatchHistoryEntry
+ *
+ * One match as the history gives it back
+ *
+ *   timestamp - When it was recorded, in milliseconds since 1970 (UTC)
+ *   rating1, rating2 - Both ratings before the match
+ *   change1, change2 - What the match added to them
+ *
+ * Ratings are kept to 0.001 points, the fixed-point resolution
+ * (see Rating.h); rating + change is the rating after the match
+ */
+struct MatchHistoryEntry
+{
+    std::int64_t timestamp = 0;
+    PlayerId player1 = InvalidPlayerId;
+    PlayerId player2 = InvalidPlayerId;
+    MatchResult result = MatchResult::Draw;
+    double rating1 = 0.0;
+    double rating2 = 0.0;
+    double change1 = 0.0;
+    double change2 = 0.0;
+};
+
+/**
+ * MatchHistory Class
+ *
+ * Every match recorded, kept compactly in memory
+ *
+ * A vector of MatchHistoryEntry would cost 56 bytes per match; at
+ * millions of matches a day that adds up fast. Instead the matches are
+ * stored column by column (ids, results, timestamps, ratings, changes)
+ * in append-only chunks of ChunkMatches matches, and each column is
+ * encoded for what its values look like:
+ *
+ *   player1, player2  varint (small ids take fewer bytes)
+ *   result            2 bits, 4 matches per byte
+ *   timestamp         zigzag varint of the gap to the previous match:
+ *                     matches arrive close together, so usually 1 byte
+ *   rating1           zigzag varint of the step from the previous rating1
+ *   rating2           zigzag varint of the difference to rating1:
+ *                     matchmaking pairs players of similar rating
+ *   change1           zigzag varint
+ *   change2           zigzag varint of change1 + change2: Elo gives
+ *                     one player what the other loses, so almost
+ *                     always 0 or a rounding step, 1 byte
+ *
+ * Ratings and changes are encoded in thousandths of a point
+ * (see Varint.h for varints and zigzag)
+ *
+ * The newest chunk is filled column by column; once full, its columns
+ * are packed into one exactly sized buffer and never change again
+ * Deltas restart at every chunk, so chunks decode independently
+ *
+ * Reading is a sequential scan: forEach decodes a chunk at a time
+ * into a small reused buffer and hands the matches to a callback
+ * forEachBetween skips whole chunks outside a time range
+ *
+ * Usage:
+ *   MatchHistory history;
+ *   history.append(entry);
+ *   history.forEach([](const MatchHistoryEntry& match) { ... });
+ */
+class MatchHistory
+{
+
+public:
+
+    /**
+     * Matches per chunk
+     *
+     * Big enough that the per-chunk overhead and the values that
+     * restart every chunk do not matter, small enough that decoding
+     * a chunk stays in the L1/L2 cache
+     */
+    static constexpr size_t ChunkMatches = 4096;
+
+private:
+
+    enum Column : size_t
+    {
+        Player1,
+        Player2,
+        Results,
+        Timestamps,
+        Ratings1,
+        Ratings2,
+        Changes1,
+        Changes2,
+        ColumnCount
+    };
+
+    using Columns = std::array<std::span<const std::uint8_t>, ColumnCount>;
+
+    /**
+     * A full chunk: every column back to back in one buffer
+     * Column c is bytes[offsets[c]] .. bytes[offsets[c + 1]]
+     */
+    struct Chunk
+    {
+        std::uint32_t count = 0;
+        std::int64_t firstTimestamp = 0;
+        std::int64_t lastTimestamp = 0;
+        std::array<std::uint32_t, ColumnCount + 1> offsets{};
+        std::vector<std::uint8_t> bytes;
+    };
+
+    std::vector<Chunk> chunks;
+
+    /**
+     * The chunk being filled, one buffer per column
+     * The buffers keep their capacity for the next chunk
+     */
+    std::array<std::vector<std::uint8_t>, ColumnCount> open;
+    std::uint32_t openCount = 0;
+    std::int64_t openFirstTimestamp = 0;
+    std::int64_t openLastTimestamp = 0;
+
+    /**
+     * Previous values in the open chunk, the bases for the deltas
+     */
+    std::int64_t previousTimestamp = 0;
+    std::int64_t previousRating1 = 0;
+
+    /**
+     * Pack the open chunk and start a new one
+     */
+    void sealChunk();
+
+    /**
+     * The columns of chunk i; i == chunks.size() is the open one
+     */
+    Columns columnsOf(size_t i) const;
+
+    /**
+     * Decode count matches from a chunk's columns
+     */
+    static void decode(const Columns& columns, size_t count, std::vector<MatchHistoryEntry>& out);
+
+    /**
+     * Shared by forEach and forEachBetween: decode each chunk whose
+     * time range overlaps [from, to] and pass its matches to visit
+     */
+    template <typename Visitor>
+    void scan(std::int64_t from, std::int64_t to, bool filter, Visitor&& visit) const
+    {
+        std::vector<MatchHistoryEntry> buffer;
+        buffer.reserve(ChunkMatches);
+
+        for (size_t i = 0; i <= chunks.size(); i++)
+        {
+            const bool isOpen = i == chunks.size();
+            const size_t count = isOpen ? openCount : chunks[i].count;
+            const std::int64_t first = isOpen ? openFirstTimestamp : chunks[i].firstTimestamp;
+            const std::int64_t last = isOpen ? openLastTimestamp : chunks[i].lastTimestamp;
+            if (count == 0 || (filter && (last < from || first > to)))
+            {
+                continue;
+            }
+
+            decode(columnsOf(i), count, buffer);
+            for (const MatchHistoryEntry& match : buffer)
+            {
+                if (!filter || (match.timestamp >= from && match.timestamp <= to))
+                {
+                    visit(match);
+                }
+            }
+        }
+    }
+
+public:
+
+    /**
+     * Add a match at the end
+     *
+     * Timestamps are expected to grow (they come from the clock as
+     * matches are recorded); one that goes back still works, it only
+     * costs a few more bytes and loosens forEachBetween's chunk skipping
+     */
+    void append(const MatchHistoryEntry& match);
+
+    /**
+     * Call visit(const MatchHistoryEntry&) for every match, oldest first
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const
+    {
+        scan(0, 0, false, visit);
+    }
+
+    /**
+     * Call visit for every match recorded from "from" to "to" (both included,
+     * milliseconds since 1970), oldest first
+     *
+     * Chunks entirely outside the range are not decoded
+     */
+    template <typename Visitor>
+    void forEachBetween(std::int64_t from, std::int64_t to, Visitor&& visit) const
+    {
+        scan(from, to, true, visit);
+    }
+
+    /**
+     * Number of matches stored
+     */
+    size_t size() const;
+
+    /**
+     * Number of chunks, the one being filled included
+     */
+    size_t chunkCount() const;
+
+    /**
+     * Bytes of memory the history uses, allocated capacity included
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * Forget every match and free the memory
+     */
+    void clear();
+
+};
+
+#endif
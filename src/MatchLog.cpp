@@ -0,0 +1,486 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "MatchLog.h"
+#include "Crc32.h"
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ELO_HAVE_FSYNC 1
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * The on-disk layouts
+     *
+     * Every record starts with the same 8 bytes:
+     * the CRC-32 of everything after the CRC, then the type
+     */
+    struct LogHeader
+    {
+        char magic[8]{};
+        std::uint32_t version = 0;
+        std::uint32_t byteOrder = 0;
+        std::uint64_t firstSequence = 0;
+    };
+
+    struct LoggedMatch
+    {
+        std::uint32_t crc = 0;
+        std::uint8_t type = 0;
+        std::int8_t result = 0;
+        std::uint16_t reserved = 0;
+        std::uint32_t player1 = 0;
+        std::uint32_t player2 = 0;
+        double rating1 = 0.0;
+        double rating2 = 0.0;
+    };
+
+    /**
+     * Followed by nameSize bytes of name
+     */
+    struct LoggedPlayer
+    {
+        std::uint32_t crc = 0;
+        std::uint8_t type = 0;
+        std::uint8_t reserved = 0;
+        std::uint16_t reserved2 = 0;
+        std::uint32_t player = 0;
+        std::uint32_t nameSize = 0;
+        std::int32_t gamesPlayed = 0;
+        std::int32_t wins = 0;
+        std::int32_t losses = 0;
+        std::int32_t draws = 0;
+        double rating = 0.0;
+    };
+
+    static_assert(sizeof(LogHeader) == MatchLog::HeaderSize, "the header layout is part of the file format");
+    static_assert(sizeof(LoggedMatch) == MatchLog::MatchRecordSize, "the record layout is part of the file format");
+    static_assert(sizeof(LoggedPlayer) == MatchLog::PlayerRecordSize, "the record layout is part of the file format");
+
+    constexpr char Magic[8] = {'E', 'L', 'O', 'W', 'A', 'L', '\0', '\0'};
+
+    /**
+     * Same idea as PlayerSnapshot::ByteOrderMark
+     */
+    constexpr std::uint32_t ByteOrderMark = 0x01020304u;
+
+    /**
+     * A record's CRC covers everything after the CRC field
+     */
+    std::uint32_t recordCrc(std::string_view record)
+    {
+        return Crc32::compute(record.substr(sizeof(std::uint32_t)));
+    }
+
+    template <typename T>
+    T readAt(std::string_view text, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, text.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::string headerBytes(std::uint64_t firstSequence)
+    {
+        LogHeader header;
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = MatchLog::Version;
+        header.byteOrder = ByteOrderMark;
+        header.firstSequence = firstSequence;
+        return std::string(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+/**
+ * Two cases:
+ * - keepBytes too small to hold a header: start a new log,
+ *   replacing whatever was there, and sync the header
+ * - otherwise keep the first keepBytes bytes (cutting off a torn
+ *   tail) and append after them
+ */
+MatchLog::MatchLog(const std::string& path, std::uint64_t keepBytes, std::uint64_t firstSequence,
+                   MatchLogOptions options)
+    : path(path),
+      options(options)
+{
+    const bool fresh = keepBytes < HeaderSize;
+
+#ifdef ELO_HAVE_FSYNC
+    const int flags = O_WRONLY | O_APPEND | O_CLOEXEC | (fresh ? O_CREAT | O_TRUNC : 0);
+    descriptor = ::open(path.c_str(), flags, 0644);
+    if (descriptor < 0)
+    {
+        return;
+    }
+    if (!fresh && ::ftruncate(descriptor, static_cast<off_t>(keepBytes)) != 0)
+    {
+        return;
+    }
+#else
+    std::error_code error;
+    if (!fresh)
+    {
+        std::filesystem::resize_file(path, keepBytes, error);
+        if (error)
+        {
+            return;
+        }
+    }
+    stream.open(path, std::ios::binary | (fresh ? std::ios::trunc : std::ios::app));
+    if (!stream)
+    {
+        return;
+    }
+#endif
+
+    open = true;
+    buffer.reserve(options.syncEveryRecords * MatchRecordSize);
+
+    if (fresh)
+    {
+        buffer = headerBytes(firstSequence);
+    }
+    if (!commitGroup())
+    {
+        open = false;
+        return;
+    }
+
+    if (options.syncInterval.count() > 0)
+    {
+        flusher = std::thread(&MatchLog::runFlusher, this);
+    }
+}
+
+MatchLog::~MatchLog()
+{
+    if (flusher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        flusher.join();
+    }
+
+    sync();
+
+#ifdef ELO_HAVE_FSYNC
+    if (descriptor >= 0)
+    {
+        ::close(descriptor);
+    }
+#endif
+}
+
+bool MatchLog::isOpen() const
+{
+    return open;
+}
+
+bool MatchLog::isHealthy() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return open && !failed;
+}
+
+/**
+ * Sleeps until the current group's deadline (or, with nothing waiting,
+ * until append starts a group), then commits what is still waiting
+ * A group committed early, because it filled up or by sync(), is
+ * simply gone when the flusher wakes
+ */
+void MatchLog::runFlusher()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping)
+    {
+        if (pendingRecords == 0 || failed)
+        {
+            wake.wait(lock);
+            continue;
+        }
+
+        const auto deadline = oldestPending + options.syncInterval;
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            commitGroup();
+            continue;
+        }
+        wake.wait_until(lock, deadline);
+    }
+}
+
+void MatchLog::logPlayer(PlayerId id, std::string_view name, double rating, const PlayerStats& stats)
+{
+    LoggedPlayer record;
+    record.type = static_cast<std::uint8_t>(MatchLogEntry::Type::PlayerAdded);
+    record.player = id;
+    record.nameSize = static_cast<std::uint32_t>(name.size());
+    record.gamesPlayed = stats.gamesPlayed;
+    record.wins = stats.wins;
+    record.losses = stats.losses;
+    record.draws = stats.draws;
+    record.rating = rating;
+
+    /**
+     * A player record has a variable size, so it is put together
+     * in a small string first; the CRC goes in last
+     */
+    std::string bytes(reinterpret_cast<const char*>(&record), sizeof(record));
+    bytes.append(name);
+
+    const std::uint32_t crc = recordCrc(bytes);
+    std::memcpy(bytes.data(), &crc, sizeof(crc));
+
+    append(bytes);
+}
+
+void MatchLog::logMatch(PlayerId id1, PlayerId id2, MatchResult result, double newRating1, double newRating2)
+{
+    LoggedMatch record;
+    record.type = static_cast<std::uint8_t>(MatchLogEntry::Type::MatchRecorded);
+    record.result = static_cast<std::int8_t>(result);
+    record.player1 = id1;
+    record.player2 = id2;
+    record.rating1 = newRating1;
+    record.rating2 = newRating2;
+
+    const std::string_view bytes(reinterpret_cast<const char*>(&record), sizeof(record));
+    record.crc = recordCrc(bytes);
+
+    append(bytes);
+}
+
+/**
+ * The clock is only read for the first record of a group;
+ * the flusher takes care of the interval from there
+ */
+void MatchLog::append(std::string_view record)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!open || failed)
+    {
+        return;
+    }
+
+    if (pendingRecords == 0)
+    {
+        oldestPending = std::chrono::steady_clock::now();
+        wake.notify_one();
+    }
+
+    buffer.append(record);
+    pendingRecords++;
+
+    if (pendingRecords >= options.syncEveryRecords || options.syncInterval.count() == 0)
+    {
+        commitGroup();
+    }
+}
+
+bool MatchLog::sync()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!open || failed)
+    {
+        return false;
+    }
+    if (buffer.empty())
+    {
+        return true;
+    }
+
+    return commitGroup();
+}
+
+/**
+ * One write() for the whole group, then one fsync()
+ * After a failure the file may end in a partial group; read() ignores
+ * it (the torn record fails its CRC), but nothing more is appended
+ */
+bool MatchLog::commitGroup()
+{
+    std::string_view data = buffer;
+
+#ifdef ELO_HAVE_FSYNC
+    while (!data.empty())
+    {
+        const ssize_t written = ::write(descriptor, data.data(), data.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            failed = true;
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    if (::fsync(descriptor) != 0)
+    {
+        failed = true;
+        return false;
+    }
+#else
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    stream.flush();
+    if (!stream)
+    {
+        failed = true;
+        return false;
+    }
+#endif
+
+    buffer.clear();
+    pendingRecords = 0;
+    return true;
+}
+
+/**
+ * Waiting records are dropped too: they are part of the
+ * state that was just saved elsewhere
+ * The file is emptied and gets a new header with the new sequence
+ */
+bool MatchLog::clear(std::uint64_t firstSequence)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!open || failed)
+    {
+        return false;
+    }
+
+    pendingRecords = 0;
+
+#ifdef ELO_HAVE_FSYNC
+    if (::ftruncate(descriptor, 0) != 0)
+    {
+        failed = true;
+        return false;
+    }
+#else
+    stream.close();
+    stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        failed = true;
+        return false;
+    }
+#endif
+
+    buffer = headerBytes(firstSequence);
+    return commitGroup();
+}
+
+/**
+ * Steps:
+ * 1. The header must be ours
+ * 2. Each record: enough bytes for its fixed part (and its name),
+ *    a known type and a matching CRC; otherwise the log ends here
+ * 3. Hand the record to visit
+ */
+std::expected<MatchLogExtent, RankingError> MatchLog::read(
+    std::string_view text, const std::function<bool(const MatchLogEntry&)>& visit)
+{
+    if (text.empty())
+    {
+        return MatchLogExtent{};
+    }
+
+    /**
+     * Step 1: The header
+     */
+    if (text.size() < HeaderSize)
+    {
+        return std::unexpected(RankingError::InvalidMatchLog);
+    }
+    const LogHeader header = readAt<LogHeader>(text, 0);
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+        header.byteOrder != ByteOrderMark)
+    {
+        return std::unexpected(RankingError::InvalidMatchLog);
+    }
+
+    size_t position = HeaderSize;
+    MatchLogEntry entry;
+    entry.sequence = header.firstSequence;
+
+    while (true)
+    {
+        /**
+         * Step 2: One record
+         */
+        const size_t remaining = text.size() - position;
+        if (remaining < MatchRecordSize)
+        {
+            break;
+        }
+
+        const auto type = static_cast<MatchLogEntry::Type>(readAt<std::uint8_t>(text, position + 4));
+        size_t size = 0;
+
+        if (type == MatchLogEntry::Type::MatchRecorded)
+        {
+            const LoggedMatch record = readAt<LoggedMatch>(text, position);
+            size = MatchRecordSize;
+
+            entry.type = type;
+            entry.player1 = record.player1;
+            entry.player2 = record.player2;
+            entry.result = static_cast<MatchResult>(record.result);
+            entry.rating1 = record.rating1;
+            entry.rating2 = record.rating2;
+            entry.name = {};
+            entry.stats = PlayerStats{};
+        }
+        else if (type == MatchLogEntry::Type::PlayerAdded && remaining >= PlayerRecordSize)
+        {
+            const LoggedPlayer record = readAt<LoggedPlayer>(text, position);
+            if (record.nameSize > remaining - PlayerRecordSize)
+            {
+                break;
+            }
+            size = PlayerRecordSize + record.nameSize;
+
+            entry.type = type;
+            entry.player1 = record.player;
+            entry.player2 = InvalidPlayerId;
+            entry.result = MatchResult::Draw;
+            entry.rating1 = record.rating;
+            entry.rating2 = 0.0;
+            entry.name = text.substr(position + PlayerRecordSize, record.nameSize);
+            entry.stats = PlayerStats{record.gamesPlayed, record.wins, record.losses, record.draws};
+        }
+        else
+        {
+            break;
+        }
+
+        const std::string_view bytes = text.substr(position, size);
+        if (readAt<std::uint32_t>(bytes, 0) != recordCrc(bytes))
+        {
+            break;
+        }
+
+        /**
+         * Step 3: Apply it
+         */
+        if (!visit(entry))
+        {
+            return std::unexpected(RankingError::InvalidMatchLog);
+        }
+        position += size;
+        entry.sequence++;
+    }
+
+    return MatchLogExtent{position, header.firstSequence, entry.sequence};
+}
@@ -0,0 +1,289 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef MATCHLOG_H
+#define MATCHLOG_H
+
+#include "Match.h"
+#include "PlayerTable.h"
+#include "RankingError.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#include <fstream>
+#endif
+
+/**
+ * MatchLogOptions
+ *
+ * When the match log forces its records onto the disk ("group commit")
+ *
+ * An fsync takes far longer than recording a match, so doing one per
+ * match would cap throughput at a few hundred or thousand matches a
+ * second. Instead the records are collected and one write + fsync
+ * makes a whole group durable, as soon as either limit is reached:
+ *   syncEveryRecords - this many records are waiting (1 = every record)
+ *   syncInterval - the oldest waiting record is this old
+ *
+ * The interval is kept by a background thread: it wakes up when the
+ * oldest waiting record reaches syncInterval and commits the group,
+ * so the last records before a quiet period are not left waiting
+ * for the next one. An interval of 0 commits every record at once
+ */
+struct MatchLogOptions
+{
+    size_t syncEveryRecords = 256;
+    std::chrono::milliseconds syncInterval{10};
+};
+
+/**
+ * MatchLogEntry
+ *
+ * One record read back from a match log
+ *
+ * PlayerAdded:   player, name, rating, stats
+ * MatchRecorded: player1, player2, result, and both ratings after the match
+ *
+ * name points into the log's text, so it is only valid while that text exists
+ */
+struct MatchLogEntry
+{
+    enum class Type : std::uint8_t
+    {
+        PlayerAdded = 1,
+        MatchRecorded = 2
+    };
+
+    Type type = Type::MatchRecorded;
+
+    /**
+     * Position of the change in the system's history
+     * (see RankingSystem::getChangeSequence)
+     */
+    std::uint64_t sequence = 0;
+
+    PlayerId player1 = InvalidPlayerId;
+    PlayerId player2 = InvalidPlayerId;
+    MatchResult result = MatchResult::Draw;
+    double rating1 = 0.0;
+    double rating2 = 0.0;
+    std::string_view name;
+    PlayerStats stats;
+};
+
+/**
+ * MatchLogExtent
+ *
+ * What MatchLog::read found
+ *
+ *   size - Bytes up to the end of the last good record; pass it to the
+ *          MatchLog constructor as keepBytes (0 for an empty file)
+ *   firstSequence - Sequence of the log's first record
+ *   nextSequence - Sequence the next appended record gets
+ *                  (firstSequence when there are no records yet)
+ */
+struct MatchLogExtent
+{
+    std::uint64_t size = 0;
+    std::uint64_t firstSequence = 0;
+    std::uint64_t nextSequence = 0;
+};
+
+/**
+ * MatchLog Class
+ *
+ * An append-only write-ahead log of every change to a RankingSystem
+ *
+ * Without it nothing is on disk until the next save, and a crash loses
+ * every match since. With a log attached (RankingSystem::openMatchLog),
+ * every new player and every match is appended here as a small binary
+ * record; after a crash, the last save plus the log gives back
+ * everything up to the last synced group
+ *
+ * Layout of the file:
+ *   header   24 bytes: "ELOWAL" magic, version, byte-order mark and the
+ *            sequence of the first record
+ *   records  back to back, each starting with the CRC-32 of the rest
+ *            of the record and its type
+ *
+ * Records are numbered implicitly: the first has the header's sequence,
+ * every following one the next number, which lets a reader skip what
+ * a snapshot already contains (see CheckpointManager)
+ *     match  32 bytes: both ids, the result and both new ratings
+ *     player 40 bytes plus the name: id, counters, rating
+ *
+ * A match stores the ratings it produced, not just the result:
+ * replaying it sets them directly, so recovery gives back the exact
+ * same ratings whatever K-factor or expected-score mode was used
+ *
+ * A crash can leave the last record half written; read() stops at
+ * the first record that is cut short or fails its CRC, and the
+ * writer cuts that tail off before appending again
+ *
+ * On Linux and macOS records are written with write() and made durable
+ * with fsync(); elsewhere std::ofstream is used and flushed, which
+ * survives the program crashing but not the machine
+ */
+class MatchLog
+{
+
+private:
+
+    std::string path;
+    MatchLogOptions options;
+
+#if defined(__unix__) || defined(__APPLE__)
+    int descriptor = -1;
+#else
+    std::ofstream stream;
+#endif
+
+    /**
+     * Records waiting for the next group commit
+     */
+    std::string buffer;
+    size_t pendingRecords = 0;
+    std::chrono::steady_clock::time_point oldestPending;
+
+    bool open = false;
+    bool failed = false;
+
+    /**
+     * The flusher thread commits a group once syncInterval has passed
+     * since its first record; everything above is guarded by mutex,
+     * and wake tells the flusher a new group started or it must stop
+     */
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::thread flusher;
+    bool stopping = false;
+
+    void runFlusher();
+
+    /**
+     * Add one finished record to the buffer and commit
+     * the group if a limit is reached
+     */
+    void append(std::string_view record);
+
+    /**
+     * Write the buffer to the file in one piece and fsync it
+     * Called with mutex held
+     */
+    bool commitGroup();
+
+public:
+
+    /**
+     * Size of the file header
+     */
+    static constexpr size_t HeaderSize = 24;
+
+    /**
+     * Size of a match record, and of a player record without its name
+     */
+    static constexpr size_t MatchRecordSize = 32;
+    static constexpr size_t PlayerRecordSize = 40;
+
+    /**
+     * Format version written by this code; read() only accepts this one
+     */
+    static constexpr std::uint32_t Version = 1;
+
+    /**
+     * Open a log for appending
+     *
+     * Parameters:
+     *   path - The log file
+     *   keepBytes - How much of an existing file to keep, normally the
+     *               size read() returned; anything after it (a torn
+     *               last record) is cut off. 0 starts a new, empty log
+     *   firstSequence - For a new log: the sequence of its first record
+     *   options - When to sync (see MatchLogOptions)
+     *
+     * Check isOpen() afterwards
+     */
+    MatchLog(const std::string& path, std::uint64_t keepBytes, std::uint64_t firstSequence = 1,
+             MatchLogOptions options = {});
+
+    /**
+     * Writes and syncs the records still waiting, then closes the file
+     */
+    ~MatchLog();
+
+    /**
+     * The file belongs to exactly one object, so no copies
+     */
+    MatchLog(const MatchLog&) = delete;
+    MatchLog& operator=(const MatchLog&) = delete;
+
+    /**
+     * False if the file could not be opened or prepared
+     */
+    bool isOpen() const;
+
+    /**
+     * False once a write or sync has failed; records added after
+     * that are dropped, since the file may no longer be readable
+     * past the failure
+     */
+    bool isHealthy() const;
+
+    /**
+     * Append a record
+     *
+     * The ratings are in points (see fromRatingValue)
+     * Nothing is written immediately unless the group is full;
+     * otherwise the flusher commits it within syncInterval
+     */
+    void logPlayer(PlayerId id, std::string_view name, double rating, const PlayerStats& stats);
+    void logMatch(PlayerId id1, PlayerId id2, MatchResult result, double newRating1, double newRating2);
+
+    /**
+     * Write and fsync every waiting record now
+     *
+     * Returns: false if the log has failed (see isHealthy)
+     */
+    bool sync();
+
+    /**
+     * Throw away every record; the next one gets firstSequence
+     *
+     * Call it once the state the records lead to has been saved
+     * somewhere else (for example right after saveToFile)
+     *
+     * Returns: false if the file could not be rewritten
+     */
+    bool clear(std::uint64_t firstSequence);
+
+    /**
+     * Read a log
+     *
+     * Parameters:
+     *   text - The whole file (usually a MappedFile's text)
+     *   visit - Called for every complete, intact record in order;
+     *           returning false stops the read with InvalidMatchLog
+     *
+     * Returns: Where the good part of the log ends (see MatchLogExtent;
+     *          all zero for an empty file), or InvalidMatchLog if the
+     *          header is not a match log this version can read,
+     *          or visit refused a record
+     *
+     * A damaged or torn record ends the log: it and everything after it
+     * are ignored, since nothing after a crash can be trusted
+     */
+    static std::expected<MatchLogExtent, RankingError> read(
+        std::string_view text, const std::function<bool(const MatchLogEntry&)>& visit);
+
+};
+
+#endif
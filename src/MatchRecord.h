@@ -0,0 +1,82 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef MATCHRECORD_H
+#define MATCHRECORD_H
+
+#include "Match.h"
+#include "PlayerTable.h"
+#include <cstdint>
+
+/**
+ * MatchStatus
+ *
+ * What happened when a match was submitted
+ * One byte, so a status per match in a large batch stays cheap
+ */
+enum class MatchStatus : std::uint8_t
+{
+    /**
+     * Ratings and counters were updated
+     */
+    Recorded,
+
+    /**
+     * One of the ids does not belong to a player
+     */
+    UnknownPlayer,
+
+    /**
+     * Both ids are the same player
+     */
+    SamePlayer,
+
+    /**
+     * The result is not 1, 0 or -1
+     */
+    InvalidResult,
+
+    /**
+     * The K-factor is not positive and finite (with fixed-point
+     * ratings: not above MaxRating either)
+     */
+    InvalidKFactor
+};
+
+/**
+ * MatchRecord
+ *
+ * A compact description of one finished match, used for batch recording
+ *
+ * Layout (16 bytes):
+ *   player1   4 bytes
+ *   player2   4 bytes
+ *   result    1 byte (+3 bytes padding)
+ *   kFactor   4 bytes
+ *
+ * Game servers can send thousands of these in one array,
+ * and RankingSystem::recordMatches applies them in order
+ */
+struct MatchRecord
+{
+    PlayerId player1;
+    PlayerId player2;
+
+    /**
+     * Outcome from player1's point of view
+     */
+    MatchResult result;
+
+    /**
+     * K-factor for this match
+     * 0 (the default) means "use Match::DefaultKFactor"; anything else
+     * must be positive, finite and at most MaxRating (otherwise MatchStatus::InvalidKFactor)
+     *
+     * A float is precise enough for K and keeps the record at 16 bytes
+     */
+    float kFactor = 0.0f;
+};
+
+static_assert(sizeof(MatchRecord) == 16, "MatchRecord should stay 16 bytes");
+
+#endif
@@ -18,38 +18,66 @@
  * - More efficient, especially for complex types like std::string
  * - Some member variables can ONLY be initialized this way
  * - It's the C++ best practice and what professional code does
+ *
+ * A standalone player creates its own one-row table and points at row 0
+ * PlayerTable::addRow clamps a negative rating to 0.0, so the old
+ * "negative rating becomes 0" safety net still applies here
  */
 Player::Player(std::string  name, double rating)
-    : name(std::move(name)),
-      rating(rating),
-      gamesPlayed(0),
-      wins(0),
-      losses(0),
-      draws(0)
-{
-    /**
-     * I wanted to have a check if rating somehow became negative and set it to 0
-     * No error message is printed - it just happens in the background
-     *
-     * Why silently?
-     * - The user doesn't need to know about internal validation
-     * - This is a safety net that prevents impossible states
-     *
-     * A player can stay at 0 rating until they win games and climb back up
-     * This can be tested in the tests directory to verify it works
-     */
-    if (this->rating < 0)
+    : table(nullptr),
+      row(0),
+      ownedTable(std::make_unique<PlayerTable>())
+{
+    table = ownedTable.get();
+    row = table->addRow(std::move(name), rating);
+}
+
+/**
+ * Same as the constructor above, with the counters filled in
+ */
+Player::Player(std::string name, double rating, const PlayerStats& stats)
+    : table(nullptr),
+      row(0),
+      ownedTable(std::make_unique<PlayerTable>())
+{
+    table = ownedTable.get();
+    row = table->addRow(std::move(name), rating, stats);
+}
+
+/**
+ * Check the counters and the rating, then build the player in one step
+ */
+std::expected<Player, RankingError> Player::restore(std::string name, double rating, const PlayerStats& stats)
+{
+    if (!stats.isConsistent())
+    {
+        return std::unexpected(RankingError::InconsistentStats);
+    }
+    if (!isValidRating(rating))
     {
-        this->rating = 0.0;
+        return std::unexpected(RankingError::InvalidRating);
     }
+
+    return Player(std::move(name), rating, stats);
+}
+
+/**
+ * Creates a handle to a row that already exists in a shared table
+ * Nothing is copied; the handle just remembers where the data lives
+ */
+Player::Player(PlayerTable& table, size_t row)
+    : table(&table),
+      row(row)
+{
 }
 
 /**
  * The method body is just one line that returns the name
+ * Returning a const reference avoids copying the string on every call
  */
-std::string Player::getName() const
+const std::string& Player::getName() const
 {
-    return name;
+    return table->getName(row);
 }
 
 /**
@@ -57,7 +85,7 @@ std::string Player::getName() const
  */
 double Player::getRating() const
 {
-    return rating;
+    return table->getRating(row);
 }
 
 /**
@@ -65,7 +93,7 @@ double Player::getRating() const
  */
 int Player::getGamesPlayed() const
 {
-    return gamesPlayed;
+    return table->getGamesPlayed(row);
 }
 
 /**
@@ -73,7 +101,7 @@ int Player::getGamesPlayed() const
  */
 int Player::getWins() const
 {
-    return wins;
+    return table->getWins(row);
 }
 
 /**
@@ -81,7 +109,7 @@ int Player::getWins() const
  */
 int Player::getLosses() const
 {
-    return losses;
+    return table->getLosses(row);
 }
 
 /**
@@ -89,7 +117,7 @@ int Player::getLosses() const
  */
 int Player::getDraws() const
 {
-    return draws;
+    return table->getDraws(row);
 }
 
 /**
@@ -104,49 +132,59 @@ int Player::getDraws() const
  */
 void Player::updateRating(double newRating)
 {
-    rating = newRating;
+    table->updateRating(row, newRating);
+}
+
+/**
+ * Stored-form versions of getRating and updateRating
+ */
+RatingValue Player::getRatingValue() const
+{
+    return table->getRatingValue(row);
+}
+
+void Player::updateRatingValue(RatingValue newRating)
+{
+    table->updateRatingValue(row, newRating);
 }
 
 /**
  * Called when this player wins a game
  *
- * Two things happen:
- * 1. wins++ increments the wins counter by 1
- * 2. gamesPlayed++ increments the games counter by 1
+ * The table updates this player's row, where two things happen:
+ * 1. The wins counter increases by 1
+ * 2. The gamesPlayed counter increases by 1
  *
  * This keeps our statistics consistent
  * If a player wins 5 games and loses 3 games, gamesPlayed should be 8
  */
 void Player::recordWin()
 {
-    wins++;
-    gamesPlayed++;
+    table->recordWin(row);
 }
 
 /**
  * Called when this player loses a game
  *
- * Two things happen:
- * 1. losses++ increments the losses counter by 1
- * 2. gamesPlayed++ increments the games counter by 1
+ * The table updates this player's row, where two things happen:
+ * 1. The losses counter increases by 1
+ * 2. The gamesPlayed counter increases by 1
  */
 void Player::recordLoss()
 {
-    losses++;
-    gamesPlayed++;
+    table->recordLoss(row);
 }
 
 /**
  * Called when this player's game ends in a tie
  *
- * Two things happen:
- * 1. draws++ increments the draws counter by 1
- * 2. gamesPlayed++ increments the games counter by 1
+ * The table updates this player's row, where two things happen:
+ * 1. The draws counter increases by 1
+ * 2. The gamesPlayed counter increases by 1
  */
 void Player::recordDraw()
 {
-    draws++;
-    gamesPlayed++;
+    table->recordDraw(row);
 }
 
 /**
@@ -171,26 +209,26 @@ void Player::recordDraw()
  * Column 5: Losses (6 chars wide)
  * Column 6: Draws (6 chars wide)
  */
-void Player::displayStats() const
+void Player::displayStats(std::ostream& out) const
 {
-    std::cout << std::left << std::setw(20) << name
-              /** Left-align the name in a 20-character wide column */
+    out << std::left << std::setw(20) << getName()
+        /** Left-align the name in a 20-character wide column */
 
-              << std::fixed << std::setprecision(1)
-              /** Use fixed-point notation with 1 decimal place for the next number */
+        << std::fixed << std::setprecision(1)
+        /** Use fixed-point notation with 1 decimal place for the next number */
 
-              << std::setw(10) << rating
-              /** Print rating in a 10-character wide column */
+        << std::setw(10) << getRating()
+        /** Print rating in a 10-character wide column */
 
-              << std::setw(8) << gamesPlayed
-              /** Print games played in an 8-character wide column */
+        << std::setw(8) << getGamesPlayed()
+        /** Print games played in an 8-character wide column */
 
-              << std::setw(6) << wins
-              /** Print wins in a 6-character wide column */
+        << std::setw(6) << getWins()
+        /** Print wins in a 6-character wide column */
 
-              << std::setw(6) << losses
-              /** Print losses in a 6-character wide column */
+        << std::setw(6) << getLosses()
+        /** Print losses in a 6-character wide column */
 
-              << std::setw(6) << draws << std::endl;
-              /** Print draws in a 6-character wide column, then end the line */
+        << std::setw(6) << getDraws() << std::endl;
+        /** Print draws in a 6-character wide column, then end the line */
 }
\ No newline at end of file
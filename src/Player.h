@@ -4,6 +4,11 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include "PlayerTable.h"
+#include "RankingError.h"
+#include <expected>
+#include <iostream>
+#include <memory>
 #include <string>
 
 /**
@@ -26,40 +31,35 @@ class Player
 private:
 
     /**
-     * Player's name as text
-     * Example: "Alice"
-     */
-    std::string name;
-
-    /**
-     * Player's current Elo rating
-     * Example: 1200.0
-     */
-    double rating;
-
-    /**
-     * How many total games has this player played
-     * This should equal: wins + losses + draws
+     * A Player is a handle: it points at one row of a PlayerTable
+     * The name, rating and counters live in the table's columns
+     *
+     * Why a handle?
+     * - RankingSystem keeps every player in one PlayerTable, so scanning
+     *   ratings for the leaderboard reads one dense array
+     * - A Player costs only a few bytes, no matter how long the name is
      */
-    int gamesPlayed;
+    PlayerTable* table;
 
     /**
-     * How many games did this player win?
-     * Used to calculate win/loss ratio and statistics
+     * Which row of the table belongs to this player
      */
-    int wins;
+    size_t row;
 
     /**
-     * How many games did this player lose?
-     * Used to calculate win/loss ratio and statistics
+     * Only used by standalone players (created with a name and rating)
+     *
+     * A standalone player owns a private one-row table,
+     * so "Player alice{"Alice"};" still works on its own, like in the tests
+     * Handles created by RankingSystem leave this empty
      */
-    int losses;
+    std::unique_ptr<PlayerTable> ownedTable;
 
     /**
-     * How many games ended in a tie?
-     * Some games might not have a clear winner
+     * Standalone player that starts with the given counters
+     * Only reachable through restore(), which checks them first
      */
-    int draws;
+    Player(std::string name, double rating, const PlayerStats& stats);
 
 public:
 
@@ -74,23 +74,58 @@ public:
      *   Player alice{"Alice"};           Uses default rating 1200.0
      *   Player bob{"Bob", 1500.0};       Uses custom rating 1500.0
      *
-     * The initializer list in Player.cpp will:
-     * - Set this.name to the parameter name
-     * - Set this.rating to the parameter rating
-     * - Initialize gamesPlayed, wins, losses, draws to 0
+     * This creates a standalone player that owns its own one-row table:
+     * - The name and rating are stored in that row
+     * - gamesPlayed, wins, losses, draws start at 0
      */
     Player(std::string  name, double rating = 1200.0);
 
+    /**
+     * Create a handle to an existing row of a table
+     *
+     * Parameters:
+     *   table - The table that stores the player's data
+     *   row - The player's row in that table
+     *
+     * Used by RankingSystem, which keeps all players in one table
+     * The handle does not own the table, so the table must outlive it
+     */
+    Player(PlayerTable& table, size_t row);
+
+    /**
+     * Recreate a standalone player from saved data, counters included
+     *
+     * Parameters:
+     *   name - The player's name
+     *   rating - The saved rating
+     *   stats - The saved games played, wins, losses and draws
+     *
+     * Returns: The player, or RankingError::InconsistentStats if the
+     *          counters cannot be right (see PlayerStats::isConsistent),
+     *          or RankingError::InvalidRating if the rating cannot be stored
+     *          (NaN, infinite, see isValidRating)
+     *
+     * Why not create the player and call recordWin() once per win?
+     * A veteran with 50,000 games would cost 50,000 calls
+     * Here the counters are set once, whatever they are
+     *
+     * Usage example:
+     *   auto alice = Player::restore("Alice", 1245.5, {15, 10, 3, 2});
+     *   if (alice) { alice->getWins() is 10 }
+     */
+    static std::expected<Player, RankingError> restore(std::string name, double rating, const PlayerStats& stats);
+
     /**
      * Get the player's name
      *
-     * Returns the player's name as text
+     * Returns a const reference to the player's name
+     * No copy is made, so this is cheap to call in loops
      *
      * Example return values:
      *   "Alice"
      *   "Bob"
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
      * Get the player's current Elo rating
@@ -167,6 +202,16 @@ public:
      */
     void updateRating(double newRating);
 
+    /**
+     * The rating in its stored form (see Rating.h)
+     *
+     * In the default build this is the same double as getRating()
+     * With fixed-point ratings it is the rating times 1000 as an integer;
+     * Match uses these so its integer math never goes through a double
+     */
+    RatingValue getRatingValue() const;
+    void updateRatingValue(RatingValue newRating);
+
     /**
      * Record that this player won a game
      *
@@ -220,10 +265,12 @@ public:
      *
      * Called by RankingSystem to print the leaderboard table
      *
-     * Uses std::cout to print to the console
+     * Parameters:
+     *   out - Where to print (std::cout, the console, by default)
+     *
      * Uses formatting tools to make columns line up nicely
      */
-    void displayStats() const;
+    void displayStats(std::ostream& out = std::cout) const;
 
 };
 
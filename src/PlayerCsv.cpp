@@ -0,0 +1,259 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "PlayerCsv.h"
+#include "Crc32.h"
+#include "Rating.h"
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+namespace
+{
+    /**
+     * Skip spaces and tabs at the front of the remaining text
+     */
+    void skipBlanks(const char*& position, const char* end)
+    {
+        while (position != end && (*position == ' ' || *position == '\t'))
+        {
+            position++;
+        }
+    }
+
+    /**
+     * Read one number and the comma after it (unless it is the last field)
+     *
+     * std::from_chars converts the digits directly from the text
+     * and tells us where it stopped; ec is set if there was no number
+     */
+    template <typename T>
+    bool readField(const char*& position, const char* end, T& value, bool last)
+    {
+        skipBlanks(position, end);
+
+        const std::from_chars_result result = std::from_chars(position, end, value);
+        if (result.ec != std::errc{})
+        {
+            return false;
+        }
+        position = result.ptr;
+
+        if (last)
+        {
+            return true;
+        }
+        if (position == end || *position != ',')
+        {
+            return false;
+        }
+        position++;
+        return true;
+    }
+
+    /**
+     * The last line of the text without its line break
+     * (a final line break does not start an empty last line)
+     * It is a piece of text, so it also tells where the line starts
+     */
+    std::string_view lastLineOf(std::string_view text)
+    {
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+        {
+            text.remove_suffix(1);
+        }
+
+        const size_t lineBreak = text.rfind('\n');
+        return text.substr(lineBreak == std::string_view::npos ? 0 : lineBreak + 1);
+    }
+}
+
+/**
+ * Steps:
+ * 1. Drop a trailing '\r' (files written on Windows)
+ * 2. The name is everything up to the first comma
+ * 3. Then rating, games, wins, losses and draws, separated by commas
+ *    (from_chars also reads "nan" and "inf", which are refused,
+ *    like any rating that cannot be stored, see isValidRating)
+ */
+bool PlayerCsv::parseRow(std::string_view line, PlayerCsvRow& row)
+{
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+
+    const size_t comma = line.find(',');
+    if (comma == std::string_view::npos)
+    {
+        return false;
+    }
+    row.name = line.substr(0, comma);
+
+    const char* position = line.data() + comma + 1;
+    const char* end = line.data() + line.size();
+
+    return readField(position, end, row.rating, false) && isValidRating(row.rating) &&
+           readField(position, end, row.gamesPlayed, false) &&
+           readField(position, end, row.wins, false) &&
+           readField(position, end, row.losses, false) &&
+           readField(position, end, row.draws, true);
+}
+
+/**
+ * Each number is converted straight into a small stack buffer
+ * The longest double is 24 characters and the longest int 11,
+ * so 32 characters are always enough
+ */
+void PlayerCsv::appendRow(std::string& out, const PlayerCsvRow& row)
+{
+    char digits[32];
+
+    out.append(row.name);
+
+    out.push_back(',');
+    out.append(digits, std::to_chars(digits, digits + sizeof(digits), row.rating).ptr);
+
+    for (const int count : {row.gamesPlayed, row.wins, row.losses, row.draws})
+    {
+        out.push_back(',');
+        out.append(digits, std::to_chars(digits, digits + sizeof(digits), count).ptr);
+    }
+
+    out.push_back('\n');
+}
+
+/**
+ * Always exactly 8 digits, padded with zeros,
+ * so the footer has the same length in every file
+ */
+void PlayerCsv::appendChecksum(std::string& out, std::uint32_t checksum)
+{
+    char digits[8];
+    for (int i = 7; i >= 0; i--)
+    {
+        digits[i] = "0123456789abcdef"[checksum & 0xF];
+        checksum >>= 4;
+    }
+
+    out.append(ChecksumPrefix);
+    out.append(digits, sizeof(digits));
+    out.push_back('\n');
+}
+
+void PlayerCsv::appendSequence(std::string& out, std::uint64_t sequence)
+{
+    char digits[20];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), sequence);
+
+    out.append(SequencePrefix);
+    out.append(digits, result.ptr);
+    out.push_back('\n');
+}
+
+/**
+ * Only a line that is exactly the prefix and a number counts, so no
+ * player row is ever taken for it
+ */
+bool PlayerCsv::readSequence(std::string_view& text, std::uint64_t& sequence)
+{
+    const std::string_view lastLine = lastLineOf(text);
+    const size_t lineStart = static_cast<size_t>(lastLine.data() - text.data());
+
+    if (!lastLine.starts_with(SequencePrefix))
+    {
+        return false;
+    }
+
+    const std::string_view digits = lastLine.substr(SequencePrefix.size());
+    std::uint64_t value = 0;
+    const std::from_chars_result result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    if (digits.empty() || result.ec != std::errc{} || result.ptr != digits.data() + digits.size())
+    {
+        return false;
+    }
+
+    sequence = value;
+    text = text.substr(0, lineStart);
+    return true;
+}
+
+/**
+ * Steps:
+ * 1. Find the first and the last line (ignoring the final line break)
+ * 2. The last line is the checksum line only if it is exactly
+ *    ChecksumPrefix and 8 hex digits; without one, the file must
+ *    not start with ChecksumHeader
+ * 3. Compare with the CRC-32 of everything before the line,
+ *    then cut off the checksum lines
+ */
+bool PlayerCsv::verifyChecksum(std::string_view& text)
+{
+    std::string_view firstLine = text.substr(0, text.find('\n'));
+    if (firstLine.ends_with('\r'))
+    {
+        firstLine.remove_suffix(1);
+    }
+    const bool hasHeader = firstLine == ChecksumHeader;
+
+    const std::string_view lastLine = lastLineOf(text);
+    const size_t lineStart = static_cast<size_t>(lastLine.data() - text.data());
+
+    const std::string_view digits =
+        lastLine.starts_with(ChecksumPrefix) ? lastLine.substr(ChecksumPrefix.size()) : std::string_view{};
+    std::uint32_t expected = 0;
+    bool isChecksumLine = digits.size() == 8;
+    if (isChecksumLine)
+    {
+        const std::from_chars_result result = std::from_chars(digits.data(), digits.data() + 8, expected, 16);
+        isChecksumLine = result.ec == std::errc{} && result.ptr == digits.data() + 8;
+    }
+    if (!isChecksumLine)
+    {
+        return !hasHeader;
+    }
+
+    const std::string_view body = text.substr(0, lineStart);
+    if (Crc32::compute(body) != expected)
+    {
+        return false;
+    }
+
+    text = body;
+    if (hasHeader)
+    {
+        text.remove_prefix(std::min(text.size(), text.find('\n') + 1));
+    }
+    return true;
+}
+
+/**
+ * Aim for equal sizes, then move each cut forward to just after
+ * the next line break (a very long line can swallow a whole piece,
+ * in which case there are fewer pieces)
+ */
+std::vector<std::string_view> PlayerCsv::splitChunks(std::string_view text, size_t chunkCount)
+{
+    std::vector<std::string_view> chunks;
+    if (chunkCount == 0)
+    {
+        chunkCount = 1;
+    }
+
+    size_t start = 0;
+    for (size_t i = 1; i <= chunkCount && start < text.size(); i++)
+    {
+        size_t end = text.size();
+        if (i < chunkCount)
+        {
+            const size_t target = std::max(start, text.size() / chunkCount * i);
+            const size_t lineBreak = text.find('\n', target);
+            end = lineBreak == std::string_view::npos ? text.size() : lineBreak + 1;
+        }
+
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
+
+    return chunks;
+}
@@ -0,0 +1,237 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef PLAYERCSV_H
+#define PLAYERCSV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * PlayerCsvRow
+ *
+ * The fields of one line of players.csv:
+ *   Name,Rating,GamesPlayed,Wins,Losses,Draws
+ *
+ * name points into the parsed text, so it is only valid
+ * while that text exists (copy it to keep it)
+ */
+struct PlayerCsvRow
+{
+    std::string_view name;
+    double rating = 0.0;
+    int gamesPlayed = 0;
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+};
+
+/**
+ * FileChecksum
+ *
+ * Whether saveToFile ends the file with a checksum line
+ * (after the rows and the "#sequence,N" line, see PlayerCsv)
+ *
+ *   None        - No checksum line
+ *   Crc32Footer - A first line "#checksum,crc32" and a last line
+ *                 "#crc32,xxxxxxxx" with the CRC-32 of every byte
+ *                 before it; loadFromFile checks it and refuses a
+ *                 file that was damaged or cut short
+ */
+enum class FileChecksum : std::uint8_t
+{
+    None,
+    Crc32Footer
+};
+
+/**
+ * PlayerCsv Class
+ *
+ * Reads and writes the player file format used by saveToFile and loadFromFile
+ *
+ * The parser works on text that is already in memory (for example a
+ * MappedFile) and reads the numbers with std::from_chars:
+ * - No std::string and no stringstream per line
+ * - No locale lookups, no stream state
+ * - Nothing is copied; a row only points into the text
+ */
+class PlayerCsv
+{
+
+public:
+
+    /**
+     * Parse one line (without its line break)
+     *
+     * Parameters:
+     *   line - The text of the line; a trailing '\r' is ignored
+     *   row - Output: the parsed fields
+     *
+     * Returns: true if the line had a name and all five numbers,
+     *          false for blank or malformed lines (a rating that is
+     *          NaN, infinite or cannot be stored counts as malformed)
+     *
+     * Like the old stream parser, spaces before a number are skipped
+     * and the name runs up to the first comma
+     */
+    static bool parseRow(std::string_view line, PlayerCsvRow& row);
+
+    /**
+     * Size of the blocks saveToFile hands to the file
+     *
+     * Rows are collected in memory until the buffer reaches this size,
+     * then written with one call; a few large writes are much cheaper
+     * than a stream operation per field
+     */
+    static constexpr size_t WriteBlockSize = 256 * 1024;
+
+    /**
+     * Append one line (with its line break) to a buffer
+     *
+     * Parameters:
+     *   out - The buffer; the line is added at the end
+     *   row - The fields to write
+     *
+     * The numbers are written with std::to_chars:
+     * - The rating uses the shortest text that reads back as exactly
+     *   the same double, so a save followed by a load changes nothing
+     *   (operator<< keeps only 6 significant digits by default)
+     * - No locale lookups and no stream state per value
+     *
+     * parseRow reads back everything appendRow writes
+     */
+    static void appendRow(std::string& out, const PlayerCsvRow& row);
+
+    /**
+     * Lines starting with '#' are the file's own (the sequence and
+     * checksum lines below), so no player name may start with it
+     */
+    static constexpr char ReservedMark = '#';
+
+    /**
+     * Start of the sequence line
+     */
+    static constexpr std::string_view SequencePrefix = "#sequence,";
+
+    /**
+     * Append the sequence line: SequencePrefix, the number, line break
+     *
+     * Parameters:
+     *   out - The buffer; the line is added at the end
+     *   sequence - The change sequence the rows include
+     *              (see RankingSystem::getChangeSequence)
+     */
+    static void appendSequence(std::string& out, std::uint64_t sequence);
+
+    /**
+     * Read and remove a sequence line at the end of a file's text
+     *
+     * Parameters:
+     *   text - The rows, after verifyChecksum; if they end with a
+     *          sequence line, it is shortened to the rows before it
+     *   sequence - Output: the number on that line
+     *
+     * Returns: true if the last line is exactly SequencePrefix and
+     *          a number, false if there is no such line
+     *          (a file saved before the line existed)
+     */
+    static bool readSequence(std::string_view& text, std::uint64_t& sequence);
+
+    /**
+     * First line of a file saved with a checksum
+     *
+     * It promises a checksum line at the end, so a file that was cut
+     * short (and lost its checksum line with the rest) is refused
+     * instead of being read as a file saved without a checksum
+     */
+    static constexpr std::string_view ChecksumHeader = "#checksum,crc32";
+
+    /**
+     * Start of the checksum line
+     */
+    static constexpr std::string_view ChecksumPrefix = "#crc32,";
+
+    /**
+     * Append the checksum line: ChecksumPrefix, 8 hex digits, line break
+     *
+     * Parameters:
+     *   out - The buffer; the line is added at the end
+     *   checksum - CRC-32 of every byte written before this line
+     *              (ChecksumHeader included)
+     */
+    static void appendChecksum(std::string& out, std::uint32_t checksum);
+
+    /**
+     * Check and remove the checksum lines of a file's text
+     *
+     * Parameters:
+     *   text - The whole file; if it ends with a checksum line,
+     *          it is shortened to the rows before that line
+     *          (and after ChecksumHeader, if the file starts with it)
+     *
+     * Only a last line that is exactly ChecksumPrefix and 8 hex digits
+     * is a checksum line; anything else is an ordinary (or malformed) row
+     *
+     * Returns: false if there is a checksum line and it does not match,
+     *          or if the file starts with ChecksumHeader and has no
+     *          checksum line; true if it matches, or if the file has
+     *          neither line
+     */
+    static bool verifyChecksum(std::string_view& text);
+
+    /**
+     * Cut a file's text into pieces that can be parsed independently
+     *
+     * Parameters:
+     *   text - The whole file
+     *   chunkCount - How many pieces to aim for
+     *
+     * Returns: Up to chunkCount consecutive pieces that together are the
+     *          whole text, in order; every piece except the last ends
+     *          right after a line break, so no line is split in two
+     *
+     * The pieces are roughly the same size in bytes, so each thread
+     * of a parallel load gets about the same amount of work
+     */
+    static std::vector<std::string_view> splitChunks(std::string_view text, size_t chunkCount);
+
+    /**
+     * Parse every line of a file's text
+     *
+     * Parameters:
+     *   text - The whole file
+     *   visit - Called as visit(row) for each valid line, in file order
+     *
+     * Returns: The number of lines that were skipped as blank or malformed
+     */
+    template <typename Visitor>
+    static size_t forEachRow(std::string_view text, Visitor visit)
+    {
+        size_t skipped = 0;
+
+        while (!text.empty())
+        {
+            const size_t end = text.find('\n');
+            const std::string_view line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+            PlayerCsvRow row;
+            if (parseRow(line, row))
+            {
+                visit(row);
+            }
+            else if (!line.empty() && line != "\r")
+            {
+                skipped++;
+            }
+        }
+
+        return skipped;
+    }
+
+};
+
+#endif
@@ -0,0 +1,430 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "PlayerSnapshot.h"
+#include "Crc32.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    /**
+     * Copy a value out of the file
+     *
+     * std::memcpy is the safe way to read a struct from raw bytes,
+     * whatever their alignment; the compiler turns it into plain loads
+     */
+    template <typename T>
+    T readAt(std::string_view file, std::uint64_t offset)
+    {
+        T value;
+        std::memcpy(&value, file.data() + offset, sizeof(T));
+        return value;
+    }
+
+    /**
+     * True if count items of itemSize bytes starting at offset fit
+     * within the first end bytes (written so nothing can overflow)
+     */
+    bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t itemSize, std::uint64_t end)
+    {
+        return offset <= end && count <= (end - offset) / itemSize;
+    }
+
+    /**
+     * Collects bytes and hands them to the file in large blocks,
+     * carrying the CRC-32 of everything written so far
+     */
+    class BlockWriter
+    {
+
+    private:
+
+        AtomicFileWriter& file;
+        std::string buffer;
+        std::uint32_t crc = 0;
+        bool ok = true;
+
+    public:
+
+        explicit BlockWriter(AtomicFileWriter& file) : file(file)
+        {
+            buffer.reserve(PlayerCsv::WriteBlockSize + sizeof(SnapshotRecord));
+        }
+
+        /**
+         * A large section (the leaderboard order) skips the buffer
+         * and goes to the file in one piece
+         */
+        void append(const void* data, size_t size)
+        {
+            if (size >= PlayerCsv::WriteBlockSize)
+            {
+                flush();
+                const std::string_view block(static_cast<const char*>(data), size);
+                crc = Crc32::update(crc, block);
+                ok = ok && file.write(block);
+                return;
+            }
+
+            buffer.append(static_cast<const char*>(data), size);
+            if (buffer.size() >= PlayerCsv::WriteBlockSize)
+            {
+                flush();
+            }
+        }
+
+        void appendZeros(size_t count)
+        {
+            buffer.append(count, '\0');
+        }
+
+        void flush()
+        {
+            crc = Crc32::update(crc, buffer);
+            ok = ok && file.write(buffer);
+            buffer.clear();
+        }
+
+        std::uint32_t checksum() const
+        {
+            return crc;
+        }
+
+        bool succeeded() const
+        {
+            return ok;
+        }
+
+    };
+}
+
+PlayerSnapshot::PlayerSnapshot(std::string_view file, const SnapshotHeader& header)
+    : file(file),
+      header(header)
+{
+}
+
+/**
+ * Steps:
+ * 1. Header: magic, version, byte order
+ * 2. Checksum trailer, if the flags say there is one
+ * 3. Every section lies inside the file
+ * 4. Every record: name offsets in order and inside the names,
+ *    a finite rating, counters that add up, and in a delta increasing ids
+ * 5. No name starts with PlayerCsv::ReservedMark
+ *
+ * Only after all of this is the file handed out
+ */
+std::expected<PlayerSnapshot, RankingError> PlayerSnapshot::open(std::string_view file)
+{
+    /**
+     * Step 1: The header
+     */
+    if (file.size() < sizeof(SnapshotHeader))
+    {
+        return std::unexpected(RankingError::InvalidSnapshot);
+    }
+
+    const SnapshotHeader header = readAt<SnapshotHeader>(file, 0);
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+        header.version != Version ||
+        header.byteOrder != ByteOrderMark ||
+        header.playerCount >= InvalidPlayerId)
+    {
+        return std::unexpected(RankingError::InvalidSnapshot);
+    }
+
+    /**
+     * Step 2: The checksum covers everything before the trailer,
+     * header included
+     */
+    std::uint64_t end = file.size();
+    if (header.flags & HasChecksum)
+    {
+        if (end < sizeof(SnapshotHeader) + TrailerSize)
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+        end -= TrailerSize;
+
+        const std::uint32_t stored = readAt<std::uint32_t>(file, end);
+        const std::uint32_t marker = readAt<std::uint32_t>(file, end + 4);
+        if (marker != ByteOrderMark || Crc32::compute(file.substr(0, end)) != stored)
+        {
+            return std::unexpected(RankingError::ChecksumMismatch);
+        }
+    }
+
+    /**
+     * Step 3: The sections
+     */
+    const std::uint64_t count = header.playerCount;
+    const bool delta = (header.flags & IsDelta) != 0;
+    if (!fits(header.recordsOffset, count, sizeof(SnapshotRecord), end) ||
+        !fits(header.namesOffset, header.namesSize, 1, end) ||
+        ((header.flags & HasLeaderboardOrder) && !fits(header.orderOffset, count, sizeof(PlayerId), end)) ||
+        (delta && !fits(header.idsOffset, count, sizeof(PlayerId), end)))
+    {
+        return std::unexpected(RankingError::InvalidSnapshot);
+    }
+
+    /**
+     * Step 4: The records
+     *
+     * Increasing ids mean no player is in a delta twice
+     */
+    const PlayerSnapshot snapshot(file, header);
+    std::uint64_t previousOffset = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SnapshotRecord record = snapshot.record(i);
+        if (record.nameOffset < previousOffset || record.nameOffset > header.namesSize ||
+            !isValidRating(record.rating) || !snapshot.stats(i).isConsistent())
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+        previousOffset = record.nameOffset;
+
+        if (delta && (snapshot.playerId(i) == InvalidPlayerId ||
+                      (i > 0 && snapshot.playerId(i) <= snapshot.playerId(i - 1))))
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+    }
+
+    /**
+     * Step 5: The names, now that every offset is known to be good
+     *
+     * No name may start with '#' (see PlayerCsv::ReservedMark):
+     * addPlayer refuses such names, and the next CSV save would
+     * write the player as one of the file's own lines
+     */
+    for (size_t i = 0; i < count; i++)
+    {
+        if (snapshot.name(i).starts_with(PlayerCsv::ReservedMark))
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+    }
+
+    return snapshot;
+}
+
+size_t PlayerSnapshot::size() const
+{
+    return static_cast<size_t>(header.playerCount);
+}
+
+SnapshotRecord PlayerSnapshot::record(size_t i) const
+{
+    return readAt<SnapshotRecord>(file, header.recordsOffset + i * sizeof(SnapshotRecord));
+}
+
+/**
+ * A name ends where the next one starts
+ */
+std::string_view PlayerSnapshot::name(size_t i) const
+{
+    const std::uint64_t start = record(i).nameOffset;
+    const std::uint64_t end = i + 1 < size() ? record(i + 1).nameOffset : header.namesSize;
+
+    return file.substr(header.namesOffset + start, end - start);
+}
+
+PlayerStats PlayerSnapshot::stats(size_t i) const
+{
+    const SnapshotRecord r = record(i);
+    return PlayerStats{r.gamesPlayed, r.wins, r.losses, r.draws};
+}
+
+std::uint64_t PlayerSnapshot::logSequence() const
+{
+    return header.logSequence;
+}
+
+bool PlayerSnapshot::isDelta() const
+{
+    return (header.flags & IsDelta) != 0;
+}
+
+std::uint64_t PlayerSnapshot::baseSequence() const
+{
+    return header.baseSequence;
+}
+
+PlayerId PlayerSnapshot::playerId(size_t i) const
+{
+    if (!isDelta())
+    {
+        return static_cast<PlayerId>(i);
+    }
+    return readAt<PlayerId>(file, header.idsOffset + i * sizeof(PlayerId));
+}
+
+bool PlayerSnapshot::hasLeaderboardOrder() const
+{
+    return (header.flags & HasLeaderboardOrder) != 0;
+}
+
+std::vector<PlayerId> PlayerSnapshot::leaderboardOrder() const
+{
+    std::vector<PlayerId> order;
+    if (hasLeaderboardOrder())
+    {
+        order.resize(size());
+        std::memcpy(order.data(), file.data() + header.orderOffset, order.size() * sizeof(PlayerId));
+    }
+    return order;
+}
+
+bool PlayerSnapshot::write(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> order,
+                           std::uint64_t logSequence, FileChecksum checksum)
+{
+    const bool withOrder = !order.empty() && order.size() == table.size();
+
+    SnapshotHeader header;
+    header.flags = withOrder ? HasLeaderboardOrder : 0u;
+    header.logSequence = logSequence;
+
+    return writeFile(file, table, withOrder ? order : std::span<const PlayerId>{}, header, checksum);
+}
+
+bool PlayerSnapshot::writeDelta(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> ids,
+                                std::uint64_t baseSequence, std::uint64_t logSequence, FileChecksum checksum)
+{
+    if (ids.size() != table.size())
+    {
+        return false;
+    }
+
+    SnapshotHeader header;
+    header.flags = IsDelta;
+    header.logSequence = logSequence;
+    header.baseSequence = baseSequence;
+
+    return writeFile(file, table, ids, header, checksum);
+}
+
+/**
+ * Steps:
+ * 1. Work out where every section goes and write the header
+ * 2. One record per row, name offsets counted up as we go
+ * 3. The names, back to back
+ * 4. The leaderboard order or the ids, starting at a multiple of 8 bytes
+ * 5. The checksum trailer
+ */
+bool PlayerSnapshot::writeFile(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> section,
+                               SnapshotHeader header, FileChecksum checksum)
+{
+    /**
+     * Step 1: The header
+     */
+    const size_t count = table.size();
+    std::uint64_t namesSize = 0;
+    for (size_t row = 0; row < count; row++)
+    {
+        namesSize += table.getName(row).size();
+    }
+
+    const bool withChecksum = checksum == FileChecksum::Crc32Footer;
+
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.flags |= withChecksum ? HasChecksum : 0u;
+    header.byteOrder = ByteOrderMark;
+    header.playerCount = count;
+    header.recordsOffset = sizeof(SnapshotHeader);
+    header.namesOffset = header.recordsOffset + count * sizeof(SnapshotRecord);
+    header.namesSize = namesSize;
+
+    const std::uint64_t namesEnd = header.namesOffset + namesSize;
+    const std::uint64_t padding = (8 - namesEnd % 8) % 8;
+    const bool withSection = (header.flags & (HasLeaderboardOrder | IsDelta)) != 0;
+    if (header.flags & IsDelta)
+    {
+        header.idsOffset = namesEnd + padding;
+    }
+    else if (withSection)
+    {
+        header.orderOffset = namesEnd + padding;
+    }
+
+    BlockWriter out(file);
+    out.append(&header, sizeof(header));
+
+    /**
+     * Step 2: The records
+     */
+    std::uint64_t nameOffset = 0;
+    for (size_t row = 0; row < count; row++)
+    {
+        SnapshotRecord record;
+        record.nameOffset = nameOffset;
+        record.rating = table.getRating(row);
+        record.gamesPlayed = table.getGamesPlayed(row);
+        record.wins = table.getWins(row);
+        record.losses = table.getLosses(row);
+        record.draws = table.getDraws(row);
+        out.append(&record, sizeof(record));
+
+        nameOffset += table.getName(row).size();
+    }
+
+    /**
+     * Step 3: The names
+     */
+    for (size_t row = 0; row < count; row++)
+    {
+        const std::string& name = table.getName(row);
+        out.append(name.data(), name.size());
+    }
+
+    /**
+     * Step 4: The leaderboard order, or the delta's ids
+     */
+    if (withSection)
+    {
+        out.appendZeros(padding);
+        out.append(section.data(), section.size() * sizeof(PlayerId));
+    }
+
+    /**
+     * Step 5: The trailer covers everything written before it
+     */
+    out.flush();
+    if (withChecksum)
+    {
+        const std::uint32_t trailer[2] = {out.checksum(), ByteOrderMark};
+        out.append(trailer, sizeof(trailer));
+        out.flush();
+    }
+
+    return out.succeeded();
+}
+
+/**
+ * Same steps as RankingSystem::saveToFile: temporary file, write, commit
+ */
+std::expected<void, RankingError> PlayerSnapshot::save(const std::string& filename, const SnapshotCapture& capture,
+                                                       FileChecksum checksum)
+{
+    AtomicFileWriter file(filename);
+    if (!file.isOpen())
+    {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    const bool written = capture.delta
+        ? writeDelta(file, capture.table, capture.ids, capture.baseSequence, capture.logSequence, checksum)
+        : write(file, capture.table, capture.order, capture.logSequence, checksum);
+
+    if (!written || !file.commit())
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
+
+    return {};
+}
@@ -0,0 +1,300 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef PLAYERSNAPSHOT_H
+#define PLAYERSNAPSHOT_H
+
+#include "AtomicFileWriter.h"
+#include "PlayerCsv.h"
+#include "PlayerTable.h"
+#include "RankingError.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * SnapshotHeader
+ *
+ * The first 88 bytes of a snapshot file
+ *
+ * Layout of the whole file:
+ *   header            88 bytes
+ *   records           playerCount * 32 bytes, one SnapshotRecord per player
+ *   names             namesSize bytes, every name back to back (no separators)
+ *   leaderboard order playerCount * 4 bytes, optional (flag HasLeaderboardOrder)
+ *   player ids        playerCount * 4 bytes, deltas only (flag IsDelta)
+ *   checksum trailer  8 bytes, optional (flag HasChecksum)
+ *
+ * A delta holds only the players that changed after another snapshot
+ * or delta (see RankingSystem::saveDelta): record i belongs to player
+ * ids[i], and players that already existed have an empty name there
+ *
+ * The offsets are stored instead of assumed, so a later version can
+ * add sections without breaking readers of this one
+ * All numbers are in the byte order of the machine that wrote the file;
+ * byteOrder lets a reader on a different machine notice
+ */
+struct SnapshotHeader
+{
+    char magic[8]{};
+    std::uint32_t version = 0;
+    std::uint32_t flags = 0;
+    std::uint32_t byteOrder = 0;
+    std::uint32_t reserved = 0;
+    std::uint64_t playerCount = 0;
+    std::uint64_t recordsOffset = 0;
+    std::uint64_t namesOffset = 0;
+    std::uint64_t namesSize = 0;
+    std::uint64_t orderOffset = 0;
+
+    /**
+     * How many logged changes the snapshot contains
+     * (RankingSystem::getChangeSequence when it was taken), so that
+     * only the match log records after it are replayed on top
+     */
+    std::uint64_t logSequence = 0;
+
+    /**
+     * Deltas only: the logSequence of the state the delta applies to,
+     * and where the player ids start
+     */
+    std::uint64_t baseSequence = 0;
+    std::uint64_t idsOffset = 0;
+};
+
+/**
+ * SnapshotRecord
+ *
+ * One player, always 32 bytes, so record N is found by multiplication
+ *
+ * The name is names[nameOffset, next record's nameOffset)
+ * (the last name ends at namesSize)
+ * The rating is always stored as a double, whichever way this build
+ * stores ratings, so snapshots move freely between builds
+ */
+struct SnapshotRecord
+{
+    std::uint64_t nameOffset = 0;
+    double rating = 0.0;
+    std::int32_t gamesPlayed = 0;
+    std::int32_t wins = 0;
+    std::int32_t losses = 0;
+    std::int32_t draws = 0;
+};
+
+static_assert(sizeof(SnapshotHeader) == 88, "the header layout is part of the file format");
+static_assert(sizeof(SnapshotRecord) == 32, "the record layout is part of the file format");
+
+/**
+ * SnapshotCapture
+ *
+ * A copy of everything a snapshot stores, taken at one moment
+ * (see RankingSystem::captureSnapshot and captureDelta)
+ *
+ * It shares nothing with the system it came from, so it can be
+ * written out while the system keeps changing
+ *
+ * For a delta, ids holds the player id of every row of table,
+ * and baseSequence the state the delta applies to
+ */
+struct SnapshotCapture
+{
+    PlayerTable table;
+    std::vector<PlayerId> order;
+    std::uint64_t logSequence = 0;
+
+    bool delta = false;
+    std::vector<PlayerId> ids;
+    std::uint64_t baseSequence = 0;
+};
+
+/**
+ * PlayerSnapshot Class
+ *
+ * Reads and writes the binary snapshot format used by
+ * RankingSystem::saveSnapshot and loadSnapshot
+ *
+ * Why a binary format next to the CSV file?
+ * Loading CSV means finding commas and converting text to numbers for
+ * every field. A snapshot stores the numbers exactly as they are in
+ * memory, at fixed places, so loading is copying:
+ * - No parsing at all, and no rounding of ratings
+ * - The file is memory-mapped (MappedFile) and read in place;
+ *   names are used straight from the mapping until they are stored
+ * - The leaderboard order is saved too, so the leaderboard can be
+ *   rebuilt without sorting (LeaderboardIndex::build with an order)
+ *
+ * Reading:
+ *   MappedFile file("players.snapshot");
+ *   auto snapshot = PlayerSnapshot::open(file.text());
+ *   if (snapshot) { snapshot->record(i), snapshot->name(i), ... }
+ *
+ * open() checks the whole file first (sizes, offsets, counters and the
+ * checksum if there is one), so the accessors never read outside it
+ */
+class PlayerSnapshot
+{
+
+private:
+
+    std::string_view file;
+    SnapshotHeader header;
+
+    PlayerSnapshot(std::string_view file, const SnapshotHeader& header);
+
+    /**
+     * Shared by write and writeDelta
+     *
+     * header comes in with flags and sequences set; the rest is
+     * filled in here. section is the leaderboard order or the delta's
+     * player ids, written after the names
+     */
+    static bool writeFile(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> section,
+                          SnapshotHeader header, FileChecksum checksum);
+
+public:
+
+    /**
+     * "ELOSNAP" and a terminating zero
+     */
+    static constexpr char Magic[8] = {'E', 'L', 'O', 'S', 'N', 'A', 'P', '\0'};
+
+    /**
+     * Format version written and read by this code
+     */
+    static constexpr std::uint32_t Version = 1;
+
+    /**
+     * Written as a number; reads back differently on a machine
+     * with the other byte order
+     */
+    static constexpr std::uint32_t ByteOrderMark = 0x01020304u;
+
+    /**
+     * Bits of SnapshotHeader::flags
+     */
+    static constexpr std::uint32_t HasLeaderboardOrder = 1u;
+    static constexpr std::uint32_t HasChecksum = 2u;
+    static constexpr std::uint32_t IsDelta = 4u;
+
+    /**
+     * Size of the checksum trailer: the CRC-32 of every byte before it,
+     * then ByteOrderMark again as an end marker
+     */
+    static constexpr size_t TrailerSize = 8;
+
+    /**
+     * Check a snapshot file and give access to it
+     *
+     * Parameters:
+     *   file - The whole file (usually a MappedFile's text); it must
+     *          outlive the returned object, which points into it
+     *
+     * Returns: The snapshot, ChecksumMismatch if its checksum does not
+     *          match, or InvalidSnapshot for anything else that is wrong
+     *          (not a snapshot, another version, cut short, bad offsets,
+     *          ratings that cannot be stored, names starting with '#',
+     *          counters that do not add up, delta ids out of order)
+     */
+    static std::expected<PlayerSnapshot, RankingError> open(std::string_view file);
+
+    /**
+     * Number of players in the snapshot
+     */
+    size_t size() const;
+
+    /**
+     * Player i's record and name (i below size())
+     *
+     * The name points into the file, nothing is copied
+     */
+    SnapshotRecord record(size_t i) const;
+    std::string_view name(size_t i) const;
+
+    /**
+     * Player i's counters as PlayerStats
+     */
+    PlayerStats stats(size_t i) const;
+
+    /**
+     * Number of logged changes the snapshot contains (see SnapshotHeader)
+     */
+    std::uint64_t logSequence() const;
+
+    /**
+     * Whether this is a delta, and the state it applies to
+     * (see SnapshotHeader::baseSequence)
+     */
+    bool isDelta() const;
+    std::uint64_t baseSequence() const;
+
+    /**
+     * The player record i belongs to: i in a full snapshot,
+     * the stored id in a delta (ids only ever increase)
+     */
+    PlayerId playerId(size_t i) const;
+
+    /**
+     * Whether the leaderboard order was saved
+     */
+    bool hasLeaderboardOrder() const;
+
+    /**
+     * Every player id in leaderboard order (empty if it was not saved)
+     */
+    std::vector<PlayerId> leaderboardOrder() const;
+
+    /**
+     * Write a whole snapshot
+     *
+     * Parameters:
+     *   file - Where to write; the caller commits it afterwards
+     *   table - The players, written in row order
+     *   order - Every row in leaderboard order, or empty to leave it out
+     *   logSequence - Stored in the header (see SnapshotHeader)
+     *   checksum - Crc32Footer adds the checksum trailer
+     *
+     * Returns: false if writing failed
+     *
+     * The sections are formatted into a buffer and written in blocks
+     * of PlayerCsv::WriteBlockSize, like the CSV file
+     */
+    static bool write(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> order,
+                      std::uint64_t logSequence, FileChecksum checksum);
+
+    /**
+     * Write a delta
+     *
+     * Parameters:
+     *   file - Where to write; the caller commits it afterwards
+     *   table - The changed players, one row each; names may be empty
+     *           for players the base already has
+     *   ids - The player id of every row of table, increasing
+     *   baseSequence - The state the delta applies to
+     *   logSequence - The state it brings the players to
+     *   checksum - Crc32Footer adds the checksum trailer
+     *
+     * Returns: false if writing failed
+     */
+    static bool writeDelta(AtomicFileWriter& file, const PlayerTable& table, std::span<const PlayerId> ids,
+                           std::uint64_t baseSequence, std::uint64_t logSequence, FileChecksum checksum);
+
+    /**
+     * Write a whole snapshot (or a delta, if capture.delta is set)
+     * to filename through an AtomicFileWriter
+     *
+     * Returns: Nothing on success, otherwise FileOpenFailed or FileWriteFailed
+     *
+     * Takes only the copied data, not a RankingSystem, so it can run
+     * on another thread (see CheckpointManager)
+     */
+    static std::expected<void, RankingError> save(const std::string& filename, const SnapshotCapture& capture,
+                                                  FileChecksum checksum);
+
+};
+
+#endif
@@ -0,0 +1,187 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "PlayerTable.h"
+
+#include <utility>
+
+/**
+ * Appends the player to the end of every column
+ *
+ * Each column grows by one, so all of them stay the same length
+ * and row size() - 1 is the new player
+ */
+size_t PlayerTable::addRow(std::string name, double rating)
+{
+    /**
+     * Same safety net the Player constructor always had:
+     * a negative starting rating is silently clamped to 0.0
+     */
+    if (rating < 0)
+    {
+        rating = 0.0;
+    }
+
+    names.push_back(std::move(name));
+    ratings.push_back(toRatingValue(rating));
+    gamesPlayed.push_back(0);
+    wins.push_back(0);
+    losses.push_back(0);
+    draws.push_back(0);
+
+    return names.size() - 1;
+}
+
+/**
+ * Same as addRow above, then the counters are filled in directly
+ */
+size_t PlayerTable::addRow(std::string name, double rating, const PlayerStats& stats)
+{
+    const size_t row = addRow(std::move(name), rating);
+
+    gamesPlayed[row] = stats.gamesPlayed;
+    wins[row] = stats.wins;
+    losses[row] = stats.losses;
+    draws[row] = stats.draws;
+
+    return row;
+}
+
+size_t PlayerTable::size() const
+{
+    return names.size();
+}
+
+void PlayerTable::clear()
+{
+    names.clear();
+    ratings.clear();
+    gamesPlayed.clear();
+    wins.clear();
+    losses.clear();
+    draws.clear();
+}
+
+void PlayerTable::reserve(size_t rowCount)
+{
+    names.reserve(rowCount);
+    ratings.reserve(rowCount);
+    gamesPlayed.reserve(rowCount);
+    wins.reserve(rowCount);
+    losses.reserve(rowCount);
+    draws.reserve(rowCount);
+}
+
+const std::string& PlayerTable::getName(size_t row) const
+{
+    return names[row];
+}
+
+double PlayerTable::getRating(size_t row) const
+{
+    return fromRatingValue(ratings[row]);
+}
+
+int PlayerTable::getGamesPlayed(size_t row) const
+{
+    return gamesPlayed[row];
+}
+
+int PlayerTable::getWins(size_t row) const
+{
+    return wins[row];
+}
+
+int PlayerTable::getLosses(size_t row) const
+{
+    return losses[row];
+}
+
+int PlayerTable::getDraws(size_t row) const
+{
+    return draws[row];
+}
+
+void PlayerTable::updateRating(size_t row, double newRating)
+{
+    ratings[row] = toRatingValue(newRating);
+}
+
+RatingValue PlayerTable::getRatingValue(size_t row) const
+{
+    return ratings[row];
+}
+
+void PlayerTable::updateRatingValue(size_t row, RatingValue newRating)
+{
+    ratings[row] = newRating;
+}
+
+/**
+ * The counters follow the same rule as before:
+ * every result also counts as one game played
+ */
+void PlayerTable::recordWin(size_t row)
+{
+    wins[row]++;
+    gamesPlayed[row]++;
+}
+
+void PlayerTable::recordLoss(size_t row)
+{
+    losses[row]++;
+    gamesPlayed[row]++;
+}
+
+void PlayerTable::recordDraw(size_t row)
+{
+    draws[row]++;
+    gamesPlayed[row]++;
+}
+
+void PlayerTable::setStats(size_t row, const PlayerStats& stats)
+{
+    gamesPlayed[row] = stats.gamesPlayed;
+    wins[row] = stats.wins;
+    losses[row] = stats.losses;
+    draws[row] = stats.draws;
+}
+
+void PlayerTable::copyValues(size_t row, const PlayerTable& source, size_t sourceRow)
+{
+    ratings[row] = source.ratings[sourceRow];
+    gamesPlayed[row] = source.gamesPlayed[sourceRow];
+    wins[row] = source.wins[sourceRow];
+    losses[row] = source.losses[sourceRow];
+    draws[row] = source.draws[sourceRow];
+}
+
+std::span<const std::string> PlayerTable::getNameColumn() const
+{
+    return names;
+}
+
+std::span<const RatingValue> PlayerTable::getRatingColumn() const
+{
+    return ratings;
+}
+
+std::span<const int> PlayerTable::getGamesPlayedColumn() const
+{
+    return gamesPlayed;
+}
+
+std::span<const int> PlayerTable::getWinsColumn() const
+{
+    return wins;
+}
+
+std::span<const int> PlayerTable::getLossesColumn() const
+{
+    return losses;
+}
+
+std::span<const int> PlayerTable::getDrawsColumn() const
+{
+    return draws;
+}
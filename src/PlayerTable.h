@@ -0,0 +1,193 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef PLAYERTABLE_H
+#define PLAYERTABLE_H
+
+#include "Rating.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * PlayerId
+ *
+ * A player's id is simply their row number in the table
+ * Ids are dense (0, 1, 2, ... in the order players were added)
+ * and never change, so looking a player up by id is a plain array index
+ *
+ * 32 bits is plenty (over 4 billion players) and keeps match records small
+ */
+using PlayerId = std::uint32_t;
+
+/**
+ * Returned in place of an id when no player could be found or created
+ */
+inline constexpr PlayerId InvalidPlayerId = std::numeric_limits<PlayerId>::max();
+
+/**
+ * PlayerStats
+ *
+ * A player's game counters, for example as read from a save file
+ */
+struct PlayerStats
+{
+    int gamesPlayed = 0;
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+
+    /**
+     * True if the counters could have come from recording games:
+     * none is negative, and every game is a win, a loss or a draw
+     */
+    constexpr bool isConsistent() const
+    {
+        return wins >= 0 && losses >= 0 && draws >= 0 &&
+               static_cast<long long>(wins) + losses + draws == gamesPlayed;
+    }
+};
+
+/**
+ * PlayerTable Class
+ *
+ * Stores the data of many players in columns instead of one object per player
+ * This layout is called "structure of arrays":
+ *
+ *   ratings:     [1245.5, 1210.0, 1188.0, ...]   (see Rating.h for the stored form)
+ *   wins:        [10,     7,      3,      ...]
+ *   names:       ["Alice", "Bob", "Chloe", ...]
+ *
+ * Every player is a row number, and row N of every column belongs to the same player
+ *
+ * Why columns?
+ * - Sorting by rating only needs the ratings column, so the CPU reads
+ *   8 bytes per player instead of a whole Player object plus a pointer hop
+ * - Each column is one contiguous block of memory, which the cache and
+ *   the hardware prefetcher handle very well
+ * - Names are only touched when they are actually needed
+ *
+ * Player objects act as a handle (table + row) on top of this storage
+ */
+class PlayerTable
+{
+
+private:
+
+    /**
+     * One entry per player, all indexed by row number
+     */
+    std::vector<std::string> names;
+    std::vector<RatingValue> ratings;
+    std::vector<int> gamesPlayed;
+    std::vector<int> wins;
+    std::vector<int> losses;
+    std::vector<int> draws;
+
+public:
+
+    /**
+     * Append a new player with no games played
+     *
+     * Parameters:
+     *   name - The player's name
+     *   rating - Starting rating, negative values are clamped to 0.0
+     *
+     * Returns: The row number of the new player
+     */
+    size_t addRow(std::string name, double rating);
+
+    /**
+     * Append a player together with their game counters
+     *
+     * Parameters:
+     *   name - The player's name
+     *   rating - Rating, negative values are clamped to 0.0
+     *   stats - Games already played; should be consistent
+     *           (see PlayerStats::isConsistent, callers check it first)
+     *
+     * Used when restoring saved players: one call per player,
+     * however many games they have played
+     *
+     * Returns: The row number of the new player
+     */
+    size_t addRow(std::string name, double rating, const PlayerStats& stats);
+
+    /**
+     * Number of players (rows) in the table
+     */
+    size_t size() const;
+
+    /**
+     * Remove every row
+     */
+    void clear();
+
+    /**
+     * Reserve room for a number of rows so the columns grow only once
+     */
+    void reserve(size_t rowCount);
+
+    /**
+     * Per-row accessors
+     *
+     * row must be smaller than size()
+     */
+    const std::string& getName(size_t row) const;
+    double getRating(size_t row) const;
+    int getGamesPlayed(size_t row) const;
+    int getWins(size_t row) const;
+    int getLosses(size_t row) const;
+    int getDraws(size_t row) const;
+
+    /**
+     * Per-row updates, same meaning as the Player methods of the same name
+     */
+    void updateRating(size_t row, double newRating);
+
+    /**
+     * The rating in its stored form (see Rating.h)
+     *
+     * Used by the match math so that fixed-point ratings
+     * never go through a double
+     */
+    RatingValue getRatingValue(size_t row) const;
+    void updateRatingValue(size_t row, RatingValue newRating);
+    void recordWin(size_t row);
+    void recordLoss(size_t row);
+    void recordDraw(size_t row);
+
+    /**
+     * Set all four game counters of a row at once
+     * stats should be consistent (see PlayerStats::isConsistent)
+     */
+    void setStats(size_t row, const PlayerStats& stats);
+
+    /**
+     * Copy the rating and counters of another table's row into a row
+     *
+     * Names never change once added, so they are left alone
+     * Used to bring a copy of the table up to date row by row
+     * (see RankingSystem::saveToFileAsync and saveDelta)
+     */
+    void copyValues(size_t row, const PlayerTable& source, size_t sourceRow);
+
+    /**
+     * Whole-column views
+     *
+     * std::span is a read-only window onto the column's memory
+     * Useful for code that scans every player, like sorting or saving
+     */
+    std::span<const std::string> getNameColumn() const;
+    std::span<const RatingValue> getRatingColumn() const;
+    std::span<const int> getGamesPlayedColumn() const;
+    std::span<const int> getWinsColumn() const;
+    std::span<const int> getLossesColumn() const;
+    std::span<const int> getDrawsColumn() const;
+
+};
+
+#endif
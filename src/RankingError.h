@@ -0,0 +1,89 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef RANKINGERROR_H
+#define RANKINGERROR_H
+
+#include <cstdint>
+
+/**
+ * RankingError
+ *
+ * Why a RankingSystem operation failed
+ *
+ * The library never prints anything itself
+ * Instead, operations return std::expected<Value, RankingError>
+ * (or just the error), and the caller decides what to show the user
+ * main.cpp turns these into the familiar console messages
+ */
+enum class RankingError : std::uint8_t
+{
+    /**
+     * addPlayer: a player with that name already exists
+     */
+    DuplicatePlayer,
+
+    /**
+     * addPlayer / restorePlayer: the name starts with '#', which the
+     * player file keeps for its own lines (see PlayerCsv)
+     */
+    InvalidName,
+
+    /**
+     * addPlayer / restorePlayer / Player::restore: the rating is NaN,
+     * infinite, or (with fixed-point ratings) too big to store;
+     * see isValidRating
+     */
+    InvalidRating,
+
+    /**
+     * restorePlayer / Player::restore: the game counters do not add up
+     * (a negative counter, or games played != wins + losses + draws)
+     */
+    InconsistentStats,
+
+    /**
+     * rankOf / neighborhood: no player has that id
+     */
+    UnknownPlayer,
+
+    /**
+     * saveToFile / loadFromFile: the file could not be opened
+     */
+    FileOpenFailed,
+
+    /**
+     * saveToFile: the file opened, but writing to it failed (disk full, ...)
+     * The file that was there before is left unchanged
+     */
+    FileWriteFailed,
+
+    /**
+     * loadFromFile / loadSnapshot: the file's checksum does not match
+     * its contents (damaged or cut short); nothing was loaded
+     */
+    ChecksumMismatch,
+
+    /**
+     * loadSnapshot: the file is not a snapshot this version can read,
+     * or its contents do not make sense; nothing was loaded
+     */
+    InvalidSnapshot,
+
+    /**
+     * openMatchLog: the file is not a match log this version can read,
+     * or its records do not fit the players that are loaded
+     * (for example it was written on top of a different save);
+     * nothing was replayed
+     */
+    InvalidMatchLog,
+
+    /**
+     * saveDelta / captureDelta: no snapshot or delta has been saved
+     * or loaded since the players were loaded from CSV (or ever),
+     * so a delta would have nothing to apply to
+     */
+    NoSnapshot
+};
+
+#endif
@@ -2,404 +2,1678 @@
 // Version 1.0
 
 #include "RankingSystem.h"
+#include "AtomicFileWriter.h"
+#include "Crc32.h"
 #include "Match.h"
+#include "MappedFile.h"
+#include "MatchLog.h"
+#include "PlayerCsv.h"
+#include "PlayerSnapshot.h"
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
+#include <future>
+#include <span>
+#include <thread>
+#include <unordered_set>
 
 /**
  * ADD PLAYER
  *
  * Adds a new player to the system
- * Checks if player already exists to prevent duplicates
+ * A new player has no games yet, so this is restorePlayer with empty counters
  */
-void RankingSystem::addPlayer(const std::string& name, double initialRating)
+std::expected<PlayerId, RankingError> RankingSystem::addPlayer(const std::string& name, double initialRating)
 {
+    return restorePlayer(name, initialRating, PlayerStats{});
+}
+
+/**
+ * RESTORE PLAYER
+ *
+ * Adds a player together with their counters
+ * Checks the counters and the name before changing anything
+ */
+std::expected<PlayerId, RankingError> RankingSystem::restorePlayer(std::string_view name, double rating,
+                                                                   const PlayerStats& stats)
+{
+    /**
+     * Step 1: Store the player (see appendPlayer)
+     *
+     * std::expected carries either the new id or the reason it failed
+     */
+    const std::expected<PlayerId, RankingError> id = appendPlayer(name, rating, stats);
+    if (!id)
+    {
+        return id;
+    }
+
+    /**
+     * Step 2: Place the new player on the leaderboard
+     */
+    leaderboard.insert(*id, table.getRatingValue(*id));
+
+    /**
+     * Everyone from the new player's position down moved one place
+     */
+    if (!pageCache.empty())
+    {
+        pageCache.invalidateFrom(leaderboard.positionOf(*id));
+    }
+
+    /**
+     * Step 3: Count the change, and append it to the match log if one is open
+     */
+    changeSequence++;
+    if (matchLog)
+    {
+        matchLog->logPlayer(*id, name, table.getRating(*id), stats);
+    }
+
+    return id;
+}
+
+/**
+ * APPEND PLAYER
+ *
+ * Everything restorePlayer does except the leaderboard:
+ * a load appends every player first and builds the leaderboard
+ * once at the end, which is much faster than n separate inserts
+ */
+std::expected<PlayerId, RankingError> RankingSystem::appendPlayer(std::string_view name, double rating,
+                                                                  const PlayerStats& stats)
+{
+    /**
+     * Step 1: Check the player (see checkNewPlayer)
+     */
+    const std::expected<void, RankingError> valid = checkNewPlayer(name, rating, stats);
+    if (!valid)
+    {
+        return std::unexpected(valid.error());
+    }
+
+    /**
+     * Step 2: Append a row to the table and create its handle
+     *
+     * addRow stores the name, rating and counters in the columns
+     * and returns the row number
+     * emplace_back constructs the Player handle in place from (table, row)
+     */
+    const size_t row = table.addRow(std::string(name), rating, stats);
+    players.emplace_back(table, row);
+
+    /**
+     * Step 3: Register the new player in the name index
+     */
+    nameIndex.emplace(table.getName(row), row);
+
+    /**
+     * The row number is the player's id
+     */
+    return static_cast<PlayerId>(row);
+}
+
+/**
+ * CHECK NEW PLAYER
+ *
+ * The counters, the name, the rating, and whether the player already exists
+ *
+ * A name starting with '#' could be mistaken for one of the
+ * player file's own lines (see PlayerCsv::ReservedMark)
+ * A NaN rating compares false with everything, which would break
+ * the leaderboard's ordering, infinity is no rating either, and in
+ * fixed-point mode the rating must fit (see isValidRating)
+ * The name index holds every name already taken
+ *
+ * std::unexpected wraps the error so it converts to the expected return type
+ */
+std::expected<void, RankingError> RankingSystem::checkNewPlayer(std::string_view name, double rating,
+                                                                const PlayerStats& stats) const
+{
+    if (!stats.isConsistent())
+    {
+        return std::unexpected(RankingError::InconsistentStats);
+    }
+    if (name.starts_with(PlayerCsv::ReservedMark))
+    {
+        return std::unexpected(RankingError::InvalidName);
+    }
+    if (!isValidRating(rating))
+    {
+        return std::unexpected(RankingError::InvalidRating);
+    }
+    if (nameIndex.contains(name))
+    {
+        return std::unexpected(RankingError::DuplicatePlayer);
+    }
+
+    return {};
+}
+
+/**
+ * FIND PLAYER
+ *
+ * Searches for a player by name
+ * Uses the name index (a hash table), so this is O(1) on average
+ * instead of comparing the name against every player
+ */
+const Player* RankingSystem::findPlayer(std::string_view name) const
+{
+    /**
+     * find() accepts the string_view directly because NameHash and
+     * std::equal_to<> are transparent - no std::string is constructed
+     */
+    const auto it = nameIndex.find(name);
+
+    if (it == nameIndex.end())
+    {
+        return nullptr;
+    }
+
+    /**
+     * The index stores the row, and players[row] is that row's handle
+     */
+    return &players[it->second];
+}
+
+/**
+ * FIND PLAYER ID
+ *
+ * Same lookup as findPlayer, but returns the id instead of a pointer
+ */
+PlayerId RankingSystem::findPlayerId(std::string_view name) const
+{
+    const auto it = nameIndex.find(name);
+
+    if (it == nameIndex.end())
+    {
+        return InvalidPlayerId;
+    }
+
+    return static_cast<PlayerId>(it->second);
+}
+
+/**
+ * HAS PLAYER
+ *
+ * Ids are dense, so every id below the player count is valid
+ * InvalidPlayerId is the largest possible value, so it always fails this check
+ */
+bool RankingSystem::hasPlayer(PlayerId id) const
+{
+    return id < table.size();
+}
+
+/**
+ * GET PLAYER
+ *
+ * The id is the row number, and players[row] is that row's handle
+ */
+const Player& RankingSystem::getPlayer(PlayerId id) const
+{
+    return players[id];
+}
+
+/**
+ * RECORD MATCH (by name)
+ *
+ * Records a match between two players and updates their ratings
+ *
+ * Used by the menu in main.cpp, where the user types names
+ * It only resolves the names; the id-based overload does the real work
+ */
+MatchStatus RankingSystem::recordMatch(std::string_view name1, std::string_view name2, const int result)
+{
+    /**
+     * Step 1: Find both players' ids
+     */
+    const PlayerId id1 = findPlayerId(name1);
+    const PlayerId id2 = findPlayerId(name2);
+
+    /**
+     * Step 2: Validate both players exist
+     *
+     * We need to check both before proceeding
+     * The caller can use findPlayerId to tell which name was wrong
+     */
+    if (id1 == InvalidPlayerId || id2 == InvalidPlayerId)
+    {
+        return MatchStatus::UnknownPlayer;
+    }
+
+    /**
+     * Step 3: Convert the integer result
+     *
+     * As before, anything other than 1 or -1 counts as a draw
+     */
+    MatchResult outcome = MatchResult::Draw;
+    if (result == 1)
+    {
+        outcome = MatchResult::Player1Wins;
+    }
+    else if (result == -1)
+    {
+        outcome = MatchResult::Player2Wins;
+    }
+
+    /**
+     * Step 4: Record the match by id
+     */
+    return recordMatch(id1, id2, outcome);
+}
+
+/**
+ * RECORD MATCH (by id)
+ *
+ * The hot path for callers that already know the ids
+ * Everything here is an array index into the table's columns
+ */
+MatchStatus RankingSystem::recordMatch(PlayerId id1, PlayerId id2, MatchResult result, double kFactor)
+{
+    /**
+     * Step 1: Validate the ids, the result and the K-factor
+     *
+     * Playing against yourself would update the same row twice
+     * The result may come from a network message, so check it is -1, 0 or 1
+     * A NaN or infinite K would turn both ratings into NaN or infinity,
+     * and a negative one would reward the loser
+     * In fixed-point mode K is converted like a rating, so it must not
+     * be above MaxRating either (the comparisons also fail for NaN)
+     */
+    if (!hasPlayer(id1) || !hasPlayer(id2))
+    {
+        return MatchStatus::UnknownPlayer;
+    }
+    if (id1 == id2)
+    {
+        return MatchStatus::SamePlayer;
+    }
+    if (result != MatchResult::Player1Wins && result != MatchResult::Draw &&
+        result != MatchResult::Player2Wins)
+    {
+        return MatchStatus::InvalidResult;
+    }
+    if (!(kFactor > 0.0 && kFactor <= MaxRating))
+    {
+        return MatchStatus::InvalidKFactor;
+    }
+
+    /**
+     * Step 2: Run the Elo math on the current ratings
+     */
+    const int resultCode = static_cast<int>(result);
+    const Match::RatingValueUpdate update = Match::calculateNewRatingValues(
+        table.getRatingValue(id1), table.getRatingValue(id2), resultCode, kFactor, expectedScoreMode);
+
+    /**
+     * Step 3: Add the match to the history and both new ratings to the
+     * timeline, if they are kept, while the ratings before it are
+     * still in the table
+     *
+     * The clock is only read when one of them is on
+     */
+    const std::int64_t now = (matchHistory || ratingTimeline) ?
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() : 0;
+
+    if (matchHistory)
+    {
+        const double rating1 = table.getRating(id1);
+        const double rating2 = table.getRating(id2);
+
+        MatchHistoryEntry entry;
+        entry.timestamp = now;
+        entry.player1 = id1;
+        entry.player2 = id2;
+        entry.result = result;
+        entry.rating1 = rating1;
+        entry.rating2 = rating2;
+        entry.change1 = fromRatingValue(update.newRating1) - rating1;
+        entry.change2 = fromRatingValue(update.newRating2) - rating2;
+        matchHistory->append(entry);
+    }
+
+    if (ratingTimeline)
+    {
+        ratingTimeline->append(id1, now, fromRatingValue(update.newRating1));
+        ratingTimeline->append(id2, now, fromRatingValue(update.newRating2));
+    }
+
+    /**
+     * Step 4: Store the result, the new ratings and the new positions
+     */
+    applyMatch(id1, id2, result, update.newRating1, update.newRating2);
+
+    /**
+     * Step 5: Append the outcome to the match log, if one is open
+     */
+    if (matchLog)
+    {
+        matchLog->logMatch(id1, id2, result, fromRatingValue(update.newRating1), fromRatingValue(update.newRating2));
+    }
+
+    return MatchStatus::Recorded;
+}
+
+/**
+ * APPLY MATCH
+ *
+ * Everything a match changes, once its new ratings are known
+ * Shared by recordMatch and match log replay
+ */
+void RankingSystem::applyMatch(PlayerId id1, PlayerId id2, MatchResult result,
+                               RatingValue newRating1, RatingValue newRating2)
+{
+    /**
+     * Step 1: Record the result in both rows
+     */
+    switch (result)
+    {
+        case MatchResult::Player1Wins:
+            table.recordWin(id1);
+            table.recordLoss(id2);
+            break;
+        case MatchResult::Player2Wins:
+            table.recordLoss(id1);
+            table.recordWin(id2);
+            break;
+        case MatchResult::Draw:
+            table.recordDraw(id1);
+            table.recordDraw(id2);
+            break;
+    }
+
+    /**
+     * Step 2: Store the new ratings, and note both rows for the
+     * next background save and the next delta
+     */
+    table.updateRatingValue(id1, newRating1);
+    table.updateRatingValue(id2, newRating2);
+
+    markChanged(id1);
+    markChanged(id2);
+
+    /**
+     * Step 3: Move both players to their new leaderboard positions
+     *
+     * If pages are cached, note where both players were and where they
+     * end up: only the positions between those can show anything new
+     * (the two rows themselves, and the players they moved past)
+     */
+    const bool pagesCached = !pageCache.empty();
+    const size_t oldPosition1 = pagesCached ? leaderboard.positionOf(id1) : 0;
+    const size_t oldPosition2 = pagesCached ? leaderboard.positionOf(id2) : 0;
+
+    leaderboard.update(id1, newRating1);
+    leaderboard.update(id2, newRating2);
+
+    if (pagesCached)
+    {
+        const size_t newPosition1 = leaderboard.positionOf(id1);
+        const size_t newPosition2 = leaderboard.positionOf(id2);
+        pageCache.invalidatePositions(std::min(oldPosition1, newPosition1), std::max(oldPosition1, newPosition1));
+        pageCache.invalidatePositions(std::min(oldPosition2, newPosition2), std::max(oldPosition2, newPosition2));
+    }
+
+    changeSequence++;
+}
+
+/**
+ * RECORD MATCHES (batch)
+ *
+ * Applies every record in order through the id-based recordMatch
+ * Later matches see the ratings produced by earlier ones,
+ * exactly as if they had been recorded one at a time
+ */
+std::vector<MatchStatus> RankingSystem::recordMatches(std::span<const MatchRecord> matches)
+{
+    /**
+     * One allocation for the whole batch
+     */
+    std::vector<MatchStatus> statuses;
+    statuses.reserve(matches.size());
+
+    for (const MatchRecord& match : matches)
+    {
+        /**
+         * A K-factor of 0 means the record did not ask for a specific one
+         * Anything else goes through as it is, so recordMatch rejects
+         * a negative, NaN or infinite K like it would for a single match
+         */
+        const double kFactor = match.kFactor == 0.0f ? Match::DefaultKFactor : match.kFactor;
+
+        statuses.push_back(recordMatch(match.player1, match.player2, match.result, kFactor));
+    }
+
+    return statuses;
+}
+
+/**
+ * EXPECTED SCORE MODE
+ *
+ * Only affects matches recorded after the call
+ */
+void RankingSystem::setExpectedScoreMode(ExpectedScoreMode mode)
+{
+    expectedScoreMode = mode;
+}
+
+ExpectedScoreMode RankingSystem::getExpectedScoreMode() const
+{
+    return expectedScoreMode;
+}
+
+void RankingSystem::enableMatchHistory()
+{
+    if (!matchHistory)
+    {
+        matchHistory = std::make_unique<MatchHistory>();
+    }
+}
+
+const MatchHistory* RankingSystem::getMatchHistory() const
+{
+    return matchHistory.get();
+}
+
+void RankingSystem::enableRatingTimeline()
+{
+    if (!ratingTimeline)
+    {
+        ratingTimeline = std::make_unique<RatingTimeline>();
+    }
+}
+
+const RatingTimeline* RankingSystem::getRatingTimeline() const
+{
+    return ratingTimeline.get();
+}
+
+/**
+ * RENDER ROW
+ *
+ * Reads the row straight from the table's columns
+ */
+void RankingSystem::renderRow(PlayerId id) const
+{
+    renderer.appendRow(table.getName(id), table.getRating(id), table.getGamesPlayed(id),
+                       table.getWins(id), table.getLosses(id), table.getDraws(id));
+}
+
+/**
+ * DISPLAY LEADERBOARD
+ *
+ * Shows all players sorted by rating (highest first)
+ * Displays in a nice formatted table
+ * Players with equal ratings are listed in the order they were added
+ */
+void RankingSystem::displayLeaderboard(std::ostream& out) const
+{
+    /**
+     * Step 1: Check if there are any players
+     */
+    if (players.empty())
+    {
+        out << "No players in the system.\n";
+        return;
+    }
+
+    /**
+     * Step 2: Title and column header
+     */
+    renderer.clear();
+    renderer.appendText("\n========== LEADERBOARD ==========\n");
+    renderer.appendHeader();
+
+    /**
+     * Step 3: One line per player, in leaderboard order
+     *
+     * The leaderboard index is kept sorted by every addPlayer and
+     * recordMatch, so nothing has to be sorted here:
+     * visitInOrder just walks the tree from the top
+     *
+     * Whenever the buffer fills up, it goes to the stream in one write
+     */
+    leaderboard.visitInOrder(
+        [&](PlayerId id)
+        {
+            renderRow(id);
+            if (renderer.full())
+            {
+                renderer.writeTo(out);
+            }
+            return true;
+        });
+
+    /**
+     * Step 4: Footer, and write whatever is left
+     */
+    renderer.appendText("=================================\n\n");
+    renderer.writeTo(out);
+}
+
+/**
+ * MAKE ROW
+ */
+LeaderboardRow RankingSystem::makeRow(size_t rank, PlayerId id) const
+{
+    return LeaderboardRow{
+        rank,
+        id,
+        table.getName(id),
+        table.getRating(id),
+        table.getGamesPlayed(id),
+        table.getWins(id),
+        table.getLosses(id),
+        table.getDraws(id)
+    };
+}
+
+/**
+ * LEADERBOARD PAGE
+ *
+ * Read the ids for the window from the leaderboard index,
+ * then copy each player's columns into a row
+ */
+std::vector<LeaderboardRow> RankingSystem::getLeaderboardPage(size_t offset, size_t limit) const
+{
+    const std::vector<PlayerId> ids = leaderboard.range(offset, limit);
+
+    std::vector<LeaderboardRow> rows;
+    rows.reserve(ids.size());
+
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        rows.push_back(makeRow(offset + i + 1, ids[i]));
+    }
+
+    return rows;
+}
+
+/**
+ * TOP K
+ *
+ * The leaderboard index is already in order, so the top k players
+ * are simply the first k visited
+ * With a filter, players without enough games are passed over
+ * (they still count for the rank of the players behind them)
+ */
+std::vector<LeaderboardRow> RankingSystem::topK(size_t k, int minGames) const
+{
+    std::vector<LeaderboardRow> rows;
+    if (k == 0)
+    {
+        return rows;
+    }
+    rows.reserve(std::min(k, leaderboard.size()));
+
+    const std::span<const int> games = table.getGamesPlayedColumn();
+    size_t position = 0;
+
+    leaderboard.visitInOrder(
+        [&](PlayerId id)
+        {
+            position++;
+            if (games[id] >= minGames)
+            {
+                rows.push_back(makeRow(position, id));
+            }
+            return rows.size() < k;
+        });
+
+    return rows;
+}
+
+/**
+ * LEADERBOARD PAGE TEXT
+ *
+ * Step 1: Serve the page from the cache if it is still valid
+ * Step 2: Otherwise render it the same way displayLeaderboard does
+ * Step 3: Store it so the next request is a cache hit
+ */
+const std::string& RankingSystem::getLeaderboardPageText(size_t page, size_t pageSize) const
+{
+    static const std::string emptyPage;
+
+    if (page == 0 || pageSize == 0)
+    {
+        return emptyPage;
+    }
+
+    /**
+     * Round the page count up without adding pageSize - 1 first,
+     * which would wrap around for a huge pageSize
+     */
+    const size_t pageCount = leaderboard.size() / pageSize + (leaderboard.size() % pageSize != 0);
+    if (page - 1 >= pageCount)
+    {
+        return emptyPage;
+    }
+
+    if (const std::string* cached = pageCache.find(page, pageSize))
+    {
+        return *cached;
+    }
+
+    renderer.clear();
+    renderer.appendHeader();
+    for (const PlayerId id : leaderboard.range((page - 1) * pageSize, pageSize))
+    {
+        renderRow(id);
+    }
+
+    return pageCache.store(page, pageSize, std::string(renderer.text()));
+}
+
+/**
+ * RANK OF
+ *
+ * The index counts positions from 0, people count ranks from 1
+ */
+std::expected<size_t, RankingError> RankingSystem::rankOf(PlayerId id) const
+{
+    if (!hasPlayer(id))
+    {
+        return std::unexpected(RankingError::UnknownPlayer);
+    }
+
+    return leaderboard.positionOf(id) + 1;
+}
+
+/**
+ * NEIGHBORHOOD
+ *
+ * Find the player's position, step back radius places
+ * (but not past the top), then read one window of the leaderboard
+ */
+std::expected<std::vector<PlayerId>, RankingError> RankingSystem::neighborhood(PlayerId id, size_t radius) const
+{
+    if (!hasPlayer(id))
+    {
+        return std::unexpected(RankingError::UnknownPlayer);
+    }
+
+    /**
+     * No window is wider than the leaderboard, and clamping radius
+     * to it keeps position - first + radius + 1 from wrapping around
+     */
+    radius = std::min(radius, leaderboard.size());
+
+    const size_t position = leaderboard.positionOf(id);
+    const size_t first = position > radius ? position - radius : 0;
+
+    return leaderboard.range(first, position - first + radius + 1);
+}
+
+/**
+ * SAVE TO FILE
+ *
+ * Saves all player data to a CSV file
+ * Format: Name,Rating,GamesPlayed,Wins,Losses,Draws
+ *
+ * The data goes to a temporary file first, which then replaces the
+ * real one in one step (see AtomicFileWriter), so a crash during the
+ * save never destroys the previous file
+ */
+std::expected<void, RankingError> RankingSystem::saveToFile(const std::string& filename,
+                                                            FileChecksum checksum) const
+{
+    /**
+     * A background save may be writing the same temporary file,
+     * so it has to finish first
+     */
+    if (runningSave.valid())
+    {
+        runningSave.wait();
+    }
+
+    return writeCsv(table, filename, checksum, changeSequence);
+}
+
+/**
+ * SAVE TO FILE IN THE BACKGROUND
+ *
+ * Same file as saveToFile, written from the save copy on another thread
+ * See the header for why the copy is only partly refreshed
+ */
+std::shared_future<std::expected<void, RankingError>> RankingSystem::saveToFileAsync(
+    const std::string& filename, FileChecksum checksum)
+{
+    /**
+     * Step 1: The copy may still be in use by the previous save
+     */
+    if (runningSave.valid())
+    {
+        runningSave.wait();
+    }
+
+    /**
+     * Step 2: Bring the copy up to date
+     *
+     * The first time, the whole table is copied and tracking starts
+     * After that: the rows changed since, then the players added since
+     * (their names are copied once; names never change afterwards)
+     */
+    if (!saveCopy)
+    {
+        saveCopy = std::make_shared<PlayerTable>(table);
+    }
+    else
+    {
+        for (const PlayerId id : saveCopyRows.rows())
+        {
+            saveCopy->copyValues(id, table, id);
+        }
+
+        for (size_t row = saveCopy->size(); row < table.size(); row++)
+        {
+            saveCopy->addRow(table.getName(row), 0.0);
+            saveCopy->copyValues(row, table, row);
+        }
+    }
+    saveCopyRows.start(table.size());
+
+    /**
+     * Step 3: Write it on another thread
+     *
+     * The task holds its own reference to the copy, so the copy lives
+     * until the file is written even if a load drops it meanwhile
+     * The copy includes the changes up to now, so the sequence is taken now too
+     */
+    std::shared_ptr<const PlayerTable> copy = saveCopy;
+    runningSave = std::async(std::launch::async,
+        [copy = std::move(copy), filename, checksum, sequence = changeSequence]()
+        {
+            return writeCsv(*copy, filename, checksum, sequence);
+        }).share();
+
+    return runningSave;
+}
+
+/**
+ * Either list ignores the call while it is not tracking
+ */
+void RankingSystem::markChanged(PlayerId id)
+{
+    saveCopyRows.mark(id);
+    deltaRows.mark(id);
+}
+
+void RankingSystem::dropSaveCopy()
+{
+    saveCopy.reset();
+    saveCopyRows.stop();
+}
+
+/**
+ * WRITE CSV
+ *
+ * The rows of one table, in the saveToFile format
+ */
+std::expected<void, RankingError> RankingSystem::writeCsv(const PlayerTable& source, const std::string& filename,
+                                                          FileChecksum checksum, std::uint64_t sequence)
+{
+    /**
+     * Step 1: Create the temporary file
+     *
+     * The real file is not touched until the very end
+     */
+    AtomicFileWriter file(filename);
+
+    /**
+     * Step 2: Check if file opened successfully
+     *
+     * If file can't be opened, report it to the caller
+     * Common reasons: permission denied, invalid path
+     */
+    if (!file.isOpen())
+    {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    /**
+     * Step 3: Write each player as one line
+     *
+     * Format: Name,Rating,GamesPlayed,Wins,Losses,Draws
+     *
+     * PlayerCsv::appendRow formats a line into an in-memory buffer
+     * (the rating with full round-trip precision), and the buffer goes
+     * to the file in big blocks instead of one stream operation per field
+     *
+     * The checksum is carried along block by block, so the data
+     * is only read once; with a checksum the file starts with
+     * PlayerCsv::ChecksumHeader, which promises the checksum line
+     *
+     * The rows are written in table order, reading each column front to back
+     */
+    std::string buffer;
+    buffer.reserve(PlayerCsv::WriteBlockSize + 256);
+    std::uint32_t crc = 0;
+
+    if (checksum == FileChecksum::Crc32Footer)
+    {
+        buffer.append(PlayerCsv::ChecksumHeader);
+        buffer.push_back('\n');
+    }
+
+    for (size_t row = 0; row < source.size(); row++)
+    {
+        PlayerCsvRow line;
+        line.name = source.getName(row);
+        line.rating = source.getRating(row);
+        line.gamesPlayed = source.getGamesPlayed(row);
+        line.wins = source.getWins(row);
+        line.losses = source.getLosses(row);
+        line.draws = source.getDraws(row);
+        PlayerCsv::appendRow(buffer, line);
+
+        if (buffer.size() >= PlayerCsv::WriteBlockSize)
+        {
+            if (checksum == FileChecksum::Crc32Footer)
+            {
+                crc = Crc32::update(crc, buffer);
+            }
+            if (!file.write(buffer))
+            {
+                return std::unexpected(RankingError::FileWriteFailed);
+            }
+            buffer.clear();
+        }
+    }
+
+    /**
+     * Step 4: The last partial block and the sequence line,
+     * followed by the checksum line (which covers the sequence too)
+     */
+    PlayerCsv::appendSequence(buffer, sequence);
+    if (checksum == FileChecksum::Crc32Footer)
+    {
+        crc = Crc32::update(crc, buffer);
+        PlayerCsv::appendChecksum(buffer, crc);
+    }
+    if (!file.write(buffer))
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
+
+    /**
+     * Step 5: Make sure everything actually reached the disk,
+     * then put the new file in place of the old one
+     *
+     * If this fails (for example the disk is full), the old file
+     * is still there, and the temporary file is deleted when
+     * the writer goes out of scope (RAII)
+     */
+    if (!file.commit())
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
+
+    return {};
+}
+
+/**
+ * LOAD FROM FILE
+ *
+ * Loads player data from a CSV file
+ * Parses each line and reconstructs Player objects
+ */
+std::expected<size_t, RankingError> RankingSystem::loadFromFile(const std::string& filename, unsigned threadCount)
+{
+    /**
+     * Step 1: Map the whole file into memory
+     *
+     * MappedFile gives us the file as one block of text
+     * (see MappedFile.h), instead of reading it line by line
+     */
+    const MappedFile file(filename);
+
+    /**
+     * Step 2: Check if file exists/opened
+     *
+     * If file doesn't exist, keep the current players
+     * Don't crash, just tell the caller
+     */
+    if (!file.isOpen()) {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    /**
+     * Step 2b: Check the checksum line, if the file has one
+     *
+     * A damaged or cut-off file is refused before anything is cleared,
+     * so the current players stay as they are
+     * The checksum lines are not part of the rows,
+     * and neither is the sequence line
+     */
+    std::string_view text = file.text();
+    if (!PlayerCsv::verifyChecksum(text))
+    {
+        return std::unexpected(RankingError::ChecksumMismatch);
+    }
+    std::uint64_t savedSequence = 0;
+    const bool hasSequence = PlayerCsv::readSequence(text, savedSequence);
+
+    /**
+     * Step 3: Clear existing players
+     *
+     * clear() removes all rows from the table and all handles
+     * The name index and the leaderboard refer to rows, so they are cleared too
+     */
+    players.clear();
+    table.clear();
+    nameIndex.clear();
+    leaderboard.clear();
+    pageCache.clear();
+    dropSaveCopy();
+    if (matchHistory)
+    {
+        matchHistory->clear();
+    }
+    if (ratingTimeline)
+    {
+        ratingTimeline->clear();
+    }
+    deltaRows.stop();
+
+    /**
+     * Step 4: Make room for every player up front
+     *
+     * Counting line breaks is a single fast pass over the text,
+     * and it saves the columns and the hash table from growing
+     * (and copying themselves) over and over while we load
+     */
+    const size_t lineCount = static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+    table.reserve(lineCount);
+    nameIndex.reserve(lineCount);
+
+    /**
+     * Step 5: Cut the text into one piece per thread
+     *
+     * 0 means "one thread per CPU core"
+     * Each piece ends at a line break, so pieces can be parsed on their own
+     */
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::vector<std::string_view> chunks = PlayerCsv::splitChunks(text, threadCount);
+
+    /**
+     * Step 6: Parse the pieces in parallel
+     *
+     * std::async(std::launch::async, ...) runs the lambda on a new thread
+     * and returns a std::future, which hands over the result when it is done
+     *
+     * Every piece gets its own vector of rows, so the threads never share
+     * anything they write to; the rows only point into the mapped text
+     * The first piece is parsed right here in Step 7, straight into the
+     * system, so with one thread nothing is buffered at all
+     */
+    const auto parseChunk = [](std::string_view chunk)
+    {
+        std::vector<PlayerCsvRow> rows;
+        PlayerCsv::forEachRow(chunk,
+            [&rows](const PlayerCsvRow& row)
+            {
+                rows.push_back(row);
+            });
+        return rows;
+    };
+
+    std::vector<std::future<std::vector<PlayerCsvRow>>> parsed;
+    for (size_t i = 1; i < chunks.size(); i++)
+    {
+        parsed.push_back(std::async(std::launch::async, parseChunk, chunks[i]));
+    }
+
+    /**
+     * Step 7: Add the players, piece by piece in file order
+     *
+     * While piece 1 is being added, the later pieces are still parsing
+     * Going in file order keeps ids in file order, and means that of two
+     * rows with the same name, the first one in the file wins
+     *
+     * appendPlayer refuses four kinds of rows, which are skipped:
+     * - A name that is already loaded (saveToFile never writes
+     *   duplicates; this only guards against hand-edited files)
+     * - A name starting with '#' (a line of the file's own)
+     * - A rating that is not valid (see isValidRating)
+     * - Counters that do not add up, such as games played not
+     *   being wins + losses + draws
+     *
+     * The counters are stored directly: one call per player,
+     * no matter how many games they have played
+     */
+    const auto addRow = [this](const PlayerCsvRow& row)
+    {
+        const PlayerStats stats{row.gamesPlayed, row.wins, row.losses, row.draws};
+        (void)appendPlayer(row.name, row.rating, stats);
+    };
+
+    if (!chunks.empty())
+    {
+        PlayerCsv::forEachRow(chunks[0], addRow);
+    }
+    for (std::future<std::vector<PlayerCsvRow>>& rows : parsed)
+    {
+        for (const PlayerCsvRow& row : rows.get())
+        {
+            addRow(row);
+        }
+    }
+
     /**
-     * Step 1: Check if player already exists
-     *
-     * findPlayer returns nullptr if not found
-     * So if we get a non-nullptr, player exists
+     * Step 8: Build the leaderboard for everyone at once
      */
-    if (findPlayer(name) != nullptr)
-        {
-        std::cout << "Player '" << name << "' already exists!\n";
-        return;
-    }
+    leaderboard.build(table.getRatingColumn());
 
     /**
-     * Step 2: Create new Player with smart pointer
-     *
-     * std::make_unique<Player>(name, initialRating)
-     * - Creates a new Player object on the heap
-     * - Wraps it in a unique_ptr for automatic cleanup
-     * - Arguments are passed to Player's constructor
+     * Step 9: The sequence line says how many logged changes the
+     * players contain, so the next match log opened skips those
+     * Without it (an older file) the next log is taken as it is
      */
-    players.push_back(std::make_unique<Player>(name, initialRating));
+    changeSequence = hasSequence ? savedSequence : 0;
+    sequenceUnknown = !hasSequence;
 
-    std::cout << "Player '" << name << "' added successfully!\n";
+    return table.size();
 }
 
 /**
- * FIND PLAYER
- *
- * Searches for a player by name
- * Uses linear search (O(n)) through the vector
+ * SAVE SNAPSHOT
  *
- * For small systems this is fine
- * For large systems, consider using std::map<string, unique_ptr<Player>>
+ * Saves all player data, and the leaderboard order, to a binary file
+ * Same crash safety as saveToFile (see AtomicFileWriter)
  */
-Player* RankingSystem::findPlayer(const std::string& name)
+std::expected<void, RankingError> RankingSystem::saveSnapshot(const std::string& filename,
+                                                              FileChecksum checksum)
 {
     /**
-     * Range-based for loop: for (auto& item : container)
-     *
-     * auto& means "deduce the type and get a reference"
-     * player is a unique_ptr<Player>&
+     * Step 1: Create the temporary file
+     */
+    AtomicFileWriter file(filename);
+    if (!file.isOpen())
+    {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    /**
+     * Step 2: Write the players and the leaderboard order
      *
-     * The & is important - we don't want to copy the unique_ptr!
+     * The order is what lets loadSnapshot skip sorting
      */
-    for (auto& player : players)
-        {
-        /**
-         * player->getName() accesses the Player object through the pointer
-         * The -> operator is used because player is a pointer type
-         */
-        if (player->getName() == name)
-            {
-            /**
-             * player.get() extracts the raw pointer from the unique_ptr
-             * This returns a Player* without releasing ownership
-             * The unique_ptr still owns the object
-             */
-            return player.get();
-        }
+    const std::vector<PlayerId> order = leaderboard.range(0, leaderboard.size());
+    if (!PlayerSnapshot::write(file, table, order, changeSequence, checksum))
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
+
+    /**
+     * Step 3: Put the new file in place of the old one
+     */
+    if (!file.commit())
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
     }
-    return nullptr;
+
+    /**
+     * Step 4: The next delta builds on this snapshot
+     */
+    startDelta();
+
+    return {};
 }
 
 /**
- * RECORD MATCH
- *
- * Records a match between two players and updates their ratings
+ * LOAD SNAPSHOT
  *
- * This is the orchestration method that brings Player and Match together
+ * Loads player data from a file written by saveSnapshot
  */
-void RankingSystem::recordMatch(const std::string& name1, const std::string& name2, const int result)
+std::expected<size_t, RankingError> RankingSystem::loadSnapshot(const std::string& filename)
 {
     /**
-     * Step 1: Find both players
+     * Step 1: Map the file and check it
+     *
+     * PlayerSnapshot::open looks at every section before anything
+     * is used, so a bad file is refused here
      */
-    Player* p1 = findPlayer(name1);
-    Player* p2 = findPlayer(name2);
+    const MappedFile file(filename);
+    if (!file.isOpen())
+    {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    const std::expected<PlayerSnapshot, RankingError> snapshot = PlayerSnapshot::open(file.text());
+    if (!snapshot)
+    {
+        return std::unexpected(snapshot.error());
+    }
+    if (snapshot->isDelta())
+    {
+        return std::unexpected(RankingError::InvalidSnapshot);
+    }
 
     /**
-     * Step 2: Validate both players exist
+     * Step 2: Fill a new table and name index
      *
-     * We need to check both before proceeding
-     * Print helpful error message if either is missing
+     * The records are copied straight into the columns; the only
+     * per-player work left is storing the name and hashing it
+     * They go into new containers first: if two players turn out to
+     * have the same name, the file is refused and the current
+     * players are still untouched
      */
-    if (p1 == nullptr)
+    const size_t count = snapshot->size();
+
+    PlayerTable loadedTable;
+    loadedTable.reserve(count);
+    decltype(nameIndex) loadedIndex;
+    loadedIndex.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
     {
-        std::cout << "Player '" << name1 << "' not found!\n";
-        return;
+        const size_t row = loadedTable.addRow(std::string(snapshot->name(i)), snapshot->record(i).rating,
+                                              snapshot->stats(i));
+
+        if (!loadedIndex.emplace(loadedTable.getName(row), row).second)
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+    }
+
+    /**
+     * Step 3: Replace the current players
+     *
+     * The Player handles point at the table member, so they are
+     * created after the new table has moved into place
+     */
+    table = std::move(loadedTable);
+    nameIndex = std::move(loadedIndex);
+    dropSaveCopy();
+    if (matchHistory)
+    {
+        matchHistory->clear();
     }
-    if (p2 == nullptr)
+    if (ratingTimeline)
     {
-        std::cout << "Player '" << name2 << "' not found!\n";
-        return;
+        ratingTimeline->clear();
+    }
+    pageCache.clear();
+
+    players.clear();
+    for (size_t row = 0; row < count; row++)
+    {
+        players.emplace_back(table, row);
     }
 
     /**
-     * Step 3: Create a Match object
+     * Step 4: Rebuild the leaderboard from the saved order
      *
-     * We dereference the pointers (*p1, *p2) because:
-     * - Match constructor expects references (Player&)
-     * - We have pointers (Player*)
-     * - * converts pointer to reference
+     * build checks the order in one pass and only sorts
+     * if it does not fit the ratings
      */
-    Match match(*p1, *p2, result);
+    leaderboard.build(table.getRatingColumn(), snapshot->leaderboardOrder());
+
+    changeSequence = snapshot->logSequence();
+    sequenceUnknown = false;
+    startDelta();
+
+    return count;
+}
+
+/**
+ * SAVE DELTA
+ *
+ * Saves the players changed since the last snapshot or delta
+ * Same crash safety as saveSnapshot
+ */
+std::expected<size_t, RankingError> RankingSystem::saveDelta(const std::string& filename, FileChecksum checksum)
+{
+    if (!deltaRows.isTracking())
+    {
+        return std::unexpected(RankingError::NoSnapshot);
+    }
 
     /**
-     * Step 4: Process the match
-     *
-     * This runs the Elo formula and updates both players
+     * The changes are only forgotten once the delta is safely on disk
      */
-    match.processMatch();
+    const SnapshotCapture delta = makeDelta();
+    const std::expected<void, RankingError> saved = PlayerSnapshot::save(filename, delta, checksum);
+    if (!saved)
+    {
+        return std::unexpected(saved.error());
+    }
 
-    std::cout << "Match recorded successfully!\n";
+    startDelta();
+    return delta.table.size();
 }
 
 /**
- * DISPLAY LEADERBOARD
+ * LOAD DELTA
  *
- * Shows all players sorted by rating (highest first)
- * Displays in a nice formatted table
+ * Applies a delta written by saveDelta to the current players
  */
-void RankingSystem::displayLeaderboard() const
+std::expected<size_t, RankingError> RankingSystem::loadDelta(const std::string& filename)
 {
     /**
-     * Step 1: Check if there are any players
+     * Step 1: Map the file and check it, as loadSnapshot does
      */
-    if (players.empty())
+    const MappedFile file(filename);
+    if (!file.isOpen())
     {
-        std::cout << "No players in the system.\n";
-        return;
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+
+    const std::expected<PlayerSnapshot, RankingError> delta = PlayerSnapshot::open(file.text());
+    if (!delta)
+    {
+        return std::unexpected(delta.error());
     }
 
     /**
-     * Step 2: Create temporary vector of raw pointers
-     *
-     * We create a vector of raw pointers for sorting
-     * This way we don't modify the main vector
+     * Step 2: It must start where the players are now
+     */
+    if (!delta->isDelta() || sequenceUnknown || delta->baseSequence() != changeSequence)
+    {
+        return std::unexpected(RankingError::InvalidSnapshot);
+    }
+
+    /**
+     * Step 3: Check every player before changing any
      *
-     * Why not sort players directly?
-     * - unique_ptr can't be copied, only moved
-     * - unique_ptr can't be used in certain algorithms
-     * - Easier to sort raw pointers
+     * A known id is an update; anything else must be the next new
+     * player (ids increase, so they come last, in order) that
+     * appendPlayer accepts, with a name nobody else in the delta has
      */
-    std::vector<Player*> sortedPlayers;
+    const size_t count = delta->size();
+    size_t nextId = table.size();
+    std::unordered_set<std::string_view> newNames;
 
-    for (const auto& player : players)
+    for (size_t i = 0; i < count; i++)
     {
-        /**
-         * .get() extracts raw pointer from unique_ptr
-         */
-        sortedPlayers.push_back(player.get());
+        const PlayerId id = delta->playerId(i);
+        if (id < table.size())
+        {
+            continue;
+        }
+        if (id != nextId || !checkNewPlayer(delta->name(i), delta->record(i).rating, delta->stats(i)) ||
+            !newNames.insert(delta->name(i)).second)
+        {
+            return std::unexpected(RankingError::InvalidSnapshot);
+        }
+        nextId++;
     }
 
     /**
-     * Step 3: Sort by rating in descending order
-     *
-     * std::sort(begin, end, comparator)
-     *
-     * The comparator is a lambda function:
-     * [](const Player* a, const Player* b) { ... }
-     *
-     * Lambda syntax: [captures](parameters) { body }
-     * - [] empty captures (doesn't use outer variables)
-     * - Takes two Player pointers
-     * - Returns true if a should come before b
-     *
-     * We want descending order (highest rating first)
-     * So: a->getRating() > b->getRating()
+     * Step 4: Apply them, moving each on the leaderboard
      */
-    std::sort(sortedPlayers.begin(), sortedPlayers.end(),
-        [](const Player* a, const Player* b)
+    for (size_t i = 0; i < count; i++)
+    {
+        const PlayerId id = delta->playerId(i);
+        const SnapshotRecord record = delta->record(i);
+
+        if (id < table.size())
         {
-            return a->getRating() > b->getRating();
-        });
+            table.updateRating(id, record.rating);
+            table.setStats(id, delta->stats(i));
+            leaderboard.update(id, table.getRatingValue(id));
+        }
+        else
+        {
+            /**
+             * Step 3 checked the same rules, so this cannot fail;
+             * if it ever did, the row must not be read
+             */
+            if (!appendPlayer(delta->name(i), record.rating, delta->stats(i)))
+            {
+                return std::unexpected(RankingError::InvalidSnapshot);
+            }
+            leaderboard.insert(id, table.getRatingValue(id));
+        }
+    }
 
     /**
-     * Step 4: Display header
+     * Step 5: The players are now at the delta's state
+     * Like a load, this is not a change to log or to save in the background
      */
-    std::cout << "\n";
-    std::cout << "========== LEADERBOARD ==========\n";
-    std::cout << std::left
-              << std::setw(20) << "Name"
-              << std::setw(10) << "Rating"
-              << std::setw(8) << "Games"
-              << std::setw(6) << "Wins"
-              << std::setw(6) << "Loses"
-              << std::setw(6) << "Draws" << std::endl;
+    pageCache.clear();
+    dropSaveCopy();
+    changeSequence = delta->logSequence();
+    startDelta();
+
+    return count;
+}
+
+void RankingSystem::startDelta()
+{
+    deltaRows.start(table.size());
+    deltaBase = changeSequence;
+}
+
+/**
+ * Steps:
+ * 1. The changed players, by id
+ * 2. The players added since, with their names
+ *
+ * Changed players get an empty name: the base already has it
+ */
+SnapshotCapture RankingSystem::makeDelta() const
+{
+    SnapshotCapture capture;
+    capture.delta = true;
+    capture.baseSequence = deltaBase;
+    capture.logSequence = changeSequence;
 
     /**
-     * std::string(56, '-') creates a string of 56 dashes
-     * Used to create a nice separator line
+     * Step 1: The changed players, sorted so the ids increase
      */
-    std::cout << std::string(56, '-') << std::endl;
+    std::vector<PlayerId> changed(deltaRows.rows().begin(), deltaRows.rows().end());
+    std::sort(changed.begin(), changed.end());
+
+    const size_t total = changed.size() + (table.size() - deltaRows.trackedRows());
+    capture.table.reserve(total);
+    capture.ids.reserve(total);
+
+    for (const PlayerId id : changed)
+    {
+        const size_t row = capture.table.addRow(std::string(), 0.0);
+        capture.table.copyValues(row, table, id);
+        capture.ids.push_back(id);
+    }
 
     /**
-     * Step 5: Display each player
-     *
-     * Call displayStats() on each player
-     * This outputs one formatted line per player
+     * Step 2: The new players
      */
-    for (const auto& player : sortedPlayers)
+    for (size_t id = deltaRows.trackedRows(); id < table.size(); id++)
     {
-        player->displayStats();
+        const size_t row = capture.table.addRow(table.getName(id), 0.0);
+        capture.table.copyValues(row, table, id);
+        capture.ids.push_back(static_cast<PlayerId>(id));
     }
 
-    std::cout << "=================================\n\n";
+    return capture;
 }
 
 /**
- * SAVE TO FILE
+ * REPLAY LOG
  *
- * Saves all player data to a CSV file
- * Format: Name,Rating,GamesPlayed,Wins,Losses,Draws
+ * Applies the records of a match log that the players do not
+ * contain yet, after checking that they fit
+ * Shared by replayMatchLog and openMatchLog
  */
-void RankingSystem::saveToFile(const std::string& filename) const
+std::expected<RankingSystem::LogReplay, RankingError> RankingSystem::replayLog(const std::string& filename)
 {
-    /**
-     * Step 1: Open file for writing
-     *
-     * std::ofstream = output file stream
-     * Creates or overwrites the file
-     */
-    std::ofstream file(filename);
+    const MappedFile file(filename);
+    const std::string_view text = file.isOpen() ? file.text() : std::string_view{};
 
     /**
-     * Step 2: Check if file opened successfully
+     * Step 1: Check every record against the players, changing nothing
      *
-     * If file can't be opened, print error
-     * Common reasons: permission denied, invalid path
+     * Records up to the current sequence are already part of the
+     * players (they were in the snapshot or the CSV file) and are skipped
+     * After loading a CSV file without a sequence line the sequence
+     * is unknown, and the whole log counts as new
+     *
+     * Of the rest, the first must come right after the current sequence,
+     * a player record must carry the next free id and a new name, and a
+     * match must name two different existing players; every rating
+     * must be valid (see isValidRating)
+     * If anything does not fit, the log was not written on top of these
+     * players, and replaying it would corrupt them
      */
-    if (!file)
+    std::uint64_t base = changeSequence;
+    bool first = true;
+    size_t playerCount = table.size();
+    std::unordered_set<std::string_view> loggedNames;
+
+    const std::expected<MatchLogExtent, RankingError> extent = MatchLog::read(text,
+        [&](const MatchLogEntry& entry)
+        {
+            if (first && sequenceUnknown)
+            {
+                base = entry.sequence - 1;
+            }
+            if (entry.sequence <= base)
+            {
+                return true;
+            }
+            if (first && entry.sequence != base + 1)
+            {
+                return false;
+            }
+            first = false;
+
+            if (entry.type == MatchLogEntry::Type::PlayerAdded)
+            {
+                const bool fits = entry.player1 == playerCount &&
+                                  checkNewPlayer(entry.name, entry.rating1, entry.stats).has_value() &&
+                                  loggedNames.insert(entry.name).second;
+                playerCount++;
+                return fits;
+            }
+
+            return entry.player1 < playerCount && entry.player2 < playerCount &&
+                   entry.player1 != entry.player2 && isValidRating(entry.rating1) && isValidRating(entry.rating2) &&
+                   (entry.result == MatchResult::Player1Wins || entry.result == MatchResult::Draw ||
+                    entry.result == MatchResult::Player2Wins);
+        });
+
+    if (!extent)
     {
-        std::cout << "Error opening file for writing!\n";
-        return;
+        return std::unexpected(extent.error());
     }
 
     /**
-     * Step 3: Write each player as one line
-     *
-     * Format: Name,Rating,GamesPlayed,Wins,Losses,Draws
-     *
-     * Using << operator to send data to file stream
-     * Just like std::cout but for files
+     * A log without records still says where it starts:
+     * if that is past the next change, some changes are missing
      */
-    for (const auto& player : players)
+    if (extent->size > 0)
     {
-        file << player->getName() << ","
-             << player->getRating() << ","
-             << player->getGamesPlayed() << ","
-             << player->getWins() << ","
-             << player->getLosses() << ","
-             << player->getDraws() << "\n";
+        if (sequenceUnknown)
+        {
+            base = extent->firstSequence - 1;
+        }
+        if (extent->firstSequence > base + 1)
+        {
+            return std::unexpected(RankingError::InvalidMatchLog);
+        }
     }
 
     /**
-     * Step 4: File automatically closes when it goes out of scope
+     * Step 2: Apply the new records
      *
-     * This is called RAII: Resource Acquisition Is Initialization
-     * When the ifstream object is destroyed, it closes the file
-     * No need for manual close()
+     * Matches are applied with the ratings they produced,
+     * so nothing is calculated again
+     * Each change counts itself, so afterwards changeSequence is
+     * the sequence of the last record
      */
-    std::cout << "Data saved to " << filename << "\n";
+    changeSequence = base;
+    sequenceUnknown = false;
+    size_t replayed = 0;
+
+    MatchLog::read(text.substr(0, extent->size),
+        [&](const MatchLogEntry& entry)
+        {
+            if (entry.sequence <= base)
+            {
+                return true;
+            }
+            if (entry.type == MatchLogEntry::Type::PlayerAdded)
+            {
+                restorePlayer(entry.name, entry.rating1, entry.stats);
+            }
+            else
+            {
+                applyMatch(entry.player1, entry.player2, entry.result,
+                           toRatingValue(entry.rating1), toRatingValue(entry.rating2));
+            }
+            replayed++;
+            return true;
+        });
+
+    return LogReplay{replayed, *extent};
 }
 
 /**
- * LOAD FROM FILE
- *
- * Loads player data from a CSV file
- * Parses each line and reconstructs Player objects
+ * REPLAY MATCH LOG
  */
-void RankingSystem::loadFromFile(const std::string& filename)
+std::expected<size_t, RankingError> RankingSystem::replayMatchLog(const std::string& filename)
 {
     /**
-     * Step 1: Open file for reading
-     *
-     * std::ifstream = input file stream
-     * If file doesn't exist, ifstream fails silently
-     * We check with the if statement
+     * The log that is open now, if any, must not receive the replayed records
      */
-    std::ifstream file(filename);
+    (void)closeMatchLog();
+
+    const std::expected<LogReplay, RankingError> replay = replayLog(filename);
+    if (!replay)
+    {
+        return std::unexpected(replay.error());
+    }
+
+    return replay->replayed;
+}
 
+/**
+ * OPEN MATCH LOG
+ *
+ * Replays a match log over the players already loaded,
+ * then keeps appending every change to it
+ */
+std::expected<size_t, RankingError> RankingSystem::openMatchLog(const std::string& filename,
+                                                                MatchLogOptions options)
+{
     /**
-     * Step 2: Check if file exists/opened
+     * Step 1: Close the log that is open now, if any (its last records are synced)
      *
-     * If file doesn't exist, start with empty system
-     * Don't crash, just print message and return
+     * It must be closed during the replay anyway, otherwise every
+     * replayed record would be appended to the log a second time
+     * If the old log has failed, its missing records cannot be
+     * written any more; the new log is opened regardless
      */
-    if (!file) {
-        std::cout << "No existing data file found. Starting fresh.\n";
-        return;
-    }
+    (void)closeMatchLog();
 
     /**
-     * Step 3: Clear existing players
-     *
-     * vector::clear() removes all elements
-     * The unique_ptrs are destroyed, which deletes the Player objects
-     * Automatic cleanup!
+     * Step 2: Replay what the players do not contain yet
      */
-    players.clear();
+    const std::expected<LogReplay, RankingError> replay = replayLog(filename);
+    if (!replay)
+    {
+        return std::unexpected(replay.error());
+    }
 
     /**
-     * Step 4: Read file line by line
+     * Step 3: Open the log for appending
      *
-     * std::getline(stream, line) reads until newline
-     * Returns false when end of file is reached
-     * This loop reads every line in the file
+     * If the log ends with the current sequence, new records continue it;
+     * a torn record at the end (from a crash) is cut off first
+     * Otherwise (an empty file, or a log that ends before a newer
+     * snapshot) it is started again, numbered from the next change
+     * Done after the replay has unmapped the file, since it changes its size
      */
-    std::string line;
-    while (std::getline(file, line))
-        {
-        /**
-         * Step 5: Parse the CSV line
-         *
-         * Create a stringstream to parse the line
-         * stringstream treats a string like a file for reading
-         * This lets us parse comma-separated values
-         */
-        std::stringstream ss(line);
+    const MatchLogExtent& extent = replay->extent;
+    const bool continues = extent.size > 0 && extent.nextSequence == changeSequence + 1;
 
-        /**
-         * Variables to hold the parsed data
-         */
-        std::string name;
-        double rating;
-        int games, wins, losses, draws;
+    std::unique_ptr<MatchLog> log = std::make_unique<MatchLog>(
+        filename, continues ? extent.size : 0, changeSequence + 1, options);
+    if (!log->isOpen())
+    {
+        return std::unexpected(RankingError::FileOpenFailed);
+    }
+    matchLog = std::move(log);
 
-        /**
-         * Parse comma-separated values
-         *
-         * std::getline(ss, name, ',') reads until it hits a comma
-         * ss >> variable reads the next value
-         * ss.ignore() skips the next character (the comma)
-         */
-        std::getline(ss, name, ',');
-        ss >> rating;
-        ss.ignore();
-        ss >> games;
-        ss.ignore();
-        ss >> wins;
-        ss.ignore();
-        ss >> losses;
-        ss.ignore();
-        ss >> draws;
+    return replay->replayed;
+}
 
-        /**
-         * Step 6: Create new Player with loaded data
-         */
-        auto player = std::make_unique<Player>(name, rating);
+/**
+ * SYNC MATCH LOG
+ *
+ * Commits the waiting group now instead of at its limit
+ */
+std::expected<void, RankingError> RankingSystem::syncMatchLog()
+{
+    if (matchLog && !matchLog->sync())
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
 
-        /**
-         * Step 7: Reconstruct game history
-         *
-         * We loaded the final counts, now we need to replay
-         * each game to set the counters correctly
-         *
-         * recordWin() increments both wins AND gamesPlayed
-         * So we call it once for each win
-         * Same for losses and draws
-         */
-        for (int i = 0; i < wins; i++)
-        {
-            player->recordWin();
-        }
-        for (int i = 0; i < losses; i++)
-        {
-            player->recordLoss();
-        }
-        for (int i = 0; i < draws; i++)
-        {
-            player->recordDraw();
-        }
+    return {};
+}
 
-        /**
-         * Step 8: Add to players vector
-         *
-         * std::move transfers ownership from player to vector
-         * The unique_ptr is now in the vector
-         */
-        players.push_back(std::move(player));
+/**
+ * CLEAR MATCH LOG
+ *
+ * After a save the log's records are part of the saved file,
+ * so replaying them on top of it would apply them twice
+ * The emptied log starts at the next change
+ */
+std::expected<void, RankingError> RankingSystem::clearMatchLog()
+{
+    if (matchLog && !matchLog->clear(changeSequence + 1))
+    {
+        return std::unexpected(RankingError::FileWriteFailed);
+    }
+
+    return {};
+}
+
+/**
+ * CLOSE MATCH LOG
+ */
+std::expected<void, RankingError> RankingSystem::closeMatchLog()
+{
+    const std::expected<void, RankingError> synced = syncMatchLog();
+    matchLog.reset();
+
+    return synced;
+}
+
+/**
+ * CHANGE SEQUENCE
+ */
+std::uint64_t RankingSystem::getChangeSequence() const
+{
+    return changeSequence;
+}
+
+/**
+ * CAPTURE SNAPSHOT
+ *
+ * Copies the columns and the leaderboard order
+ */
+SnapshotCapture RankingSystem::captureSnapshot()
+{
+    SnapshotCapture capture;
+    capture.table = table;
+    capture.order = leaderboard.range(0, leaderboard.size());
+    capture.logSequence = changeSequence;
+    startDelta();
+    return capture;
+}
+
+/**
+ * CAPTURE DELTA
+ *
+ * Same as saveDelta without the writing; the next delta starts now
+ */
+std::expected<SnapshotCapture, RankingError> RankingSystem::captureDelta()
+{
+    if (!deltaRows.isTracking())
+    {
+        return std::unexpected(RankingError::NoSnapshot);
     }
 
-    std::cout << "Loaded " << players.size() << " players from " << filename << "\n";
+    SnapshotCapture capture = makeDelta();
+    startDelta();
+    return capture;
+}
+
+size_t RankingSystem::getDeltaSize() const
+{
+    if (!deltaRows.isTracking())
+    {
+        return 0;
+    }
+    return deltaRows.rows().size() + (table.size() - deltaRows.trackedRows());
 }
 
 /**
@@ -409,7 +1683,7 @@ void RankingSystem::loadFromFile(const std::string& filename)
  */
 size_t RankingSystem::getPlayerCount() const
 {
-    return players.size();
+    return table.size();
 }
 
 /**
@@ -421,21 +1695,20 @@ size_t RankingSystem::getPlayerCount() const
 std::vector<std::string> RankingSystem::getAllPlayerNames() const
 {
     /**
-     * Create an empty vector to hold the names
+     * The name column already holds every name in row order,
+     * so the vector can be built from it in one step
      */
-    std::vector<std::string> names;
+    const std::span<const std::string> names = table.getNameColumn();
 
-    /**
-     * Loop through all players and extract their names
-     */
-    for (const auto& player : players)
-    {
-        /**
-         * Get the name and add it to our vector
-         * push_back adds an element to the end
-         */
-        names.push_back(player->getName());
-    }
+    return std::vector<std::string>(names.begin(), names.end());
+}
 
-    return names;
+/**
+ * GET PLAYER TABLE
+ *
+ * Returns the column storage for read-only scans
+ */
+const PlayerTable& RankingSystem::getPlayerTable() const
+{
+    return table;
 }
\ No newline at end of file
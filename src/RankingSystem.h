@@ -4,10 +4,31 @@
 #ifndef RANKINGSYSTEM_H
 #define RANKINGSYSTEM_H
 
+#include "ChangedRows.h"
+#include "LeaderboardIndex.h"
+#include "LeaderboardPageCache.h"
+#include "LeaderboardRenderer.h"
+#include "Match.h"
+#include "MatchHistory.h"
+#include "MatchLog.h"
+#include "MatchRecord.h"
 #include "Player.h"
+#include "PlayerCsv.h"
+#include "PlayerSnapshot.h"
+#include "PlayerTable.h"
+#include "RatingTimeline.h"
+#include "RankingError.h"
+#include <deque>
+#include <expected>
+#include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <future>
 #include <memory>
+#include <span>
 
 /**
  * This class manages:
@@ -26,14 +47,225 @@ class RankingSystem
 private:
 
     /**
-     * - Have to manually delete (easy to forget = memory leak)
-     * - Modern C++ best practice: avoid raw 'new' and 'delete'
-     * - unique_ptr handles cleanup automatically
+     * All player data, stored column by column
+     *
+     * Row N of the table is the N-th player added
+     * Scans such as sorting the leaderboard or saving read the dense
+     * columns directly instead of visiting one heap object per player
+     */
+    PlayerTable table;
+
+    /**
+     * One Player handle per table row, so findPlayer can return a const Player*
+     *
+     * Why std::deque instead of std::vector?
+     * - push_back on a deque never moves the existing elements
+     * - So a pointer returned by findPlayer stays valid when more players are added
+     */
+    std::deque<Player> players;
+
+    /**
+     * Hash functor for the name index
+     *
+     * is_transparent tells std::unordered_map that this hash (together with
+     * std::equal_to<>) can be called with any string-like type, not only
+     * std::string. That lets find() take a std::string_view directly, so a
+     * lookup never has to build a temporary std::string just to search.
+     */
+    struct NameHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view name) const
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    /**
+     * Name index: maps a player's name to their row in the table
+     *
+     * Kept in sync with players by addPlayer and loadFromFile
+     * Turns findPlayer from a linear scan into an average O(1) hash lookup,
+     * which matters once there are hundreds of thousands of players
+     */
+    std::unordered_map<std::string, size_t, NameHash, std::equal_to<>> nameIndex;
+
+    /**
+     * Every player in leaderboard order (highest rating first)
+     *
+     * Kept up to date by addPlayer, recordMatch and loadFromFile,
+     * at O(log n) per change, so showing the leaderboard never sorts
+     */
+    LeaderboardIndex leaderboard;
+
+    /**
+     * Rendered leaderboard pages, see getLeaderboardPageText
+     *
+     * mutable: reading a page does not change the rankings,
+     * but it may fill the cache
+     */
+    mutable LeaderboardPageCache pageCache;
+
+    /**
+     * Reusable text buffer for displayLeaderboard and the page text
+     *
+     * mutable for the same reason as pageCache: printing does not
+     * change the rankings, only the scratch memory used to format them
+     */
+    mutable LeaderboardRenderer renderer;
+
+    /**
+     * Append one player's line to the renderer
+     */
+    void renderRow(PlayerId id) const;
+
+    /**
+     * Whether appendPlayer would accept this player
+     * (the reason it would not, otherwise)
+     */
+    std::expected<void, RankingError> checkNewPlayer(std::string_view name, double rating,
+                                                     const PlayerStats& stats) const;
+
+    /**
+     * Store a player with their counters, without touching the leaderboard
+     * Shared by restorePlayer and loadFromFile
+     */
+    std::expected<PlayerId, RankingError> appendPlayer(std::string_view name, double rating,
+                                                       const PlayerStats& stats);
+
+    /**
+     * Store a match's result and new ratings, and move both players
+     * on the leaderboard
+     * Shared by recordMatch and openMatchLog's replay
+     */
+    void applyMatch(PlayerId id1, PlayerId id2, MatchResult result,
+                    RatingValue newRating1, RatingValue newRating2);
+
+    /**
+     * Where new players and matches are logged, see openMatchLog
+     * Empty while no log is open
+     */
+    std::unique_ptr<MatchLog> matchLog;
+
+    /**
+     * Every match recorded, see enableMatchHistory
+     * Empty while the history is off
+     */
+    std::unique_ptr<MatchHistory> matchHistory;
+
+    /**
+     * Every player's rating over time, see enableRatingTimeline
+     * Empty while it is off
+     */
+    std::unique_ptr<RatingTimeline> ratingTimeline;
+
+    /**
+     * Number of changes (players added, matches recorded) so far,
+     * see getChangeSequence
+     *
+     * sequenceUnknown: set by loadFromFile for a file saved without
+     * the sequence line; the next match log replayed is then taken as it is
+     */
+    std::uint64_t changeSequence = 0;
+    bool sequenceUnknown = false;
+
+    /**
+     * What replayLog did: records applied, and where the log ends
+     */
+    struct LogReplay
+    {
+        size_t replayed = 0;
+        MatchLogExtent extent;
+    };
+
+    /**
+     * Check a match log against the players and apply the records
+     * they do not contain yet; nothing changes if it does not fit
+     * Shared by replayMatchLog and openMatchLog
+     */
+    std::expected<LogReplay, RankingError> replayLog(const std::string& filename);
+
+    /**
+     * A second copy of the table that background saves read from,
+     * see saveToFileAsync
+     *
+     * Instead of copying every player for each save, the copy is kept
+     * between saves and only the rows that changed since the last one
+     * are copied again (new players are appended to it)
+     *
+     * saveCopyRows lists those rows; it does not track anything until
+     * the first background save, so a program that never starts one
+     * does not pay for the bookkeeping
+     *
+     * The copy is shared with the save writing it, and only touched
+     * here once that save is complete (runningSave)
+     */
+    std::shared_ptr<PlayerTable> saveCopy;
+    ChangedRows saveCopyRows;
+    std::shared_future<std::expected<void, RankingError>> runningSave;
+
+    /**
+     * The players changed since the last snapshot or delta was saved
+     * or loaded, and the change sequence of that state, see saveDelta
+     *
+     * Not tracking while there is no such state (after loadFromFile,
+     * the players are in no snapshot a delta could apply to)
+     */
+    ChangedRows deltaRows;
+    std::uint64_t deltaBase = 0;
+
+    /**
+     * Note a changed row for the save copy and the next delta
+     */
+    void markChanged(PlayerId id);
+
+    /**
+     * The current state becomes the one the next delta applies to
+     */
+    void startDelta();
+
+    /**
+     * Copy the players deltaRows lists, and the new ones, into a delta
+     */
+    SnapshotCapture makeDelta() const;
+
+    /**
+     * Forget the save copy after the table was replaced by a load
      */
-    std::vector<std::unique_ptr<Player>> players;
+    void dropSaveCopy();
+
+    /**
+     * Write a table as CSV, shared by saveToFile and saveToFileAsync
+     * sequence is the change sequence the table includes
+     */
+    static std::expected<void, RankingError> writeCsv(const PlayerTable& source, const std::string& filename,
+                                                      FileChecksum checksum, std::uint64_t sequence);
+
+    /**
+     * Copy one player's columns into a LeaderboardRow
+     */
+    LeaderboardRow makeRow(size_t rank, PlayerId id) const;
+
+    /**
+     * How recordMatch calculates expected scores
+     * Exact (std::pow) unless setExpectedScoreMode chooses the lookup table
+     */
+    ExpectedScoreMode expectedScoreMode = ExpectedScoreMode::Exact;
 
 public:
 
+    RankingSystem() = default;
+
+    /**
+     * A RankingSystem cannot be copied or moved
+     *
+     * The Player handles point at this object's table,
+     * so a copy would end up pointing at the wrong table
+     */
+    RankingSystem(const RankingSystem&) = delete;
+    RankingSystem& operator=(const RankingSystem&) = delete;
+
     /**
      * Add a new player to the system
      *
@@ -41,9 +273,44 @@ public:
      *   name - The player's name (must be unique)
      *   initialRating - Starting Elo rating (default 1200)
      *
-     * If a player with that name already exists, print error and do nothing
+     * Returns: The new player's id,
+     *          or RankingError::DuplicatePlayer if the name is already taken,
+     *          RankingError::InvalidName if it starts with '#',
+     *          RankingError::InvalidRating if the rating cannot be stored
+     *          (NaN, infinite, see isValidRating)
+     *          (in that case nothing is changed)
+     *
+     * Ids are handed out in order (0, 1, 2, ...) and never change,
+     * so callers can keep them and skip the name lookup later
+     *
+     * Usage example:
+     *   auto id = system.addPlayer("Alice");
+     *   if (id) { use *id } else { id.error() says why }
      */
-    void addPlayer(const std::string& name, double initialRating = 1200.0);
+    std::expected<PlayerId, RankingError> addPlayer(const std::string& name, double initialRating = 1200.0);
+
+    /**
+     * Add a player with the game counters they already have
+     *
+     * Parameters:
+     *   name - The player's name (must be unique)
+     *   rating - The player's rating
+     *   stats - Games played, wins, losses and draws so far
+     *
+     * Returns: The new player's id, or
+     *          RankingError::DuplicatePlayer if the name is already taken,
+     *          RankingError::InvalidName if it starts with '#',
+     *          RankingError::InvalidRating if the rating cannot be stored
+     *          (NaN, infinite, see isValidRating),
+     *          RankingError::InconsistentStats if the counters do not add up
+     *          (in all cases nothing is changed)
+     *
+     * This is how loadFromFile brings players back: the counters are
+     * stored directly, so restoring a player with 50,000 games costs
+     * the same as restoring one with none
+     */
+    std::expected<PlayerId, RankingError> restorePlayer(std::string_view name, double rating,
+                                                        const PlayerStats& stats);
 
     /**
      * Find a player by name
@@ -53,14 +320,45 @@ public:
      *
      * Returns: Pointer to Player if found, nullptr if not found
      *
+     * Uses the name index, so the cost does not grow with the number of players
+     * Takes a std::string_view, so string literals and substrings of a
+     * larger buffer can be looked up without copying them into a std::string
+     *
+     * The pointer stays valid until loadFromFile replaces the players
+     *
+     * The player is read-only: ratings and counters only change through
+     * recordMatch, which also keeps the leaderboard and the match log in step
+     *
      * Important: Caller MUST check if return value is nullptr!
      * Example:
-     *   Player* p = system.findPlayer("Alice");
+     *   const Player* p = system.findPlayer("Alice");
      *   if (p != nullptr) {
      *       cout << p->getRating();
      *   }
      */
-    Player* findPlayer(const std::string& name);
+    const Player* findPlayer(std::string_view name) const;
+
+    /**
+     * Find a player's id by name
+     *
+     * Returns: The player's id, or InvalidPlayerId if there is no such player
+     *
+     * Look the id up once, then use the id-based methods below
+     */
+    PlayerId findPlayerId(std::string_view name) const;
+
+    /**
+     * Check whether an id belongs to a player in the system
+     */
+    bool hasPlayer(PlayerId id) const;
+
+    /**
+     * Get a player by id
+     *
+     * The id must be valid (see hasPlayer); this is a plain array index
+     * Read-only, like findPlayer
+     */
+    const Player& getPlayer(PlayerId id) const;
 
     /**
      * Record a match between two players
@@ -72,12 +370,116 @@ public:
      *
      * This method:
      * 1. Finds both players by name
-     * 2. Creates a Match object
-     * 3. Calls processMatch() to update ratings
+     * 2. Calls the id-based recordMatch below to update ratings
+     *
+     * Returns: MatchStatus::Recorded, or why the match was rejected
+     *          (UnknownPlayer if either name is not found)
+     *
+     * Anything other than 1 or -1 is treated as a draw, as it always was
+     *
+     * This is a thin wrapper for the menu in main.cpp
+     */
+    MatchStatus recordMatch(std::string_view name1, std::string_view name2, const int result);
+
+    /**
+     * Record a match between two players given by id
+     *
+     * Parameters:
+     *   id1 - First player's id
+     *   id2 - Second player's id
+     *   result - Outcome from id1's point of view
+     *   kFactor - How much ratings should change (default 32.0);
+     *             must be positive, finite and at most MaxRating
+     *
+     * Returns: MatchStatus::Recorded if the match was recorded,
+     *          otherwise why it was rejected (unknown id, same player,
+     *          bad result, bad K-factor)
+     *
+     * This is the fast path: no name lookups, no Match object, no output
+     * Both players are updated directly in the table's columns
+     */
+    MatchStatus recordMatch(PlayerId id1, PlayerId id2, MatchResult result,
+                            double kFactor = Match::DefaultKFactor);
+
+    /**
+     * Record a whole batch of matches
+     *
+     * Parameters:
+     *   matches - The matches, applied one after another in order
+     *
+     * Returns: One status per match, in the same order
+     *
+     * A rejected match is skipped and the rest of the batch still runs
+     * Nothing is printed and nothing is allocated per match;
+     * the only allocation is the status vector for the whole batch
+     *
+     * Example:
+     *   std::vector<MatchRecord> batch = {
+     *       {alice, bob, MatchResult::Player1Wins},
+     *       {bob, charlie, MatchResult::Draw, 16.0f}
+     *   };
+     *   auto statuses = system.recordMatches(batch);
+     */
+    std::vector<MatchStatus> recordMatches(std::span<const MatchRecord> matches);
+
+    /**
+     * Choose how expected scores are calculated for this system
+     *
+     * Parameters:
+     *   mode - ExpectedScoreMode::Exact (default) or ExpectedScoreMode::LookupTable
+     *
+     * The lookup table avoids std::pow on every match; ratings then differ
+     * from the exact formula by at most K * 4e-7 per match
+     */
+    void setExpectedScoreMode(ExpectedScoreMode mode);
+
+    /**
+     * The mode chosen with setExpectedScoreMode
+     */
+    ExpectedScoreMode getExpectedScoreMode() const;
+
+    /**
+     * Keep every match recorded from now on in a MatchHistory
+     *
+     * Each match is stored with a timestamp (the system clock, in
+     * milliseconds), both ratings before it and both changes, in
+     * compressed columns of roughly 15-20 bytes per match
+     *
+     * The history lives in memory only: matches replayed from a match
+     * log are not added (their time is not known), and loadFromFile
+     * and loadSnapshot clear it, since the ids then mean other players
+     * Calling it again keeps the history already collected
+     */
+    void enableMatchHistory();
+
+    /**
+     * The match history, or nullptr if enableMatchHistory was not called
+     *
+     * Example:
+     *   system.getMatchHistory()->forEach([](const MatchHistoryEntry& match) { ... });
+     */
+    const MatchHistory* getMatchHistory() const;
+
+    /**
+     * Keep each player's rating over time from now on in a RatingTimeline
+     *
+     * Every match recorded adds a point (the time and the new rating)
+     * to both players' timelines, a few bytes each; reading one
+     * player's points for a time range only touches that player's
+     * blocks in the range
+     *
+     * Like the match history it lives in memory only, is not filled
+     * by log replays, and is cleared by loadFromFile and loadSnapshot
+     */
+    void enableRatingTimeline();
+
+    /**
+     * The rating timeline, or nullptr if enableRatingTimeline was not called
      *
-     * If either player is not found, print error and do nothing
+     * Example (the last 90 days):
+     *   auto points = system.getRatingTimeline()->pointsBetween(id, now - 90 * 86400000LL, now);
      */
-    void recordMatch(const std::string& name1, const std::string& name2, const int result);
+    const RatingTimeline* getRatingTimeline() const;
 
     /**
      * Display all players sorted by rating highest first
@@ -88,8 +490,105 @@ public:
      * Name                 Rating    Games  Wins  Loses Draws
      * Alice                1245.5    15     10    3     2
      * Bob                  1210.0    12     7     4     1
+     *
+     * Parameters:
+     *   out - Where to print the table (std::cout by default)
+     *
+     * This is the only RankingSystem method that writes text,
+     * and only because printing is its whole purpose
+     *
+     * The order comes from the maintained leaderboard index,
+     * so no sorting happens here; equal ratings keep the order
+     * in which the players were added
+     *
+     * Rows are formatted into one buffer and written in large chunks,
+     * not flushed line by line; the text is the same as before
+     */
+    void displayLeaderboard(std::ostream& out = std::cout) const;
+
+    /**
+     * A player's position on the leaderboard
+     *
+     * Parameters:
+     *   id - The player's id
+     *
+     * Returns: 1 for the highest rated player, 2 for the next, ...
+     *          or RankingError::UnknownPlayer for an invalid id
+     *
+     * Same order as displayLeaderboard (equal ratings: added first ranks first)
+     * O(log n): read from the leaderboard index, nothing is sorted
+     */
+    std::expected<size_t, RankingError> rankOf(PlayerId id) const;
+
+    /**
+     * The players around a player on the leaderboard ("players around me")
+     *
+     * Parameters:
+     *   id - The player in the middle
+     *   radius - How many players to include above and below
+     *
+     * Returns: Up to radius players above, the player, and up to radius
+     *          players below, in leaderboard order (fewer near the top or
+     *          the bottom), or RankingError::UnknownPlayer for an invalid id
+     *
+     * Example: radius 10 gives the ten players ahead, the player, and the
+     *          ten players behind - at most 21 ids
+     *
+     * O(log n + radius)
+     */
+    std::expected<std::vector<PlayerId>, RankingError> neighborhood(PlayerId id, size_t radius) const;
+
+    /**
+     * One page of the leaderboard as structured rows
+     *
+     * Parameters:
+     *   offset - Leaderboard position of the first row (0 is the top player)
+     *   limit - Maximum number of rows
+     *
+     * Returns: The rows in leaderboard order; fewer than limit at the end,
+     *          none if offset is past the last player
+     *
+     * O(log n + limit), nothing is sorted
      */
-    void displayLeaderboard() const;
+    std::vector<LeaderboardRow> getLeaderboardPage(size_t offset, size_t limit) const;
+
+    /**
+     * The best k players, optionally only those with enough games
+     *
+     * Parameters:
+     *   k - How many players to return at most
+     *   minGames - Skip players with fewer games played (default 0: nobody is skipped)
+     *
+     * Returns: Up to k rows, highest rating first
+     *          rank is the player's place on the full leaderboard, so with a
+     *          filter the ranks can have gaps
+     *
+     * Walks the leaderboard index from the top and stops after k players,
+     * so the rest of the population is never looked at
+     * (unless the filter skips most of the players near the top)
+     */
+    std::vector<LeaderboardRow> topK(size_t k, int minGames = 0) const;
+
+    /**
+     * One page of the leaderboard as ready-to-print text
+     *
+     * Parameters:
+     *   page - Page number, starting at 1 like ranks
+     *   pageSize - Rows per page
+     *
+     * Returns: The column titles followed by the page's rows,
+     *          formatted like displayLeaderboard
+     *          An empty string for page 0 or a page past the end
+     *
+     * The text is cached: asking for the same page again returns the
+     * stored string without touching the players
+     * Matches and new players drop only the pages whose rows changed,
+     * so polling page 1 stays cheap while matches happen further down
+     *
+     * The reference stays valid until the next call that changes the system
+     * or asks for a page
+     */
+    const std::string& getLeaderboardPageText(size_t page, size_t pageSize) const;
 
     /**
      * Save all player data to a file
@@ -101,26 +600,305 @@ public:
      * Example:
      * Alice,1245.5,15,10,3,2
      * Bob,1210.0,12,7,4,1
+     * #sequence,42
+     *
+     * The last row is followed by the change sequence the players
+     * include (see getChangeSequence), so a match log opened after
+     * loading the file skips the records that are already in it
      *
      * Parameters:
      *   filename - Path to file to save
+     *   checksum - Crc32Footer adds a last line with a CRC-32 of the file,
+     *              which loadFromFile checks (default: no checksum line)
+     *
+     * Returns: Nothing on success, otherwise FileOpenFailed or FileWriteFailed
+     *
+     * Crash safety: the rows are written to filename + ".tmp", synced to
+     * disk and then renamed over filename (see AtomicFileWriter)
+     * If the program or the machine dies during a save, filename still
+     * holds the complete previous save; it is never half written
+     *
+     * The rows are formatted into a buffer and written in large blocks,
+     * so saving is cheap enough to do every few seconds
+     *
+     * A background save still running (see saveToFileAsync) is waited
+     * for first, since both write through the same temporary file
      *
      * This allows data to persist between program runs
      */
-    void saveToFile(const std::string& filename) const;
+    std::expected<void, RankingError> saveToFile(const std::string& filename,
+                                                 FileChecksum checksum = FileChecksum::None) const;
+
+    /**
+     * Save all player data to a file on a background thread
+     *
+     * Same file, format and crash safety as saveToFile, but the caller
+     * only waits for the players to be copied; matches recorded while
+     * the file is being written are not in it and do not wait for it
+     *
+     * Steps:
+     * 1. Wait for the previous background save, if it is still running
+     * 2. Bring the save copy up to date: copy the rows changed since the
+     *    last background save, append the players added since
+     * 3. Write the copy on a background thread
+     *
+     * Step 2 costs the number of changed players, not the number of
+     * players, so saving often stays cheap; the very first call copies
+     * everyone once
+     *
+     * Parameters:
+     *   filename - Path to file to save
+     *   checksum - Same as saveToFile
+     *
+     * Returns: A future for the result saveToFile would have returned
+     *
+     * Example:
+     *   auto saved = system.saveToFileAsync(filename);
+     *   ... keep recording matches ...
+     *   if (saved.get()) { ... }
+     */
+    std::shared_future<std::expected<void, RankingError>> saveToFileAsync(
+        const std::string& filename, FileChecksum checksum = FileChecksum::None);
 
     /**
      * Load all player data from a file
      *
      * Clears current players and loads from the CSV file
-     * If file doesn't exist, starts with empty system
+     * If file doesn't exist, the current players are left untouched
+     * If a name appears more than once, only the first row is kept
+     * Blank lines and lines that are not a complete player row are skipped,
+     * and so are rows whose counters do not add up (see restorePlayer)
+     *
+     * The file is memory-mapped and parsed in place (see MappedFile and
+     * PlayerCsv), and each player's counters are stored in one step,
+     * so loading costs the same per player however many games they played
      *
      * Parameters:
      *   filename - Path to file to load
+     *   threadCount - Threads used to parse the file (default 1);
+     *                 0 uses one per CPU core
+     *
+     * With more than one thread, the file is cut into pieces at line
+     * breaks and the pieces are parsed at the same time; players are
+     * still added in file order, so ids, duplicate handling and the
+     * result are exactly the same as with one thread
+     *
+     * If the file ends with a checksum line (see saveToFile), the rest
+     * of the file must match it, otherwise nothing is loaded; a file
+     * saved with a checksum that lost its checksum line is refused too
+     *
+     * The sequence line sets getChangeSequence; a file without one
+     * (saved by an older version) leaves the sequence unknown, and the
+     * next match log opened is replayed whole
+     *
+     * Returns: The number of players loaded,
+     *          FileOpenFailed if the file could not be opened,
+     *          or ChecksumMismatch if its checksum line does not match
+     *          or is missing
      *
      * This allows data to be restored from previous runs
      */
-    void loadFromFile(const std::string& filename);
+    std::expected<size_t, RankingError> loadFromFile(const std::string& filename, unsigned threadCount = 1);
+
+    /**
+     * Save all player data to a binary snapshot file
+     *
+     * Same players as saveToFile, in a format that loads much faster
+     * (see PlayerSnapshot): fixed-size records, the names in one block,
+     * and the current leaderboard order
+     *
+     * Parameters:
+     *   filename - Path to file to save
+     *   checksum - Crc32Footer adds a CRC-32 that loadSnapshot checks
+     *
+     * Returns: Nothing on success, otherwise FileOpenFailed or FileWriteFailed
+     *
+     * Written through a temporary file and a rename, like saveToFile,
+     * so a crash never leaves a half-written snapshot behind
+     *
+     * The saved state is what the next delta applies to (see saveDelta)
+     */
+    std::expected<void, RankingError> saveSnapshot(const std::string& filename,
+                                                   FileChecksum checksum = FileChecksum::None);
+
+    /**
+     * Load all player data from a snapshot written by saveSnapshot
+     *
+     * The file is memory-mapped and its records are copied straight into
+     * the table: no text is parsed, ratings come back bit for bit, and
+     * the saved leaderboard order means the leaderboard is not sorted
+     *
+     * Unlike loadFromFile nothing is skipped: the whole file is checked
+     * first, and if anything is wrong (including a duplicate name)
+     * the current players are left untouched
+     *
+     * Parameters:
+     *   filename - Path to file to load
+     *
+     * Returns: The number of players loaded,
+     *          FileOpenFailed if the file could not be opened,
+     *          ChecksumMismatch if its checksum does not match,
+     *          or InvalidSnapshot if it is not a valid snapshot
+     */
+    std::expected<size_t, RankingError> loadSnapshot(const std::string& filename);
+
+    /**
+     * Save only the players changed since the last snapshot or delta
+     *
+     * A delta is a snapshot file (see PlayerSnapshot) holding just the
+     * players whose rating or counters changed, and the players added,
+     * since the last saveSnapshot, loadSnapshot, saveDelta or loadDelta
+     * When a save interval touches a few percent of the players, the
+     * delta is a few percent of a snapshot
+     *
+     * Loading the snapshot and then its deltas in order brings back
+     * the players as they were at the last delta. Deltas pile up, so
+     * now and then a full snapshot should be saved instead; that is
+     * the compaction, and the older deltas are no longer needed
+     * (CheckpointManager does both)
+     *
+     * Parameters:
+     *   filename - Path to file to save
+     *   checksum - Same as saveSnapshot
+     *
+     * Returns: The number of players written,
+     *          NoSnapshot if there is no snapshot to build on,
+     *          otherwise FileOpenFailed or FileWriteFailed
+     *          (then the changes stay for the next delta)
+     */
+    std::expected<size_t, RankingError> saveDelta(const std::string& filename,
+                                                  FileChecksum checksum = FileChecksum::None);
+
+    /**
+     * Apply a delta written by saveDelta on top of the current players
+     *
+     * The delta must continue exactly where the players are: its base
+     * is the change sequence of the snapshot or delta loaded last
+     * As with loadSnapshot, the whole file is checked first, and
+     * nothing changes if it does not fit
+     *
+     * Parameters:
+     *   filename - Path to file to load
+     *
+     * Returns: The number of players in the delta,
+     *          FileOpenFailed if the file could not be opened,
+     *          ChecksumMismatch if its checksum does not match,
+     *          or InvalidSnapshot if it is not a valid delta, or not
+     *          one for these players
+     */
+    std::expected<size_t, RankingError> loadDelta(const std::string& filename);
+
+    /**
+     * Recover from a match log, then log every change to it
+     *
+     * Parameters:
+     *   filename - The log file (created if it does not exist)
+     *   options - How often records are forced onto the disk
+     *             (see MatchLogOptions; default: every 256 records or 10 ms)
+     *
+     * Returns: The number of records replayed,
+     *          FileOpenFailed if the log could not be opened for writing,
+     *          or InvalidMatchLog if it is not a match log or does not fit
+     *          the current players (then nothing was replayed)
+     *
+     * Call it right after loadFromFile or loadSnapshot:
+     * 1. The records in the log (players added and matches recorded since
+     *    that save) are applied on top of the loaded players
+     *    Every record is numbered (see getChangeSequence); records a
+     *    snapshot already contains are skipped, and a log that starts
+     *    after the next change is refused, since changes are missing
+     *    After loadFromFile the whole log is applied
+     * 2. From then on addPlayer, restorePlayer and recordMatch append a
+     *    small binary record (see MatchLog); records are written and
+     *    fsynced in groups, so the log costs little per match
+     *
+     * After a crash, at most the last unsynced group is lost
+     * After saving, call clearMatchLog, otherwise the next start
+     * would apply the logged changes a second time
+     * loadFromFile and loadSnapshot are not logged: close or clear
+     * the log before loading other players
+     */
+    std::expected<size_t, RankingError> openMatchLog(const std::string& filename, MatchLogOptions options = {});
+
+    /**
+     * Apply a match log like openMatchLog, without opening it for appending
+     *
+     * Returns: The number of records replayed, or InvalidMatchLog
+     *
+     * Closes the log that is open now, if any
+     * Used to replay older log files before opening the newest one
+     * (see CheckpointManager)
+     */
+    std::expected<size_t, RankingError> replayMatchLog(const std::string& filename);
+
+    /**
+     * Write and fsync the records waiting in the match log now
+     *
+     * Returns: Nothing on success (or if no log is open),
+     *          FileWriteFailed if the log could not be written;
+     *          once that happens, later changes are no longer logged
+     */
+    std::expected<void, RankingError> syncMatchLog();
+
+    /**
+     * Empty the match log after its changes were saved
+     *
+     * Returns: Nothing on success (or if no log is open), otherwise FileWriteFailed
+     *
+     * Example:
+     *   if (system.saveToFile(filename)) { system.clearMatchLog(); }
+     */
+    std::expected<void, RankingError> clearMatchLog();
+
+    /**
+     * Sync and close the match log; changes are no longer logged
+     *
+     * Returns: Nothing on success (or if no log is open), otherwise FileWriteFailed
+     */
+    std::expected<void, RankingError> closeMatchLog();
+
+    /**
+     * Number of changes made to the players so far
+     *
+     * Every player added and every match recorded counts one; a match
+     * log numbers its records the same way, and saveSnapshot stores
+     * this number, so a log can be replayed over a snapshot without
+     * applying anything twice
+     *
+     * loadSnapshot sets it to the snapshot's number; loadFromFile to 0
+     */
+    std::uint64_t getChangeSequence() const;
+
+    /**
+     * Copy everything saveSnapshot would write, at this moment
+     *
+     * Returns: The players' columns, the leaderboard order and the
+     *          change sequence, sharing nothing with the system
+     *
+     * The copy can be written with PlayerSnapshot::save on another
+     * thread while this system keeps changing (see CheckpointManager)
+     *
+     * Like saveSnapshot, the captured state is what the next delta
+     * applies to
+     */
+    SnapshotCapture captureSnapshot();
+
+    /**
+     * Copy everything saveDelta would write, at this moment
+     *
+     * The next delta starts here, whether or not this one is written,
+     * so if writing it fails, the deltas after it do not apply to
+     * anything; take a full snapshot then
+     *
+     * Returns: The changed and new players, or NoSnapshot
+     */
+    std::expected<SnapshotCapture, RankingError> captureDelta();
+
+    /**
+     * Number of players a delta taken now would hold
+     * (changed and new), or 0 if there is no snapshot to build on
+     */
+    size_t getDeltaSize() const;
 
     /**
      * Get the number of players in the system
@@ -146,6 +924,14 @@ public:
      */
     std::vector<std::string> getAllPlayerNames() const;
 
+    /**
+     * Read-only access to the column storage
+     *
+     * Lets callers scan every player's rating or counters as plain arrays,
+     * for example to build a rating histogram, without going through handles
+     */
+    const PlayerTable& getPlayerTable() const;
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef RATING_H
+#define RATING_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * How ratings are stored
+ *
+ * By default a rating is a double, exactly as it always was
+ *
+ * Building with ELO_FIXED_POINT_RATINGS defined (cmake -DELO_FIXED_POINT_RATINGS=ON)
+ * switches to fixed point: the rating times 1000, stored in a 32-bit integer
+ *   1216.5 points  ->  1216500
+ *
+ * Why fixed point?
+ * - Integer math gives the same answer on every machine and compiler,
+ *   so replaying the same matches always produces bit-for-bit identical ratings
+ * - 4 bytes per rating instead of 8: twice as many ratings per cache line
+ *   and per SIMD register when scanning the rating column
+ * - A resolution of 0.001 points is far finer than anyone looks at
+ *
+ * The rest of the program keeps using doubles through getRating();
+ * only the stored value and the update math change
+ */
+
+/**
+ * Number of stored units per rating point in fixed-point mode
+ */
+inline constexpr std::int32_t RatingScale = 1000;
+
+#ifdef ELO_FIXED_POINT_RATINGS
+
+using RatingValue = std::int32_t;
+
+inline constexpr bool FixedPointRatings = true;
+
+#else
+
+using RatingValue = double;
+
+inline constexpr bool FixedPointRatings = false;
+
+#endif
+
+/**
+ * The lowest and highest rating that can be stored
+ *
+ * In fixed-point mode that is what fits in RatingValue,
+ * about -2.1 to +2.1 million points; otherwise any finite double
+ */
+inline constexpr double MinRating = FixedPointRatings
+    ? static_cast<double>(std::numeric_limits<std::int32_t>::min()) / RatingScale
+    : std::numeric_limits<double>::lowest();
+inline constexpr double MaxRating = FixedPointRatings
+    ? static_cast<double>(std::numeric_limits<std::int32_t>::max()) / RatingScale
+    : std::numeric_limits<double>::max();
+
+/**
+ * Whether a rating can be stored as it is: finite and from MinRating
+ * to MaxRating (NaN fails both comparisons)
+ *
+ * Everything that brings a rating in from outside checks this first
+ */
+constexpr bool isValidRating(double rating)
+{
+    return rating >= MinRating && rating <= MaxRating;
+}
+
+/**
+ * Convert a rating in points to the stored form
+ *
+ * In fixed-point mode the value is rounded to the nearest 0.001
+ * A value outside the range is held at the nearest end and NaN
+ * becomes 0, so the conversion is always defined; callers are
+ * expected to have checked isValidRating already
+ */
+constexpr RatingValue toRatingValue(double rating)
+{
+    if constexpr (FixedPointRatings)
+    {
+        constexpr double lowest = std::numeric_limits<RatingValue>::min();
+        constexpr double highest = std::numeric_limits<RatingValue>::max();
+
+        const double scaled = rating * RatingScale;
+        const double rounded = scaled < 0 ? scaled - 0.5 : scaled + 0.5;
+        if (rounded != rounded)
+        {
+            return 0;
+        }
+        if (rounded <= lowest)
+        {
+            return std::numeric_limits<RatingValue>::min();
+        }
+        if (rounded >= highest)
+        {
+            return std::numeric_limits<RatingValue>::max();
+        }
+        return static_cast<RatingValue>(rounded);
+    }
+    else
+    {
+        return static_cast<RatingValue>(rating);
+    }
+}
+
+/**
+ * Convert a stored rating back to points
+ */
+constexpr double fromRatingValue(RatingValue value)
+{
+    if constexpr (FixedPointRatings)
+    {
+        return static_cast<double>(value) / RatingScale;
+    }
+    else
+    {
+        return static_cast<double>(value);
+    }
+}
+
+#endif
@@ -0,0 +1,224 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "RatingTimeline.h"
+#include "Varint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /**
+     * Milliseconds -> whole seconds, rounding down or up
+     * (also right for times before 1970)
+     */
+    std::int64_t secondsDown(std::int64_t milliseconds)
+    {
+        return milliseconds / 1000 - (milliseconds % 1000 < 0 ? 1 : 0);
+    }
+
+    std::int64_t secondsUp(std::int64_t milliseconds)
+    {
+        return milliseconds / 1000 + (milliseconds % 1000 > 0 ? 1 : 0);
+    }
+}
+
+/**
+ * Steps:
+ * 1. Round the point to whole seconds and rating steps
+ * 2. Encode it against the player's previous point
+ * 3. Append it to the player's newest block, or start a new block
+ *    if it does not fit
+ */
+void RatingTimeline::append(PlayerId player, std::int64_t timestamp, double rating)
+{
+    /**
+     * Step 1: Round
+     */
+    std::int64_t time = secondsDown(timestamp);
+    const std::int32_t steps = static_cast<std::int32_t>(std::llround(rating * RatingSteps));
+
+    if (player >= tails.size())
+    {
+        tails.resize(static_cast<size_t>(player) + 1);
+    }
+    pointCount++;
+
+    PlayerTail& tail = tails[player];
+    if (tail.newestBlock == NoBlock)
+    {
+        startBlock(player, time, steps, FirstBlockBytes);
+        return;
+    }
+
+    /**
+     * Step 2: Encode the change of the gap and the rating difference
+     *
+     * A block's second point is encoded against a gap of 0,
+     * so it stores the gap itself
+     */
+    time = std::max(time, tail.lastTime);
+    const std::int64_t gap = time - tail.lastTime;
+
+    std::uint8_t encoded[2 * Varint::MaxBytes];
+    std::uint8_t* end = Varint::writeSigned(encoded, gap - tail.lastGap);
+    end = Varint::writeSigned(end, static_cast<std::int64_t>(steps) - tail.lastRating);
+    const size_t length = static_cast<size_t>(end - encoded);
+
+    /**
+     * Step 3: Store it
+     *
+     * A full block stays as it is; the point starts the next one whole
+     */
+    Block& block = blocks[tail.newestBlock];
+    if (block.used + length > block.capacity)
+    {
+        startBlock(player, time, steps, std::min<size_t>(block.capacity * 2, MaxBlockBytes));
+        return;
+    }
+
+    std::memcpy(blockData(block) + block.used, encoded, length);
+    block.used = static_cast<std::uint16_t>(block.used + length);
+    block.count++;
+
+    tail.lastTime = time;
+    tail.lastGap = gap;
+    tail.lastRating = steps;
+}
+
+/**
+ * A block never crosses the end of a slab; the few bytes left at
+ * the end of a full slab stay unused
+ */
+void RatingTimeline::startBlock(PlayerId player, std::int64_t time, std::int32_t rating, size_t capacity)
+{
+    if (slabUsed + capacity > SlabBytes)
+    {
+        slabs.push_back(std::make_unique_for_overwrite<std::uint8_t[]>(SlabBytes));
+        slabUsed = 0;
+    }
+
+    PlayerTail& tail = tails[player];
+
+    Block block;
+    block.firstTime = time;
+    block.previous = tail.newestBlock;
+    block.offset = static_cast<std::uint32_t>(((slabs.size() - 1) * SlabBytes + slabUsed) / Alignment);
+    block.capacity = static_cast<std::uint16_t>(capacity);
+    block.count = 1;
+    slabUsed += (capacity + Alignment - 1) / Alignment * Alignment;
+
+    const std::uint8_t* end = Varint::writeSigned(blockData(block), rating);
+    block.used = static_cast<std::uint16_t>(end - blockData(block));
+
+    tail.newestBlock = static_cast<std::uint32_t>(blocks.size());
+    tail.lastTime = time;
+    tail.lastGap = 0;
+    tail.lastRating = rating;
+    blocks.push_back(block);
+}
+
+std::uint8_t* RatingTimeline::blockData(const Block& block) const
+{
+    const size_t position = static_cast<size_t>(block.offset) * Alignment;
+    return slabs[position / SlabBytes].get() + position % SlabBytes;
+}
+
+/**
+ * Walk back from the newest block: a block ends by the time the next
+ * one starts (the newest at the player's last point), so blocks that
+ * start after the range or end before it are skipped, and a block
+ * that starts before it is the last one looked at
+ */
+std::vector<std::uint32_t> RatingTimeline::blocksBetween(PlayerId player, std::int64_t from, std::int64_t to) const
+{
+    std::vector<std::uint32_t> found;
+    if (player >= tails.size())
+    {
+        return found;
+    }
+
+    std::int64_t end = tails[player].lastTime;
+    for (std::uint32_t i = tails[player].newestBlock; i != NoBlock; i = blocks[i].previous)
+    {
+        if (blocks[i].firstTime <= to && end >= from)
+        {
+            found.push_back(i);
+        }
+        if (blocks[i].firstTime < from)
+        {
+            break;
+        }
+        end = blocks[i].firstTime;
+    }
+
+    std::reverse(found.begin(), found.end());
+    return found;
+}
+
+std::vector<RatingPoint> RatingTimeline::pointsBetween(PlayerId player, std::int64_t from, std::int64_t to) const
+{
+    const std::int64_t firstSecond = secondsUp(from);
+    const std::int64_t lastSecond = secondsDown(to);
+
+    std::vector<RatingPoint> points;
+    for (const std::uint32_t i : blocksBetween(player, firstSecond, lastSecond))
+    {
+        const Block& block = blocks[i];
+        const std::uint8_t* in = blockData(block);
+
+        std::int64_t time = block.firstTime;
+        std::int64_t gap = 0;
+        std::int64_t rating = Varint::readSigned(in);
+        for (size_t point = 0; point < block.count; point++)
+        {
+            if (point > 0)
+            {
+                gap += Varint::readSigned(in);
+                time += gap;
+                rating += Varint::readSigned(in);
+            }
+            if (time > lastSecond)
+            {
+                break;
+            }
+            if (time >= firstSecond)
+            {
+                points.push_back({time * 1000, static_cast<double>(rating) / RatingSteps});
+            }
+        }
+    }
+
+    return points;
+}
+
+size_t RatingTimeline::bytesBetween(PlayerId player, std::int64_t from, std::int64_t to) const
+{
+    size_t bytes = 0;
+    for (const std::uint32_t i : blocksBetween(player, secondsUp(from), secondsDown(to)))
+    {
+        bytes += sizeof(Block) + blocks[i].used;
+    }
+    return bytes;
+}
+
+size_t RatingTimeline::size() const
+{
+    return pointCount;
+}
+
+size_t RatingTimeline::memoryBytes() const
+{
+    return sizeof(*this) + blocks.capacity() * sizeof(Block) + tails.capacity() * sizeof(PlayerTail) +
+           slabs.capacity() * sizeof(slabs[0]) + slabs.size() * SlabBytes;
+}
+
+void RatingTimeline::clear()
+{
+    blocks = std::vector<Block>();
+    tails = std::vector<PlayerTail>();
+    slabs = std::vector<std::unique_ptr<std::uint8_t[]>>();
+    slabUsed = SlabBytes;
+    pointCount = 0;
+}
@@ -0,0 +1,192 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef RATINGTIMELINE_H
+#define RATINGTIMELINE_H
+
+#include "PlayerTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * RatingPoint
+ *
+ * A player's rating at one moment
+ *
+ *   timestamp - Milliseconds since 1970 (UTC), kept to the second
+ *   rating - Kept to 0.01 points
+ */
+struct RatingPoint
+{
+    std::int64_t timestamp = 0;
+    double rating = 0.0;
+};
+
+/**
+ * RatingTimeline Class
+ *
+ * Every player's rating over time, for charts like
+ * "rating over the last 90 days"
+ *
+ * Answering that from the MatchHistory would mean decoding every match
+ * in the range to find one player's few. Here each player has their
+ * own chain of small blocks, newest last, and an index from PlayerId
+ * to the newest block; a query walks back from it, skipping blocks
+ * that start after the range and stopping at the first block that
+ * starts before it, so it reads only the player's blocks in the range
+ *
+ * Each block starts with its first point whole (the time in the
+ * block's header, the rating as the first value) and encodes the
+ * rest as time series usually are:
+ *
+ *   timestamp  in seconds; the second point stores its gap to the first,
+ *              every later one the change of the gap ("delta of delta"),
+ *              as a zigzag varint. A player who plays at a steady pace
+ *              gets small numbers, 1-2 bytes
+ *   rating     in steps of 0.01 points (RatingSteps per point); each
+ *              point stores the difference to the one before as a
+ *              zigzag varint. One Elo update moves at most K points,
+ *              so usually 2 bytes
+ *
+ * A point costs 3-4 bytes for a player with a steady pace, up to 6
+ * when the gaps between matches vary by days
+ *
+ * Most players play a few matches and a few play thousands, so a
+ * player's first block is small (FirstBlockBytes) and each next one
+ * twice the size, up to MaxBlockBytes
+ *
+ * Ratings are rounded before the differences are taken,
+ * so the rounding does not add up along the chain
+ *
+ * The encoded bytes live in slabs of SlabBytes, so growing the
+ * timeline never copies what is already stored
+ *
+ * Timestamps are expected not to go back for a player; one that does
+ * is stored as the player's previous time, which keeps every chain
+ * in time order
+ *
+ * Usage:
+ *   RatingTimeline timeline;
+ *   timeline.append(id, timestamp, rating);     // after every match
+ *   auto points = timeline.pointsBetween(id, now - 90 days, now);
+ */
+class RatingTimeline
+{
+
+public:
+
+    /**
+     * Encoded bytes in a player's first block, and the most in any block
+     */
+    static constexpr size_t FirstBlockBytes = 32;
+    static constexpr size_t MaxBlockBytes = 256;
+
+    /**
+     * Rating steps per point: ratings are kept to 0.01
+     *
+     * Finer than any chart shows, and it keeps one match's change
+     * in 2 bytes (a change of 32 points is 3200 steps)
+     */
+    static constexpr double RatingSteps = 100.0;
+
+private:
+
+    static constexpr std::uint32_t NoBlock = UINT32_MAX;
+
+    /**
+     * Blocks are placed at multiples of Alignment in the slabs,
+     * so a 32-bit offset reaches 64 GB
+     */
+    static constexpr size_t Alignment = 16;
+    static constexpr size_t SlabBytes = 256 * 1024;
+
+    /**
+     * A block's header: the time of its first point, where its bytes
+     * are, and the link to the player's previous block
+     */
+    struct Block
+    {
+        std::int64_t firstTime = 0;
+        std::uint32_t previous = NoBlock;
+        std::uint32_t offset = 0;
+        std::uint16_t capacity = 0;
+        std::uint16_t used = 0;
+        std::uint16_t count = 0;
+    };
+
+    /**
+     * The index entry of a player: the newest block, and the last
+     * point the next one is encoded against
+     */
+    struct PlayerTail
+    {
+        std::int64_t lastTime = 0;
+        std::int64_t lastGap = 0;
+        std::int32_t lastRating = 0;
+        std::uint32_t newestBlock = NoBlock;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<PlayerTail> tails;
+    std::vector<std::unique_ptr<std::uint8_t[]>> slabs;
+    size_t slabUsed = SlabBytes;
+    size_t pointCount = 0;
+
+    /**
+     * Start a block of the given size with one point,
+     * after the player's previous block
+     */
+    void startBlock(PlayerId player, std::int64_t time, std::int32_t rating, size_t capacity);
+
+    std::uint8_t* blockData(const Block& block) const;
+
+    /**
+     * The player's blocks that can hold points from "from" to "to"
+     * (in seconds), oldest first
+     */
+    std::vector<std::uint32_t> blocksBetween(PlayerId player, std::int64_t from, std::int64_t to) const;
+
+public:
+
+    /**
+     * Add a point at the end of a player's timeline
+     *
+     * Parameters:
+     *   player - Any id; the index grows to fit it
+     *   timestamp - Milliseconds since 1970
+     *   rating - The rating from that moment on
+     */
+    void append(PlayerId player, std::int64_t timestamp, double rating);
+
+    /**
+     * A player's points from "from" to "to" (milliseconds, both included),
+     * oldest first; empty for a player with no points
+     */
+    std::vector<RatingPoint> pointsBetween(PlayerId player, std::int64_t from, std::int64_t to) const;
+
+    /**
+     * Bytes pointsBetween reads for the same query
+     * (block headers included)
+     */
+    size_t bytesBetween(PlayerId player, std::int64_t from, std::int64_t to) const;
+
+    /**
+     * Number of points stored, for all players
+     */
+    size_t size() const;
+
+    /**
+     * Bytes of memory the timeline uses, allocated capacity included
+     */
+    size_t memoryBytes() const;
+
+    /**
+     * Forget every point and free the memory
+     */
+    void clear();
+
+};
+
+#endif
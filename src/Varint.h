@@ -0,0 +1,104 @@
+// Aleksandar Panich
+// Version 1.0
+
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Varint Class
+ *
+ * Variable-length integers, for the compressed columns of MatchHistory
+ * and RatingTimeline
+ *
+ * A varint stores 7 bits per byte, low bits first, with the top bit
+ * set on every byte but the last: 0..127 take 1 byte, up to 16383
+ * 2 bytes, and so on, at most MaxBytes for a 64-bit number
+ *
+ * Signed values go through zigzag first, which interleaves them so
+ * that small negative numbers stay small too:
+ *   0, -1, 1, -2, 2, ...  ->  0, 1, 2, 3, 4, ...
+ *
+ * Readers trust the bytes: they are only used on buffers this
+ * program wrote itself
+ */
+class Varint
+{
+
+public:
+
+    static constexpr size_t MaxBytes = 10;
+
+    static constexpr std::uint64_t zigzag(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    static constexpr std::int64_t unzigzag(std::uint64_t value)
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    /**
+     * Write value at out; returns the position after it
+     */
+    static std::uint8_t* write(std::uint8_t* out, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            *out++ = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<std::uint8_t>(value);
+        return out;
+    }
+
+    static std::uint8_t* writeSigned(std::uint8_t* out, std::int64_t value)
+    {
+        return write(out, zigzag(value));
+    }
+
+    /**
+     * Append value to a growing buffer
+     */
+    static void append(std::vector<std::uint8_t>& out, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    static void appendSigned(std::vector<std::uint8_t>& out, std::int64_t value)
+    {
+        append(out, zigzag(value));
+    }
+
+    /**
+     * Read a value at in and move in past it
+     */
+    static std::uint64_t read(const std::uint8_t*& in)
+    {
+        std::uint64_t value = 0;
+        int shift = 0;
+        while (*in & 0x80)
+        {
+            value |= static_cast<std::uint64_t>(*in++ & 0x7f) << shift;
+            shift += 7;
+        }
+        return value | static_cast<std::uint64_t>(*in++) << shift;
+    }
+
+    static std::int64_t readSigned(const std::uint8_t*& in)
+    {
+        return unzigzag(read(in));
+    }
+
+};
+
+#endif
@@ -135,8 +135,43 @@ int main()
      * Load existing data from file
      * If file doesn't exist, starts with empty system
      * If file exists, restores all players
+     *
+     * The library does not print anything, so the messages live here
+     */
+    const auto loaded = system.loadFromFile(filename);
+    if (loaded)
+    {
+        std::cout << "Loaded " << *loaded << " players from " << filename << "\n";
+    }
+    else if (loaded.error() == RankingError::ChecksumMismatch)
+    {
+        std::cout << "Data file " << filename << " is damaged (checksum mismatch). Starting fresh.\n";
+    }
+    else
+    {
+        std::cout << "No existing data file found. Starting fresh.\n";
+    }
+
+    /**
+     * Replay the match log on top of the loaded players
+     *
+     * Every player added and every match recorded since the last save
+     * is in the log, so a crash loses (almost) nothing
+     * The data file says which changes it already holds, and only
+     * the ones after those are replayed
+     * From here on every change is appended to it as well
      */
-    system.loadFromFile(filename);
+    const std::string logFilename = "../data/matches.wal";
+    const auto replayed = system.openMatchLog(logFilename);
+    if (!replayed)
+    {
+        std::cout << "Match log " << logFilename << " does not match the data file. "
+                  << "Changes will not be logged.\n";
+    }
+    else if (*replayed > 0)
+    {
+        std::cout << "Recovered " << *replayed << " unsaved changes from " << logFilename << "\n";
+    }
 
     /**
      * Main loop control variable
@@ -178,7 +213,20 @@ int main()
                 std::string name;
                 std::cout << "Enter player name: ";
                 std::getline(std::cin, name);
-                system.addPlayer(name);
+
+                const auto added = system.addPlayer(name);
+                if (added)
+                {
+                    std::cout << "Player '" << name << "' added successfully!\n";
+                }
+                else if (added.error() == RankingError::InvalidName)
+                {
+                    std::cout << "Player names cannot start with '#'!\n";
+                }
+                else
+                {
+                    std::cout << "Player '" << name << "' already exists!\n";
+                }
                 break;
             }
 
@@ -242,9 +290,13 @@ int main()
                 {
                     std::cout << "Invalid result! Must be 1, 0, or -1\n";
                 }
+                else if (system.recordMatch(playerName, opponent, result) == MatchStatus::Recorded)
+                {
+                    std::cout << "Match recorded successfully!\n";
+                }
                 else
                 {
-                    system.recordMatch(playerName, opponent, result);
+                    std::cout << "Match could not be recorded!\n";
                 }
                 break;
             }
@@ -270,7 +322,29 @@ int main()
                  * Set running to false to exit loop
                  * Program terminates after loop
                  */
-                system.saveToFile(filename);
+                const auto saved = system.saveToFile(filename, FileChecksum::Crc32Footer);
+                if (saved)
+                {
+                    std::cout << "Data saved to " << filename << "\n";
+
+                    /**
+                     * Everything in the log is in the file now
+                     * (a crash before this line is harmless: the file
+                     * records its sequence, so the log is not applied twice)
+                     */
+                    if (!system.clearMatchLog())
+                    {
+                        std::cout << "Error clearing the match log!\n";
+                    }
+                }
+                else if (saved.error() == RankingError::FileOpenFailed)
+                {
+                    std::cout << "Error opening file for writing!\n";
+                }
+                else
+                {
+                    std::cout << "Error writing to file!\n";
+                }
                 std::cout << "Goodbye!\n";
                 running = false;
                 break;
@@ -283,8 +357,14 @@ int main()
                  *
                  * Don't save data
                  * Set running to false to exit loop
-                 * Any unsaved changes are lost
+                 * Any unsaved changes are lost, so they are
+                 * removed from the match log too
+                 * (if that fails they come back on the next start)
                  */
+                if (!system.clearMatchLog())
+                {
+                    std::cout << "Error clearing the match log! Unsaved changes will be replayed next time.\n";
+                }
                 std::cout << "Exiting without saving. Goodbye!\n";
                 running = false;
                 break;
@@ -0,0 +1,147 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/AtomicFileWriter.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/**
+ * Read a whole file into a string ("" if it does not exist)
+ */
+std::string readFile(const char* path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool fileExists(const char* path)
+{
+    return static_cast<bool>(std::ifstream(path));
+}
+
+/**
+ * TEST 1: Commit Replaces the File
+ *
+ * Nothing changes until commit(); then the new contents are in place
+ * and the temporary file is gone
+ */
+void testCommit()
+{
+    std::cout << "Test 1: Commit replaces the file..." << std::endl;
+
+    const char* path = "test_atomic_commit.txt";
+    {
+        std::ofstream file(path);
+        file << "old contents\n";
+    }
+
+    {
+        AtomicFileWriter writer(path);
+        assert(writer.isOpen());
+        [[maybe_unused]] const bool written = writer.write("new ");
+        assert(written);
+        [[maybe_unused]] const bool writtenAgain = writer.write("contents\n");
+        assert(writtenAgain);
+
+        assert(readFile(path) == "old contents\n");
+        assert(fileExists("test_atomic_commit.txt.tmp"));
+
+        [[maybe_unused]] const bool committed = writer.commit();
+        assert(committed);
+        [[maybe_unused]] const bool committedAgain = writer.commit();
+        assert(!committedAgain);
+    }
+
+    assert(readFile(path) == "new contents\n");
+    assert(!fileExists("test_atomic_commit.txt.tmp"));
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: No Commit, No Change
+ *
+ * A writer that is dropped without commit() (as after an error)
+ * leaves the old file alone and cleans up its temporary file
+ */
+void testAbandon()
+{
+    std::cout << "Test 2: Abandoned write leaves the file alone..." << std::endl;
+
+    const char* path = "test_atomic_abandon.txt";
+    {
+        std::ofstream file(path);
+        file << "keep me\n";
+    }
+
+    {
+        AtomicFileWriter writer(path);
+        [[maybe_unused]] const bool written = writer.write("half a fi");
+        assert(written);
+    }
+
+    assert(readFile(path) == "keep me\n");
+    assert(!fileExists("test_atomic_abandon.txt.tmp"));
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Bad Path
+ *
+ * A directory that does not exist cannot hold the temporary file
+ */
+void testBadPath()
+{
+    std::cout << "Test 3: Bad path..." << std::endl;
+
+    AtomicFileWriter writer("no_such_directory/file.txt");
+    assert(!writer.isOpen());
+    [[maybe_unused]] const bool written = writer.write("data");
+    assert(!written);
+    [[maybe_unused]] const bool committed = writer.commit();
+    assert(!committed);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running AtomicFileWriter Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testCommit();
+        testAbandon();
+        testBadPath();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All AtomicFileWriter tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,389 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/CheckpointManager.h"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * Every test works in its own directory, removed at the end
+ */
+const char* testDirectory = "test_checkpoints";
+
+/**
+ * Files in the test directory whose name starts with prefix
+ */
+size_t countFiles(const std::string& prefix)
+{
+    size_t count = 0;
+    for (const auto& file : std::filesystem::directory_iterator(testDirectory))
+    {
+        if (file.path().filename().string().starts_with(prefix))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Play some matches between the first players
+ */
+void playMatches(RankingSystem& system, int count, int seed)
+{
+    const PlayerId players = static_cast<PlayerId>(system.getPlayerCount());
+    for (int i = 0; i < count; i++)
+    {
+        const PlayerId a = static_cast<PlayerId>((i * 7 + seed) % players);
+        const PlayerId b = static_cast<PlayerId>((i * 13 + seed + 1) % players);
+        system.recordMatch(a, b, static_cast<MatchResult>((i + seed) % 3 - 1));
+    }
+}
+
+/**
+ * Same players, ratings, counters and leaderboard
+ */
+void assertSame(const RankingSystem& a, [[maybe_unused]] const RankingSystem& b)
+{
+    assert(a.getPlayerCount() == b.getPlayerCount());
+    assert(a.getChangeSequence() == b.getChangeSequence());
+    for (PlayerId id = 0; id < a.getPlayerCount(); id++)
+    {
+        assert(a.getPlayer(id).getName() == b.getPlayer(id).getName());
+        assert(a.getPlayer(id).getRatingValue() == b.getPlayer(id).getRatingValue());
+        assert(a.getPlayer(id).getGamesPlayed() == b.getPlayer(id).getGamesPlayed());
+        assert(*a.rankOf(id) == *b.rankOf(id));
+    }
+}
+
+/**
+ * TEST 1: Recover From Snapshot and Log
+ *
+ * Changes before and after a checkpoint all come back
+ */
+void testRecover()
+{
+    std::cout << "Test 1: Recover from snapshot and log..." << std::endl;
+
+    std::filesystem::remove_all(testDirectory);
+
+    RankingSystem system;
+    {
+        CheckpointManager checkpoints(system, testDirectory);
+        [[maybe_unused]] const auto fresh = checkpoints.recover();
+        assert(fresh->recordsReplayed == 0);
+
+        for (int i = 0; i < 50; i++)
+        {
+            system.addPlayer("Player" + std::to_string(i), 1000.0 + 17 * i);
+        }
+        playMatches(system, 200, 1);
+
+        [[maybe_unused]] const auto checkpointed = checkpoints.checkpoint();
+        assert(checkpointed.has_value());
+        [[maybe_unused]] const auto finished = checkpoints.wait();
+        assert(finished.has_value());
+
+        system.addPlayer("Latecomer");
+        playMatches(system, 100, 2);
+        [[maybe_unused]] const auto closed = system.closeMatchLog();
+        assert(closed.has_value());
+    }
+
+    RankingSystem recovered;
+    CheckpointManager checkpoints(recovered, testDirectory);
+    const auto result = checkpoints.recover();
+    assert(result.has_value());
+    assert(result->snapshotSequence == 250);
+    assert(result->playersLoaded == 50);
+    assert(result->recordsReplayed == 101);
+    assertSame(system, recovered);
+
+    /**
+     * The recovered system keeps logging where the old one stopped
+     */
+    playMatches(recovered, 10, 3);
+    playMatches(system, 10, 3);
+    [[maybe_unused]] const auto synced = recovered.syncMatchLog();
+    assert(synced.has_value());
+
+    RankingSystem again;
+    CheckpointManager againCheckpoints(again, testDirectory);
+    [[maybe_unused]] const auto againResult = againCheckpoints.recover();
+    assert(againResult->recordsReplayed == 111);
+    assertSame(system, again);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Old Files Are Removed
+ *
+ * Only keepSnapshots snapshots stay, with the logs they still need
+ */
+void testCleanup()
+{
+    std::cout << "Test 2: Old files are removed..." << std::endl;
+
+    std::filesystem::remove_all(testDirectory);
+
+    CheckpointOptions options;
+    options.keepSnapshots = 2;
+    options.deltasPerSnapshot = 0;
+
+    RankingSystem system;
+    CheckpointManager checkpoints(system, testDirectory, options);
+    checkpoints.recover();
+    for (int i = 0; i < 20; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i));
+    }
+
+    for (int round = 0; round < 4; round++)
+    {
+        playMatches(system, 30, round);
+        [[maybe_unused]] const auto checkpointed = checkpoints.checkpoint();
+        assert(checkpointed.has_value());
+        [[maybe_unused]] const auto finished = checkpoints.wait();
+        assert(finished.has_value());
+    }
+
+    /**
+     * Snapshots at 110 and 140 stay; of the logs, only the one from 111
+     * (still needed by the snapshot at 110) and the current one from 141
+     */
+    assert(countFiles("snapshot-") == 2);
+    assert(countFiles("matches-") == 2);
+
+    /**
+     * Nothing changed: no new snapshot
+     */
+    [[maybe_unused]] const auto checkpointedAgain = checkpoints.checkpoint();
+    assert(checkpointedAgain.has_value());
+    [[maybe_unused]] const auto finishedAgain = checkpoints.wait();
+    assert(finishedAgain.has_value());
+    assert(countFiles("snapshot-") == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Damaged Newest Snapshot
+ *
+ * Recovery falls back to the older snapshot and a longer piece of log
+ */
+void testFallback()
+{
+    std::cout << "Test 3: Damaged newest snapshot..." << std::endl;
+
+    std::filesystem::remove_all(testDirectory);
+
+    CheckpointOptions options;
+    options.deltasPerSnapshot = 0;
+
+    RankingSystem system;
+    {
+        CheckpointManager checkpoints(system, testDirectory, options);
+        checkpoints.recover();
+        for (int i = 0; i < 20; i++)
+        {
+            system.addPlayer("Player" + std::to_string(i));
+        }
+        playMatches(system, 40, 1);
+        [[maybe_unused]] const auto checkpointed = checkpoints.checkpoint();
+        assert(checkpointed.has_value());
+        playMatches(system, 40, 2);
+        [[maybe_unused]] const auto checkpointedAgain = checkpoints.checkpoint();
+        assert(checkpointedAgain.has_value());
+        [[maybe_unused]] const auto finished = checkpoints.wait();
+        assert(finished.has_value());
+        playMatches(system, 5, 3);
+        [[maybe_unused]] const auto closed = system.closeMatchLog();
+        assert(closed.has_value());
+    }
+
+    /**
+     * Overwrite the middle of the newest snapshot (sequence 100)
+     */
+    {
+        std::fstream file(std::filesystem::path(testDirectory) / "snapshot-00000000000000000100.bin",
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(100);
+        file.write("damage", 6);
+    }
+
+    RankingSystem recovered;
+    CheckpointManager checkpoints(recovered, testDirectory);
+    const auto result = checkpoints.recover();
+    assert(result.has_value());
+    assert(result->snapshotSequence == 60);
+    assert(result->recordsReplayed == 45);
+    assertSame(system, recovered);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Checkpoint When Due
+ */
+void testCheckpointIfDue()
+{
+    std::cout << "Test 4: Checkpoint when due..." << std::endl;
+
+    std::filesystem::remove_all(testDirectory);
+
+    CheckpointOptions options;
+    options.changesPerCheckpoint = 100;
+    options.interval = std::chrono::hours(1);
+
+    RankingSystem system;
+    CheckpointManager checkpoints(system, testDirectory, options);
+    checkpoints.recover();
+    for (int i = 0; i < 10; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i));
+    }
+
+    size_t started = 0;
+    for (int i = 0; i < 350; i++)
+    {
+        playMatches(system, 1, i);
+        if (*checkpoints.checkpointIfDue())
+        {
+            started++;
+
+            /**
+             * None starts while one is still being written, and this
+             * loop is faster than the disk, so let each one finish
+             */
+            [[maybe_unused]] const auto finished = checkpoints.wait();
+            assert(finished.has_value());
+        }
+    }
+    [[maybe_unused]] const auto finishedAgain = checkpoints.wait();
+    assert(finishedAgain.has_value());
+    assert(started == 3);
+
+    std::filesystem::remove_all(testDirectory);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Deltas Between Snapshots
+ *
+ * Checkpoints write deltas until deltasPerSnapshot is reached; recovery
+ * loads the newest snapshot and its deltas, and a damaged delta is
+ * covered by the log
+ */
+void testDeltas()
+{
+    std::cout << "Test 5: Deltas between snapshots..." << std::endl;
+
+    std::filesystem::remove_all(testDirectory);
+
+    CheckpointOptions options;
+    options.deltasPerSnapshot = 2;
+
+    RankingSystem system;
+    {
+        CheckpointManager checkpoints(system, testDirectory, options);
+        checkpoints.recover();
+        for (int i = 0; i < 100; i++)
+        {
+            system.addPlayer("Player" + std::to_string(i));
+        }
+
+        /**
+         * Snapshot at 100, deltas at 120 and 140,
+         * snapshot at 160, delta at 180
+         */
+        [[maybe_unused]] const auto checkpointed = checkpoints.checkpoint();
+        assert(checkpointed.has_value());
+        for (int round = 0; round < 4; round++)
+        {
+            playMatches(system, 20, round);
+            [[maybe_unused]] const auto checkpointedAgain = checkpoints.checkpoint();
+            assert(checkpointedAgain.has_value());
+            [[maybe_unused]] const auto finished = checkpoints.wait();
+            assert(finished.has_value());
+        }
+        playMatches(system, 5, 9);
+        [[maybe_unused]] const auto closed = system.closeMatchLog();
+        assert(closed.has_value());
+    }
+
+    assert(countFiles("snapshot-") == 2);
+    assert(countFiles("delta-") == 3);
+
+    {
+        RankingSystem recovered;
+        CheckpointManager checkpoints(recovered, testDirectory, options);
+        const auto result = checkpoints.recover();
+        assert(result.has_value());
+        assert(result->snapshotSequence == 160);
+        assert(result->deltasApplied == 1);
+        assert(result->recordsReplayed == 5);
+        assertSame(system, recovered);
+        [[maybe_unused]] const auto recoveredClosed = recovered.closeMatchLog();
+        assert(recoveredClosed.has_value());
+    }
+
+    /**
+     * Without the delta at 180, its 20 matches come from the log
+     */
+    {
+        std::fstream file(std::filesystem::path(testDirectory) / "delta-00000000000000000180.bin",
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(100);
+        file.write("damage", 6);
+    }
+
+    RankingSystem recovered;
+    CheckpointManager checkpoints(recovered, testDirectory, options);
+    const auto result = checkpoints.recover();
+    assert(result.has_value());
+    assert(result->deltasApplied == 0);
+    assert(result->recordsReplayed == 25);
+    assertSame(system, recovered);
+
+    std::filesystem::remove_all(testDirectory);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running CheckpointManager Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRecover();
+        testCleanup();
+        testFallback();
+        testCheckpointIfDue();
+        testDeltas();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All CheckpointManager tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,123 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/Crc32.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+/**
+ * The textbook one-byte-at-a-time CRC-32, to compare against
+ */
+std::uint32_t bitwiseCrc32(std::string_view data)
+{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (const char c : data)
+    {
+        crc ^= static_cast<unsigned char>(c);
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * TEST 1: Known Values
+ *
+ * "123456789" is the standard check string for CRC-32
+ */
+void testKnownValues()
+{
+    std::cout << "Test 1: Known values..." << std::endl;
+
+    assert(Crc32::compute("") == 0);
+    assert(Crc32::compute("123456789") == 0xCBF43926u);
+    assert(Crc32::compute("The quick brown fox jumps over the lazy dog") == 0x414FA339u);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Every Length
+ *
+ * The 8-byte steps and the leftover bytes agree with the
+ * bit-by-bit version for every length and alignment
+ */
+void testMatchesBitwise()
+{
+    std::cout << "Test 2: Matches the bit-by-bit version..." << std::endl;
+
+    std::string data;
+    for (int i = 0; i < 300; i++)
+    {
+        data.push_back(static_cast<char>(i * 131 + 7));
+    }
+
+    for (size_t start = 0; start < 9; start++)
+    {
+        for (size_t length = 0; start + length <= data.size(); length += 7)
+        {
+            [[maybe_unused]] const std::string_view piece = std::string_view(data).substr(start, length);
+            assert(Crc32::compute(piece) == bitwiseCrc32(piece));
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: In Pieces
+ *
+ * Continuing a checksum piece by piece gives the checksum of the whole
+ */
+void testUpdate()
+{
+    std::cout << "Test 3: Checksum in pieces..." << std::endl;
+
+    const std::string data = "Alice,1245.5,15,10,3,2\nBob,1210,12,7,4,1\nCharlie,1188,0,0,0,0\n";
+
+    for (size_t cut = 0; cut <= data.size(); cut++)
+    {
+        [[maybe_unused]] const std::uint32_t first = Crc32::update(0, std::string_view(data).substr(0, cut));
+        assert(Crc32::update(first, std::string_view(data).substr(cut)) == Crc32::compute(data));
+    }
+
+    std::string damaged = data;
+    damaged[5] ^= 0x01;
+    assert(Crc32::compute(damaged) != Crc32::compute(data));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running Crc32 Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testKnownValues();
+        testMatchesBitwise();
+        testUpdate();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All Crc32 tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,189 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/EloKernel.h"
+#include "../src/Match.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/**
+ * The largest difference we accept between a kernel and Match::calculateExpectedScore
+ * EloKernel.h documents 1e-13, the test leaves a little headroom
+ */
+const double Tolerance = 1e-12;
+
+/**
+ * All levels this CPU can run
+ */
+std::vector<EloKernel::SimdLevel> supportedLevels()
+{
+    std::vector<EloKernel::SimdLevel> levels = {EloKernel::SimdLevel::Scalar};
+
+    if (EloKernel::detectSimdLevel() >= EloKernel::SimdLevel::SSE2)
+    {
+        levels.push_back(EloKernel::SimdLevel::SSE2);
+    }
+    if (EloKernel::detectSimdLevel() >= EloKernel::SimdLevel::AVX2)
+    {
+        levels.push_back(EloKernel::SimdLevel::AVX2);
+    }
+    return levels;
+}
+
+/**
+ * TEST 1: Known Values
+ *
+ * Equal ratings give 0.5, a 400 point gap gives 10/11 and 1/11
+ */
+void testKnownValues()
+{
+    std::cout << "Test 1: Known values..." << std::endl;
+
+    const std::vector<double> a = {1200.0, 1600.0, 1200.0, 1500.0, 1000.0};
+    const std::vector<double> b = {1200.0, 1200.0, 1600.0, 1500.0, 1000.0};
+
+    for (const EloKernel::SimdLevel level : supportedLevels())
+    {
+        std::vector<double> expected(a.size());
+        EloKernel::expectedScores(a, b, expected, level);
+
+        assert(std::abs(expected[0] - 0.5) < Tolerance);
+        assert(std::abs(expected[1] - 10.0 / 11.0) < Tolerance);
+        assert(std::abs(expected[2] - 1.0 / 11.0) < Tolerance);
+        assert(std::abs(expected[3] - 0.5) < Tolerance);
+        assert(std::abs(expected[4] - 0.5) < Tolerance);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Matches the Scalar Formula
+ *
+ * Random rating pairs, including odd lengths so the leftover
+ * pairs after the last full SIMD register are covered too
+ */
+void testMatchesScalarFormula()
+{
+    std::cout << "Test 2: Matches the scalar formula..." << std::endl;
+
+    std::mt19937_64 rng{1};
+    std::uniform_real_distribution<double> rating{0.0, 3000.0};
+
+    for (const size_t count : {size_t{1}, size_t{3}, size_t{7}, size_t{1001}})
+    {
+        std::vector<double> a(count);
+        std::vector<double> b(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            a[i] = rating(rng);
+            b[i] = rating(rng);
+        }
+
+        for (const EloKernel::SimdLevel level : supportedLevels())
+        {
+            std::vector<double> expected(count);
+            EloKernel::expectedScores(a, b, expected, level);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                assert(std::abs(expected[i] - Match::calculateExpectedScore(a[i], b[i])) < Tolerance);
+            }
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Extreme Differences
+ *
+ * Huge gaps must give 0 or 1, never NaN or infinity
+ */
+void testExtremeDifferences()
+{
+    std::cout << "Test 3: Extreme differences..." << std::endl;
+
+    const std::vector<double> a = {0.0, 1e6, 0.0, 5000.0};
+    const std::vector<double> b = {1e6, 0.0, 5000.0, 0.0};
+
+    for (const EloKernel::SimdLevel level : supportedLevels())
+    {
+        std::vector<double> expected(a.size());
+        EloKernel::expectedScores(a, b, expected, level);
+
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            assert(std::isfinite(expected[i]));
+            assert(std::abs(expected[i] - Match::calculateExpectedScore(a[i], b[i])) < Tolerance);
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Rating Deltas
+ *
+ * The batch deltas match what Match::calculateNewRatings produces
+ */
+void testRatingDeltas()
+{
+    std::cout << "Test 4: Rating deltas..." << std::endl;
+
+    const std::vector<double> a = {1200.0, 1600.0, 1200.0, 1450.0, 1333.0};
+    const std::vector<double> b = {1200.0, 1200.0, 1600.0, 1390.0, 1700.0};
+    const std::vector<double> actual = {1.0, 1.0, 1.0, 0.5, 0.0};
+    const std::vector<int> results = {1, 1, 1, 0, -1};
+
+    for (const EloKernel::SimdLevel level : supportedLevels())
+    {
+        std::vector<double> deltas(a.size());
+        EloKernel::ratingDeltas(a, b, actual, 32.0, deltas, level);
+
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            [[maybe_unused]] const Match::RatingUpdate update = Match::calculateNewRatings(a[i], b[i], results[i], 32.0);
+
+            assert(std::abs(a[i] + deltas[i] - update.newRating1) < 1e-9);
+            assert(std::abs(b[i] - deltas[i] - update.newRating2) < 1e-9);
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running EloKernel Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testKnownValues();
+        testMatchesScalarFormula();
+        testExtremeDifferences();
+        testRatingDeltas();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All EloKernel tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
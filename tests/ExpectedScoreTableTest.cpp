@@ -0,0 +1,217 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/ExpectedScoreTable.h"
+#include "../src/Match.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+/**
+ * COMPILE-TIME CHECKS
+ *
+ * The table is constexpr, so some facts can be checked by the compiler
+ * If one of these fails the test does not even build
+ */
+static_assert(DefaultExpectedScoreTable.entry(0) == 0.5, "equal ratings give 0.5");
+static_assert(DefaultExpectedScoreTable.entry(400) > 0.0909 && DefaultExpectedScoreTable.entry(400) < 0.0910,
+              "a 400 point gap gives 1/11");
+
+/**
+ * TEST 1: Table Entries Match the Formula
+ *
+ * Every stored entry is (almost exactly) the std::pow result
+ */
+void testEntries()
+{
+    std::cout << "Test 1: Table entries match the formula..." << std::endl;
+
+    for (int i = 0; i < ExpectedScoreTable<>::Size; i++)
+    {
+        [[maybe_unused]] const double exact = Match::calculateExpectedScore(0.0, static_cast<double>(i));
+        assert(std::abs(DefaultExpectedScoreTable.entry(i) - exact) < 1e-14);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Interpolation Error Bound
+ *
+ * Sweep differences between the entries (including negative ones)
+ * and check the documented error guarantee
+ */
+void testErrorBound()
+{
+    std::cout << "Test 2: Interpolation error bound..." << std::endl;
+
+    double worst = 0.0;
+    for (double difference = -2000.0; difference <= 2000.0; difference += 0.0625)
+    {
+        const double ratingA = 1500.0;
+        const double ratingB = 1500.0 + difference;
+
+        const double exact = Match::calculateExpectedScore(ratingA, ratingB);
+        const double table = DefaultExpectedScoreTable(ratingA, ratingB);
+
+        worst = std::max(worst, std::abs(table - exact));
+    }
+
+    assert(worst <= ExpectedScoreTable<>::MaxError);
+    assert(ExpectedScoreTable<>::MaxError <= 4e-7);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Coarser Table
+ *
+ * A table with bigger steps is smaller but less accurate,
+ * and still stays within its own guarantee
+ */
+void testCoarseTable()
+{
+    std::cout << "Test 3: Coarser table..." << std::endl;
+
+    using CoarseTable = ExpectedScoreTable<800, 8>;
+    constexpr CoarseTable coarse{};
+
+    static_assert(CoarseTable::Size == 101);
+
+    for (double difference = -800.0; difference <= 800.0; difference += 0.5)
+    {
+        [[maybe_unused]] const double exact = Match::calculateExpectedScore(1000.0, 1000.0 + difference);
+        assert(std::abs(coarse(1000.0, 1000.0 + difference) - exact) <= CoarseTable::MaxError);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Outside the Table
+ *
+ * Differences larger than the table use the exact formula
+ */
+void testOutsideRange()
+{
+    std::cout << "Test 4: Outside the table..." << std::endl;
+
+    const double pairs[][2] = {{0.0, 2500.0}, {3000.0, 100.0}, {1200.0, 3200.0}};
+
+    for (const auto& pair : pairs)
+    {
+        [[maybe_unused]] const double exact = Match::calculateExpectedScore(pair[0], pair[1]);
+        assert(DefaultExpectedScoreTable(pair[0], pair[1]) == exact);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Match Uses the Table When Asked
+ *
+ * calculateNewRatings in LookupTable mode stays close to Exact mode
+ */
+void testMatchMode()
+{
+    std::cout << "Test 5: Match lookup table mode..." << std::endl;
+
+    [[maybe_unused]] const Match::RatingUpdate exact = Match::calculateNewRatings(1510.3, 1388.9, 1, 32.0);
+    [[maybe_unused]] const Match::RatingUpdate table = Match::calculateNewRatings(1510.3, 1388.9, 1, 32.0,
+                                                                                  ExpectedScoreMode::LookupTable);
+
+    assert(std::abs(exact.newRating1 - table.newRating1) <= 32.0 * ExpectedScoreTable<>::MaxError);
+    assert(std::abs(exact.newRating2 - table.newRating2) <= 32.0 * ExpectedScoreTable<>::MaxError);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 6: Integer Table for Fixed-Point Ratings
+ *
+ * The integer table follows the exact formula to within
+ * a few parts in 10^7, for whole and fractional differences
+ */
+void testFixedTable()
+{
+    std::cout << "Test 6: Fixed-point table..." << std::endl;
+
+    constexpr double one = static_cast<double>(FixedExpectedScoreTable::One);
+
+    assert(DefaultFixedExpectedScoreTable(0) == FixedExpectedScoreTable::One / 2);
+
+    for (std::int64_t difference = -2500000; difference <= 2500000; difference += 997)
+    {
+        [[maybe_unused]] const double exact = Match::calculateExpectedScore(0.0, difference / 1000.0);
+        [[maybe_unused]] const double fixed = DefaultFixedExpectedScoreTable(difference) / one;
+        assert(std::abs(exact - fixed) < 1.2e-5);
+
+        if (difference > -2000000 && difference < 2000000)
+        {
+            assert(std::abs(exact - fixed) <= ExpectedScoreTable<>::MaxError + 1e-8);
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 7: Stored-Form Updates
+ *
+ * calculateNewRatingValues agrees with calculateNewRatings to within
+ * the rounding of the build, and is exactly zero-sum
+ */
+void testRatingValueUpdate()
+{
+    std::cout << "Test 7: Stored-form rating update..." << std::endl;
+
+    [[maybe_unused]] const Match::RatingUpdate exact = Match::calculateNewRatings(1510.3, 1388.9, -1, 32.0);
+    [[maybe_unused]] const Match::RatingValueUpdate stored = Match::calculateNewRatingValues(
+        toRatingValue(1510.3), toRatingValue(1388.9), -1, 32.0);
+
+    [[maybe_unused]] const double tolerance = FixedPointRatings ? 0.001 : 1e-9;
+    assert(std::abs(exact.newRating1 - fromRatingValue(stored.newRating1)) <= tolerance);
+    assert(std::abs(exact.newRating2 - fromRatingValue(stored.newRating2)) <= tolerance);
+
+    if constexpr (FixedPointRatings)
+    {
+        assert(stored.newRating1 + stored.newRating2 == toRatingValue(1510.3) + toRatingValue(1388.9));
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running ExpectedScoreTable Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testEntries();
+        testErrorBound();
+        testCoarseTable();
+        testOutsideRange();
+        testMatchMode();
+        testFixedTable();
+        testRatingValueUpdate();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All ExpectedScoreTable tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,282 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/LeaderboardIndex.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * Helper: the leaderboard order computed the slow way, with a full sort
+ */
+std::vector<PlayerId> sortedOrder(const std::vector<RatingValue>& ratings)
+{
+    std::vector<PlayerId> order(ratings.size());
+    std::iota(order.begin(), order.end(), PlayerId{0});
+
+    std::sort(order.begin(), order.end(),
+        [&ratings](PlayerId a, PlayerId b)
+        {
+            if (ratings[a] != ratings[b])
+            {
+                return ratings[a] > ratings[b];
+            }
+            return a < b;
+        });
+
+    return order;
+}
+
+/**
+ * TEST 1: Empty Index
+ */
+void testEmptyIndex()
+{
+    std::cout << "Test 1: Empty index..." << std::endl;
+
+    LeaderboardIndex index;
+
+    assert(index.size() == 0);
+    assert(!index.contains(0));
+    assert(index.range(0, 10).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Insert Keeps Leaderboard Order
+ *
+ * Highest rating first, equal ratings by id
+ */
+void testInsertOrder()
+{
+    std::cout << "Test 2: Insert order..." << std::endl;
+
+    LeaderboardIndex index;
+    index.insert(0, toRatingValue(1200.0));
+    index.insert(1, toRatingValue(1500.0));
+    index.insert(2, toRatingValue(1200.0));
+    index.insert(3, toRatingValue(1350.0));
+
+    assert(index.size() == 4);
+    assert(index.contains(2));
+
+    const std::vector<PlayerId> order = index.range(0, 4);
+    assert((order == std::vector<PlayerId>{1, 3, 0, 2}));
+
+    assert(index.at(0) == 1);
+    assert(index.at(3) == 2);
+    assert(index.positionOf(1) == 0);
+    assert(index.positionOf(0) == 2);
+    assert(index.positionOf(2) == 3);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Update Moves a Player
+ */
+void testUpdate()
+{
+    std::cout << "Test 3: Update..." << std::endl;
+
+    LeaderboardIndex index;
+    index.insert(0, toRatingValue(1200.0));
+    index.insert(1, toRatingValue(1300.0));
+    index.insert(2, toRatingValue(1400.0));
+
+    index.update(0, toRatingValue(1450.0));
+
+    assert(index.size() == 3);
+    assert(index.at(0) == 0);
+    assert(index.positionOf(2) == 1);
+    assert(index.positionOf(1) == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Range
+ *
+ * Pages in the middle and past the end
+ */
+void testRange()
+{
+    std::cout << "Test 4: Range..." << std::endl;
+
+    LeaderboardIndex index;
+    for (PlayerId id = 0; id < 10; id++)
+    {
+        index.insert(id, toRatingValue(1000.0 + id));
+    }
+
+    assert((index.range(2, 3) == std::vector<PlayerId>{7, 6, 5}));
+    assert((index.range(8, 5) == std::vector<PlayerId>{1, 0}));
+    assert(index.range(10, 5).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Matches a Full Sort
+ *
+ * Many random updates, then the index must agree with
+ * sorting everyone from scratch
+ */
+void testMatchesSort()
+{
+    std::cout << "Test 5: Matches a full sort..." << std::endl;
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> rating(800, 2000);
+
+    std::vector<RatingValue> ratings(500);
+    LeaderboardIndex index;
+
+    for (PlayerId id = 0; id < ratings.size(); id++)
+    {
+        ratings[id] = toRatingValue(rating(random));
+        index.insert(id, ratings[id]);
+    }
+
+    std::uniform_int_distribution<PlayerId> player(0, static_cast<PlayerId>(ratings.size() - 1));
+    for (int i = 0; i < 5000; i++)
+    {
+        const PlayerId id = player(random);
+        ratings[id] = toRatingValue(rating(random));
+        index.update(id, ratings[id]);
+    }
+
+    const std::vector<PlayerId> expected = sortedOrder(ratings);
+    assert(index.range(0, ratings.size()) == expected);
+
+    for (size_t position = 0; position < expected.size(); position++)
+    {
+        assert(index.at(position) == expected[position]);
+        assert(index.positionOf(expected[position]) == position);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 6: Bulk Build
+ *
+ * build() gives the same order as inserting one by one,
+ * and the index keeps working normally afterwards
+ */
+void testBuild()
+{
+    std::cout << "Test 6: Bulk build..." << std::endl;
+
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> rating(800, 2000);
+
+    std::vector<RatingValue> ratings(1000);
+    for (RatingValue& value : ratings)
+    {
+        value = toRatingValue(rating(random));
+    }
+
+    LeaderboardIndex index;
+    index.build(ratings);
+
+    assert(index.size() == ratings.size());
+    assert(index.range(0, ratings.size()) == sortedOrder(ratings));
+    assert(index.positionOf(index.at(500)) == 500);
+
+    ratings[42] = toRatingValue(5000.0);
+    index.update(42, ratings[42]);
+    assert(index.at(0) == 42);
+    assert(index.range(0, ratings.size()) == sortedOrder(ratings));
+
+    index.build({});
+    assert(index.size() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 7: Build From a Known Order
+ *
+ * A correct order is used as it is; a wrong one (out of order,
+ * a repeated id, too short) falls back to sorting, so the tree
+ * is right either way
+ */
+void testBuildWithOrder()
+{
+    std::cout << "Test 7: Build from a known order..." << std::endl;
+
+    std::mt19937 random(12);
+    std::uniform_int_distribution<int> rating(800, 2000);
+
+    std::vector<RatingValue> ratings(1000);
+    for (RatingValue& value : ratings)
+    {
+        value = toRatingValue(rating(random));
+    }
+    const std::vector<PlayerId> expected = sortedOrder(ratings);
+
+    LeaderboardIndex index;
+    index.build(ratings, expected);
+    assert(index.range(0, ratings.size()) == expected);
+    assert(index.positionOf(expected[700]) == 700);
+
+    std::vector<PlayerId> swapped = expected;
+    std::swap(swapped[10], swapped[20]);
+
+    std::vector<PlayerId> repeated = expected;
+    repeated[5] = repeated[4];
+
+    std::vector<PlayerId> outOfRange = expected;
+    outOfRange.back() = 5000;
+
+    std::vector<PlayerId> tooShort(expected.begin(), expected.end() - 1);
+
+    for (const std::vector<PlayerId>* order : {&swapped, &repeated, &outOfRange, &tooShort})
+    {
+        index.build(ratings, *order);
+        assert(index.size() == ratings.size());
+        assert(index.range(0, ratings.size()) == expected);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running LeaderboardIndex Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testEmptyIndex();
+        testInsertOrder();
+        testUpdate();
+        testRange();
+        testMatchesSort();
+        testBuild();
+        testBuildWithOrder();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All LeaderboardIndex tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,161 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/LeaderboardPageCache.h"
+#include <iostream>
+#include <cassert>
+
+/**
+ * TEST 1: Empty Cache
+ */
+void testEmptyCache()
+{
+    std::cout << "Test 1: Empty cache..." << std::endl;
+
+    LeaderboardPageCache cache;
+
+    assert(cache.empty());
+    assert(cache.find(1, 20) == nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Store and Find
+ */
+void testStoreAndFind()
+{
+    std::cout << "Test 2: Store and find..." << std::endl;
+
+    LeaderboardPageCache cache;
+    [[maybe_unused]] const std::string& stored = cache.store(2, 20, "page two");
+
+    assert(!cache.empty());
+    assert(cache.getPageSize() == 20);
+    assert(cache.find(2, 20) == &stored);
+    assert(*cache.find(2, 20) == "page two");
+    assert(cache.find(1, 20) == nullptr);
+    assert(cache.find(3, 20) == nullptr);
+    assert(cache.find(0, 20) == nullptr);
+
+    /**
+     * A different page size does not match
+     */
+    assert(cache.find(2, 10) == nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Invalidate Positions
+ *
+ * Only the pages containing the changed positions are dropped
+ */
+void testInvalidatePositions()
+{
+    std::cout << "Test 3: Invalidate positions..." << std::endl;
+
+    LeaderboardPageCache cache;
+    cache.store(1, 10, "a");
+    cache.store(2, 10, "b");
+    cache.store(3, 10, "c");
+    cache.store(4, 10, "d");
+
+    /**
+     * Positions 12 .. 25 live on pages 2 and 3
+     */
+    cache.invalidatePositions(12, 25);
+
+    assert(cache.find(1, 10) != nullptr);
+    assert(cache.find(2, 10) == nullptr);
+    assert(cache.find(3, 10) == nullptr);
+    assert(cache.find(4, 10) != nullptr);
+
+    /**
+     * Positions past the stored pages are ignored
+     */
+    cache.invalidatePositions(100, 200);
+    assert(cache.find(4, 10) != nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Invalidate From
+ */
+void testInvalidateFrom()
+{
+    std::cout << "Test 4: Invalidate from..." << std::endl;
+
+    LeaderboardPageCache cache;
+    cache.store(1, 10, "a");
+    cache.store(2, 10, "b");
+    cache.store(3, 10, "c");
+
+    cache.invalidateFrom(15);
+
+    assert(cache.find(1, 10) != nullptr);
+    assert(cache.find(2, 10) == nullptr);
+    assert(cache.find(3, 10) == nullptr);
+
+    cache.invalidateFrom(0);
+    assert(cache.empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: New Page Size
+ *
+ * Storing with another page size drops the old pages
+ */
+void testNewPageSize()
+{
+    std::cout << "Test 5: New page size..." << std::endl;
+
+    LeaderboardPageCache cache;
+    cache.store(1, 10, "a");
+    cache.store(1, 25, "b");
+
+    assert(cache.getPageSize() == 25);
+    assert(cache.find(1, 10) == nullptr);
+    assert(*cache.find(1, 25) == "b");
+
+    cache.clear();
+    assert(cache.empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running LeaderboardPageCache Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testEmptyCache();
+        testStoreAndFind();
+        testInvalidatePositions();
+        testInvalidateFrom();
+        testNewPageSize();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All LeaderboardPageCache tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,157 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/LeaderboardRenderer.h"
+#include "../src/Player.h"
+#include <iostream>
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/**
+ * Helper: the row exactly as Player::displayStats prints it
+ */
+std::string displayStatsText(const std::string& name, double rating, int wins, int losses, int draws)
+{
+    Player player(name, rating);
+    for (int i = 0; i < wins; i++)
+    {
+        player.recordWin();
+    }
+    for (int i = 0; i < losses; i++)
+    {
+        player.recordLoss();
+    }
+    for (int i = 0; i < draws; i++)
+    {
+        player.recordDraw();
+    }
+
+    std::ostringstream out;
+    player.displayStats(out);
+    return out.str();
+}
+
+/**
+ * Helper: the same row from the renderer
+ */
+std::string rendererText(const std::string& name, double rating, int wins, int losses, int draws)
+{
+    LeaderboardRenderer renderer;
+    renderer.appendRow(name, rating, wins + losses + draws, wins, losses, draws);
+    return std::string(renderer.text());
+}
+
+/**
+ * TEST 1: Rows Match displayStats
+ *
+ * Byte for byte, including rounding, long names and wide numbers
+ */
+void testRowsMatchDisplayStats()
+{
+    std::cout << "Test 1: Rows match displayStats..." << std::endl;
+
+    assert(rendererText("Alice", 1200.0, 0, 0, 0) == displayStatsText("Alice", 1200.0, 0, 0, 0));
+    assert(rendererText("Bob", 1245.55, 10, 3, 2) == displayStatsText("Bob", 1245.55, 10, 3, 2));
+    assert(rendererText("Charlie", 1234.25, 1, 1, 1) == displayStatsText("Charlie", 1234.25, 1, 1, 1));
+    assert(rendererText("Diana", 0.04, 0, 7, 0) == displayStatsText("Diana", 0.04, 0, 7, 0));
+    assert(rendererText("Eve", 999999.96, 1234567, 0, 0) == displayStatsText("Eve", 999999.96, 1234567, 0, 0));
+
+    const std::string longName = "A name much longer than twenty characters";
+    assert(rendererText(longName, 1500.0, 2, 0, 0) == displayStatsText(longName, 1500.0, 2, 0, 0));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Header
+ *
+ * Same titles and widths as the stream version
+ */
+void testHeader()
+{
+    std::cout << "Test 2: Header..." << std::endl;
+
+    std::ostringstream expected;
+    expected << std::left
+             << std::setw(20) << "Name"
+             << std::setw(10) << "Rating"
+             << std::setw(8) << "Games"
+             << std::setw(6) << "Wins"
+             << std::setw(6) << "Loses"
+             << std::setw(6) << "Draws" << "\n"
+             << std::string(56, '-') << "\n";
+
+    LeaderboardRenderer renderer;
+    renderer.appendHeader();
+    assert(renderer.text() == expected.str());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Chunked Writes
+ *
+ * full() turns true at the chunk size, and writeTo
+ * hands over the text and empties the buffer
+ */
+void testChunkedWrites()
+{
+    std::cout << "Test 3: Chunked writes..." << std::endl;
+
+    LeaderboardRenderer renderer(100);
+    std::ostringstream out;
+    std::string expected;
+
+    int writes = 0;
+    for (int i = 0; i < 20; i++)
+    {
+        renderer.appendRow("Player" + std::to_string(i), 1200.0 + i, i, i, 0, 0);
+        expected += displayStatsText("Player" + std::to_string(i), 1200.0 + i, i, 0, 0);
+
+        if (renderer.full())
+        {
+            renderer.writeTo(out);
+            assert(renderer.text().empty());
+            writes++;
+        }
+    }
+    renderer.writeTo(out);
+
+    assert(writes > 5);
+    assert(out.str() == expected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running LeaderboardRenderer Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRowsMatchDisplayStats();
+        testHeader();
+        testChunkedWrites();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All LeaderboardRenderer tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,223 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/MatchHistory.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+/**
+ * A varied but repeatable match: ids of every size, all three
+ * results, gaps between matches from 0 to a few seconds,
+ * ratings far apart and close together
+ */
+MatchHistoryEntry makeMatch(size_t i)
+{
+    MatchHistoryEntry match;
+    match.timestamp = 1'700'000'000'000 + static_cast<std::int64_t>(i * 37 % 5000) * static_cast<std::int64_t>(i);
+    match.player1 = static_cast<PlayerId>(i * 7919 % 3'000'000);
+    match.player2 = static_cast<PlayerId>(i % 50);
+    match.result = static_cast<MatchResult>(static_cast<int>(i % 3) - 1);
+    match.rating1 = 800.0 + static_cast<double>(i * 104729 % 1500000) / 1000.0;
+    match.rating2 = match.rating1 + static_cast<double>(static_cast<int>(i % 401) - 200);
+    match.change1 = static_cast<double>(static_cast<int>(i % 32001) - 16000) / 1000.0;
+    match.change2 = -match.change1;
+    return match;
+}
+
+/**
+ * Equal to the thousandth of a point
+ */
+bool sameRating(double a, double b)
+{
+    return std::abs(a - b) < 0.0005;
+}
+
+void assertSameMatch([[maybe_unused]] const MatchHistoryEntry& a, [[maybe_unused]] const MatchHistoryEntry& b)
+{
+    assert(a.timestamp == b.timestamp);
+    assert(a.player1 == b.player1);
+    assert(a.player2 == b.player2);
+    assert(a.result == b.result);
+    assert(sameRating(a.rating1, b.rating1));
+    assert(sameRating(a.rating2, b.rating2));
+    assert(sameRating(a.change1, b.change1));
+    assert(sameRating(a.change2, b.change2));
+}
+
+/**
+ * TEST 1: Round Trip
+ *
+ * Every match comes back as it went in, in order, across
+ * full chunks and the one being filled
+ */
+void testRoundTrip()
+{
+    std::cout << "Test 1: Round trip..." << std::endl;
+
+    MatchHistory history;
+    assert(history.size() == 0);
+    assert(history.chunkCount() == 0);
+
+    const size_t count = MatchHistory::ChunkMatches * 2 + 123;
+    for (size_t i = 0; i < count; i++)
+    {
+        history.append(makeMatch(i));
+    }
+    assert(history.size() == count);
+    assert(history.chunkCount() == 3);
+
+    size_t seen = 0;
+    history.forEach([&seen](const MatchHistoryEntry& match)
+    {
+        assertSameMatch(match, makeMatch(seen));
+        seen++;
+    });
+    assert(seen == count);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Rounded Ratings Add Up
+ *
+ * Ratings are kept to 0.001 points; rating + change still gives
+ * the rounded rating after the match
+ */
+void testRounding()
+{
+    std::cout << "Test 2: Rounded ratings add up..." << std::endl;
+
+    MatchHistoryEntry match;
+    match.player1 = 1;
+    match.player2 = 2;
+    match.rating1 = 1200.00049;
+    match.rating2 = 1199.9996;
+    match.change1 = 15.99951;
+    match.change2 = -15.99951;
+
+    MatchHistory history;
+    history.append(match);
+
+    history.forEach([]([[maybe_unused]] const MatchHistoryEntry& stored)
+    {
+        assert(stored.rating1 == 1200.0);
+        assert(stored.rating2 == 1200.0);
+        assert(stored.rating1 + stored.change1 == 1216.0);
+        assert(stored.rating2 + stored.change2 == 1184.0);
+    });
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Time Range
+ *
+ * forEachBetween gives exactly the matches in the range,
+ * also when a timestamp goes back
+ */
+void testBetween()
+{
+    std::cout << "Test 3: Time range..." << std::endl;
+
+    MatchHistory history;
+    std::vector<std::int64_t> times;
+    for (size_t i = 0; i < MatchHistory::ChunkMatches * 3; i++)
+    {
+        MatchHistoryEntry match = makeMatch(i);
+        match.timestamp = static_cast<std::int64_t>(i) * 10;
+        if (i == 5000)
+        {
+            match.timestamp = 5;
+        }
+        times.push_back(match.timestamp);
+        history.append(match);
+    }
+
+    for (const auto& [from, to] : {std::pair<std::int64_t, std::int64_t>{0, 100},
+                                   {45'000, 90'000}, {0, 1'000'000}, {200'000, 300'000}})
+    {
+        size_t expected = 0;
+        for (const std::int64_t time : times)
+        {
+            expected += time >= from && time <= to ? 1 : 0;
+        }
+
+        size_t found = 0;
+        history.forEachBetween(from, to, [&]([[maybe_unused]] const MatchHistoryEntry& match)
+        {
+            assert(match.timestamp >= from && match.timestamp <= to);
+            found++;
+        });
+        assert(found == expected);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Compact
+ *
+ * Far smaller than a vector of entries, and clear frees it all
+ */
+void testMemory()
+{
+    std::cout << "Test 4: Compact..." << std::endl;
+
+    MatchHistory history;
+    const size_t count = MatchHistory::ChunkMatches * 10;
+    for (size_t i = 0; i < count; i++)
+    {
+        history.append(makeMatch(i));
+    }
+
+    assert(history.memoryBytes() < count * sizeof(MatchHistoryEntry) / 2);
+
+    history.clear();
+    assert(history.size() == 0);
+    assert(history.memoryBytes() == sizeof(MatchHistory));
+
+    history.append(makeMatch(1));
+    size_t seen = 0;
+    history.forEach([&seen](const MatchHistoryEntry& match)
+    {
+        assertSameMatch(match, makeMatch(1));
+        seen++;
+    });
+    assert(seen == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running MatchHistory Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRoundTrip();
+        testRounding();
+        testBetween();
+        testMemory();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All MatchHistory tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,272 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/MatchLog.h"
+#include "../src/MappedFile.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * The whole log file as bytes
+ */
+std::string fileBytes(const char* path)
+{
+    const MappedFile file(path);
+    assert(file.isOpen());
+    return std::string(file.text());
+}
+
+/**
+ * Read a log and collect its entries
+ * (names are copied, since the entries point into bytes)
+ */
+std::vector<MatchLogEntry> readAll(std::string_view bytes, std::vector<std::string>& names,
+                                   MatchLogExtent* extent = nullptr)
+{
+    std::vector<MatchLogEntry> entries;
+    const auto read = MatchLog::read(bytes,
+        [&](const MatchLogEntry& entry)
+        {
+            entries.push_back(entry);
+            names.emplace_back(entry.name);
+            return true;
+        });
+    assert(read.has_value());
+    if (extent != nullptr)
+    {
+        *extent = *read;
+    }
+    return entries;
+}
+
+/**
+ * Two players and two matches, synced, numbered from 41
+ */
+void writeSample(const char* path)
+{
+    MatchLog log(path, 0, 41);
+    assert(log.isOpen());
+    log.logPlayer(0, "Alice", 1200.0, PlayerStats{});
+    log.logPlayer(1, "Bob", 1350.25, PlayerStats{3, 1, 1, 1});
+    log.logMatch(0, 1, MatchResult::Player1Wins, 1221.5, 1328.75);
+    log.logMatch(1, 0, MatchResult::Draw, 1327.0, 1223.25);
+    [[maybe_unused]] const bool synced = log.sync();
+    assert(synced);
+}
+
+/**
+ * TEST 1: Write and Read Back
+ */
+void testRoundTrip()
+{
+    std::cout << "Test 1: Write and read back..." << std::endl;
+
+    const char* path = "test_match_log.wal";
+    writeSample(path);
+    const std::string bytes = fileBytes(path);
+
+    std::vector<std::string> names;
+    MatchLogExtent end;
+    const std::vector<MatchLogEntry> entries = readAll(bytes, names, &end);
+
+    assert(end.size == bytes.size());
+    assert(end.firstSequence == 41 && end.nextSequence == 45);
+    assert(bytes.size() == MatchLog::HeaderSize + 2 * MatchLog::PlayerRecordSize + 8 +
+                           2 * MatchLog::MatchRecordSize);
+    assert(entries.size() == 4);
+
+    assert(entries[0].type == MatchLogEntry::Type::PlayerAdded);
+    assert(names[0] == "Alice" && entries[0].player1 == 0 && entries[0].rating1 == 1200.0);
+    assert(entries[0].sequence == 41 && entries[3].sequence == 44);
+    assert(names[1] == "Bob" && entries[1].player1 == 1 && entries[1].stats.draws == 1);
+
+    assert(entries[2].type == MatchLogEntry::Type::MatchRecorded);
+    assert(entries[2].player1 == 0 && entries[2].player2 == 1);
+    assert(entries[2].result == MatchResult::Player1Wins);
+    assert(entries[2].rating1 == 1221.5 && entries[2].rating2 == 1328.75);
+    assert(entries[3].result == MatchResult::Draw);
+
+    assert(MatchLog::read("", [](const MatchLogEntry&) { return true; })->size == 0);
+    assert(MatchLog::read("players.csv", [](const MatchLogEntry&) { return true; }).error() ==
+           RankingError::InvalidMatchLog);
+    assert(MatchLog::read(bytes, [](const MatchLogEntry&) { return false; }).error() ==
+           RankingError::InvalidMatchLog);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Torn or Damaged Tail
+ *
+ * A record cut short or with a wrong CRC ends the log;
+ * reopening cuts it off and appends after the last good record
+ */
+void testTornTail()
+{
+    std::cout << "Test 2: Torn or damaged tail..." << std::endl;
+
+    const char* path = "test_match_log.wal";
+    writeSample(path);
+    const std::string bytes = fileBytes(path);
+    const size_t lastRecord = bytes.size() - MatchLog::MatchRecordSize;
+
+    std::vector<std::string> names;
+    MatchLogExtent end;
+
+    assert(readAll(std::string_view(bytes).substr(0, bytes.size() - 5), names, &end).size() == 3);
+    assert(end.size == lastRecord && end.nextSequence == 44);
+
+    std::string damaged = bytes;
+    damaged[lastRecord + 20] ^= 0x40;
+    assert(readAll(damaged, names, &end).size() == 3);
+    assert(end.size == lastRecord);
+
+    std::string damagedName = bytes;
+    damagedName[damagedName.find("Bob")] = 'R';
+    assert(readAll(damagedName, names, &end).size() == 1);
+
+    {
+        MatchLog log(path, lastRecord);
+        assert(log.isOpen());
+        log.logMatch(0, 1, MatchResult::Player2Wins, 1200.0, 1350.0);
+    }
+
+    names.clear();
+    const std::string reopened = fileBytes(path);
+    const std::vector<MatchLogEntry> entries = readAll(reopened, names, &end);
+    assert(reopened.size() == bytes.size());
+    assert(entries.size() == 4);
+    assert(entries[3].result == MatchResult::Player2Wins);
+    assert(entries[3].sequence == 44);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Group Commit
+ *
+ * Records wait in memory until the group is full;
+ * the destructor commits whatever is left
+ */
+void testGroupCommit()
+{
+    std::cout << "Test 3: Group commit..." << std::endl;
+
+    const char* path = "test_match_log.wal";
+    MatchLogOptions options;
+    options.syncEveryRecords = 4;
+    options.syncInterval = std::chrono::hours(1);
+
+    {
+        MatchLog log(path, 0, 1, options);
+        for (int i = 0; i < 3; i++)
+        {
+            log.logMatch(0, 1, MatchResult::Draw, 1200.0, 1200.0);
+        }
+        assert(fileBytes(path).size() == MatchLog::HeaderSize);
+
+        log.logMatch(0, 1, MatchResult::Draw, 1200.0, 1200.0);
+        assert(fileBytes(path).size() == MatchLog::HeaderSize + 4 * MatchLog::MatchRecordSize);
+
+        log.logMatch(0, 1, MatchResult::Draw, 1200.0, 1200.0);
+        assert(fileBytes(path).size() == MatchLog::HeaderSize + 4 * MatchLog::MatchRecordSize);
+    }
+    assert(fileBytes(path).size() == MatchLog::HeaderSize + 5 * MatchLog::MatchRecordSize);
+
+    options.syncInterval = std::chrono::milliseconds(0);
+    {
+        MatchLog log(path, 0, 1, options);
+        log.logMatch(0, 1, MatchResult::Draw, 1200.0, 1200.0);
+        assert(fileBytes(path).size() == MatchLog::HeaderSize + MatchLog::MatchRecordSize);
+
+        [[maybe_unused]] const bool cleared = log.clear(7);
+        assert(cleared);
+        assert(fileBytes(path).size() == MatchLog::HeaderSize);
+
+        log.logMatch(0, 1, MatchResult::Draw, 1200.0, 1200.0);
+    }
+
+    std::vector<std::string> names;
+    MatchLogExtent extent;
+    assert(readAll(fileBytes(path), names, &extent).size() == 1);
+    assert(extent.firstSequence == 7 && extent.nextSequence == 8);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Idle Log Is Synced
+ *
+ * The last record before a quiet period reaches the file once
+ * syncInterval has passed, without another record or sync()
+ */
+void testIdleSync()
+{
+    std::cout << "Test 4: Idle log is synced..." << std::endl;
+
+    const char* path = "test_match_log.wal";
+    MatchLogOptions options;
+    options.syncEveryRecords = 1000;
+    options.syncInterval = std::chrono::milliseconds(20);
+
+    {
+        MatchLog log(path, 0, 1, options);
+        log.logMatch(0, 1, MatchResult::Player1Wins, 1216.0, 1184.0);
+
+        /**
+         * Give the flusher plenty of time on a busy machine
+         */
+        for (int i = 0; i < 200 && fileBytes(path).size() == MatchLog::HeaderSize; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        assert(fileBytes(path).size() == MatchLog::HeaderSize + MatchLog::MatchRecordSize);
+        assert(log.isHealthy());
+    }
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running MatchLog Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRoundTrip();
+        testTornTail();
+        testGroupCommit();
+        testIdleSync();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All MatchLog tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -51,8 +51,8 @@ void testEqualRatingMatch()
     Player alice{"Alice", 1200.0};
     Player bob{"Bob", 1200.0};
 
-    double initialAlice = alice.getRating();
-    double initialBob = bob.getRating();
+    [[maybe_unused]] double initialAlice = alice.getRating();
+    [[maybe_unused]] double initialBob = bob.getRating();
 
     /**
      * Alice wins
@@ -60,15 +60,15 @@ void testEqualRatingMatch()
     Match match{alice, bob, 1, 32.0};
     match.processMatch();
 
-    double finalAlice = alice.getRating();
-    double finalBob = bob.getRating();
+    [[maybe_unused]] double finalAlice = alice.getRating();
+    [[maybe_unused]] double finalBob = bob.getRating();
 
     /**
      * With equal ratings and K=32:
      * Winner should gain 16 points
      * Loser should lose 16 points
      */
-    double expectedGain = 16.0;
+    [[maybe_unused]] double expectedGain = 16.0;
 
     assert(std::abs(finalAlice - (initialAlice + expectedGain)) < 0.1);
     assert(std::abs(finalBob - (initialBob - expectedGain)) < 0.1);
@@ -111,7 +111,7 @@ void testFavoriteWins()
     match.processMatch();
 
     double finalAlice = alice.getRating();
-    double gainAlice = finalAlice - initialAlice;
+    [[maybe_unused]] double gainAlice = finalAlice - initialAlice;
 
     /**
      * Alice should gain very little (around 2-3 points)
@@ -149,7 +149,7 @@ void testUpsetVictory()
     match.processMatch();
 
     double finalBob = bob.getRating();
-    double gainBob = finalBob - initialBob;
+    [[maybe_unused]] double gainBob = finalBob - initialBob;
 
     /**
      * Bob should gain a lot (around 24-30 points)
@@ -175,8 +175,8 @@ void testDrawMatch()
     Player alice{"Alice", 1200.0};
     Player bob{"Bob", 1200.0};
 
-    double initialAlice = alice.getRating();
-    double initialBob = bob.getRating();
+    [[maybe_unused]] double initialAlice = alice.getRating();
+    [[maybe_unused]] double initialBob = bob.getRating();
 
     /**
      * Draw (result = 0)
@@ -184,8 +184,8 @@ void testDrawMatch()
     Match match{alice, bob, 0, 32.0};
     match.processMatch();
 
-    double finalAlice = alice.getRating();
-    double finalBob = bob.getRating();
+    [[maybe_unused]] double finalAlice = alice.getRating();
+    [[maybe_unused]] double finalBob = bob.getRating();
 
     /**
      * Both should stay at same rating (no change for equal match)
@@ -222,14 +222,14 @@ void testHigherKFactor()
      */
     Match match1{alice1, bob1, 1, 32.0};
     match1.processMatch();
-    double gain1 = alice1.getRating() - 1200.0;
+    [[maybe_unused]] double gain1 = alice1.getRating() - 1200.0;
 
     /**
      * Match 2 with K=64 (double)
      */
     Match match2{alice2, bob2, 1, 64.0};
     match2.processMatch();
-    double gain2 = alice2.getRating() - 1200.0;
+    [[maybe_unused]] double gain2 = alice2.getRating() - 1200.0;
 
     /**
      * With K=64, gains should be roughly double
@@ -286,7 +286,7 @@ void testMultipleMatches()
     Match match1{alice, bob, 1, 32.0};
     match1.processMatch();
 
-    double afterMatch1 = alice.getRating();
+    [[maybe_unused]] double afterMatch1 = alice.getRating();
 
     /**
      * Alice wins second match (against same opponent)
@@ -295,7 +295,7 @@ void testMultipleMatches()
     Match match2{alice, bob, 1, 32.0};
     match2.processMatch();
 
-    double afterMatch2 = alice.getRating();
+    [[maybe_unused]] double afterMatch2 = alice.getRating();
 
     /**
      * Both matches should update ratings
@@ -325,7 +325,7 @@ void testZeroSumWithoutDraw()
     Player alice{"Alice", 1500.0};
     Player bob{"Bob", 1100.0};
 
-    double totalBefore = alice.getRating() + bob.getRating();
+    [[maybe_unused]] double totalBefore = alice.getRating() + bob.getRating();
 
     /**
      * Alice wins
@@ -333,7 +333,7 @@ void testZeroSumWithoutDraw()
     Match match{alice, bob, 1, 32.0};
     match.processMatch();
 
-    double totalAfter = alice.getRating() + bob.getRating();
+    [[maybe_unused]] double totalAfter = alice.getRating() + bob.getRating();
 
     /**
      * Without draw, total points should be conserved
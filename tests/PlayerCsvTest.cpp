@@ -0,0 +1,367 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/PlayerCsv.h"
+#include "../src/Crc32.h"
+#include "../src/MappedFile.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * TEST 1: Parse a Row
+ */
+void testParseRow()
+{
+    std::cout << "Test 1: Parse a row..." << std::endl;
+
+    PlayerCsvRow row;
+    assert(PlayerCsv::parseRow("Alice,1245.5,15,10,3,2", row));
+
+    assert(row.name == "Alice");
+    assert(row.rating == 1245.5);
+    assert(row.gamesPlayed == 15);
+    assert(row.wins == 10);
+    assert(row.losses == 3);
+    assert(row.draws == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Tolerated Variations
+ *
+ * Windows line endings, spaces before numbers, names with spaces
+ */
+void testVariations()
+{
+    std::cout << "Test 2: Tolerated variations..." << std::endl;
+
+    PlayerCsvRow row;
+
+    assert(PlayerCsv::parseRow("Bob,1210,12,7,4,1\r", row));
+    assert(row.name == "Bob");
+    assert(row.draws == 1);
+
+    assert(PlayerCsv::parseRow("Mary Ann, 1300.25, 3, 1, 1, 1", row));
+    assert(row.name == "Mary Ann");
+    assert(row.rating == 1300.25);
+    assert(row.losses == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Malformed Rows Are Rejected
+ */
+void testMalformedRows()
+{
+    std::cout << "Test 3: Malformed rows..." << std::endl;
+
+    PlayerCsvRow row;
+
+    assert(!PlayerCsv::parseRow("", row));
+    assert(!PlayerCsv::parseRow("Alice", row));
+    assert(!PlayerCsv::parseRow("Alice,1200", row));
+    assert(!PlayerCsv::parseRow("Alice,abc,1,1,0,0", row));
+    assert(!PlayerCsv::parseRow("Alice,1200,1,1,0", row));
+    assert(!PlayerCsv::parseRow("Alice,1200;1,1,0,0", row));
+    assert(!PlayerCsv::parseRow("Alice,nan,1,1,0,0", row));
+    assert(!PlayerCsv::parseRow("Alice,inf,1,1,0,0", row));
+    assert(!PlayerCsv::parseRow("Alice,-infinity,1,1,0,0", row));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Every Row of a Text
+ *
+ * Valid rows are visited in order, the rest are counted as skipped
+ * A missing final line break does not lose the last row
+ */
+void testForEachRow()
+{
+    std::cout << "Test 4: Every row of a text..." << std::endl;
+
+    const std::string text = "Alice,1245.5,15,10,3,2\n"
+                             "\n"
+                             "broken line\n"
+                             "Bob,1210,12,7,4,1";
+
+    std::vector<std::string> names;
+    [[maybe_unused]] const size_t skipped = PlayerCsv::forEachRow(text,
+        [&names](const PlayerCsvRow& row)
+        {
+            names.emplace_back(row.name);
+        });
+
+    assert((names == std::vector<std::string>{"Alice", "Bob"}));
+    assert(skipped == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Mapped File
+ *
+ * The mapped text is exactly the file's contents;
+ * a missing file is reported, an empty file is just empty
+ */
+void testMappedFile()
+{
+    std::cout << "Test 5: Mapped file..." << std::endl;
+
+    const char* path = "test_mapped_file.csv";
+    {
+        std::ofstream file(path);
+        file << "Alice,1245.5,15,10,3,2\n";
+    }
+
+    {
+        MappedFile file(path);
+        assert(file.isOpen());
+        assert(file.text() == "Alice,1245.5,15,10,3,2\n");
+    }
+
+    {
+        std::ofstream file(path, std::ios::trunc);
+    }
+    {
+        MappedFile file(path);
+        assert(file.isOpen());
+        assert(file.text().empty());
+    }
+
+    std::remove(path);
+
+    MappedFile missing("no_such_file.csv");
+    assert(!missing.isOpen());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 6: Split Into Chunks
+ *
+ * The chunks cover the whole text in order and
+ * every chunk but the last ends with a line break
+ */
+void testSplitChunks()
+{
+    std::cout << "Test 6: Split into chunks..." << std::endl;
+
+    std::string text;
+    for (int i = 0; i < 100; i++)
+    {
+        text += "Player" + std::to_string(i) + ",1200,0,0,0,0\n";
+    }
+    text += "Last,1200,0,0,0,0";
+
+    for (size_t count : {1, 2, 3, 7, 1000})
+    {
+        const std::vector<std::string_view> chunks = PlayerCsv::splitChunks(text, count);
+        assert(!chunks.empty());
+        assert(chunks.size() <= count);
+
+        std::string joined;
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            if (i + 1 < chunks.size())
+            {
+                assert(chunks[i].back() == '\n');
+            }
+            joined += chunks[i];
+        }
+        assert(joined == text);
+    }
+
+    assert(PlayerCsv::splitChunks("", 4).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 7: Write a Row
+ *
+ * appendRow writes the same layout parseRow reads,
+ * with the shortest rating text that keeps the exact value
+ */
+void testAppendRow()
+{
+    std::cout << "Test 7: Write a row..." << std::endl;
+
+    std::string text;
+    PlayerCsv::appendRow(text, PlayerCsvRow{"Alice", 1245.5, 15, 10, 3, 2});
+    PlayerCsv::appendRow(text, PlayerCsvRow{"Bob", 1200.0, 0, 0, 0, 0});
+    assert(text == "Alice,1245.5,15,10,3,2\nBob,1200,0,0,0,0\n");
+
+    const double ratings[] = {0.1 + 0.2, 1234.5678901234567, 1e-300, 1987654.125, 0.0};
+    for (const double rating : ratings)
+    {
+        std::string line;
+        PlayerCsv::appendRow(line, PlayerCsvRow{"Eve", rating, 2147483647, 1, 2, 3});
+        assert(line.back() == '\n');
+
+        PlayerCsvRow row;
+        assert(PlayerCsv::parseRow(std::string_view(line).substr(0, line.size() - 1), row));
+        assert(row.name == "Eve");
+        assert(row.rating == rating);
+        assert(row.gamesPlayed == 2147483647);
+        assert(row.draws == 3);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 8: Checksum Line
+ *
+ * A matching footer is removed, a mismatching one is refused,
+ * a missing one is refused after the header, and text without
+ * a footer is left as it is
+ */
+void testChecksum()
+{
+    std::cout << "Test 8: Checksum line..." << std::endl;
+
+    const std::string rows = "Alice,1245.5,15,10,3,2\nBob,1210,12,7,4,1\n";
+
+    std::string saved = rows;
+    PlayerCsv::appendChecksum(saved, Crc32::compute(rows));
+    assert(saved.size() == rows.size() + PlayerCsv::ChecksumPrefix.size() + 9);
+
+    std::string_view text = saved;
+    assert(PlayerCsv::verifyChecksum(text));
+    assert(text == rows);
+
+    std::string windows = saved + "\r\n";
+    text = windows;
+    assert(PlayerCsv::verifyChecksum(text));
+    assert(text == rows);
+
+    std::string damaged = saved;
+    damaged[3] = 'x';
+    text = damaged;
+    assert(!PlayerCsv::verifyChecksum(text));
+
+    const std::string truncated = saved.substr(rows.size() - 10);
+    text = truncated;
+    assert(!PlayerCsv::verifyChecksum(text));
+
+    text = rows;
+    assert(PlayerCsv::verifyChecksum(text));
+    assert(text == rows);
+
+    /**
+     * Only "#crc32," and exactly 8 hex digits is a checksum line;
+     * anything else is a row (here malformed ones)
+     */
+    for (const std::string last : {"#crc32,12zz", "#crc32,1234567", "#crc32,1200,0,0,0,0"})
+    {
+        const std::string other = rows + last + "\n";
+        text = other;
+        assert(PlayerCsv::verifyChecksum(text));
+        assert(text == other);
+    }
+
+    /**
+     * With the header, the rows come back without it, and a file
+     * that lost its checksum line is refused
+     */
+    const std::string header = std::string(PlayerCsv::ChecksumHeader) + "\n";
+    std::string withHeader = header + rows;
+    PlayerCsv::appendChecksum(withHeader, Crc32::compute(header + rows));
+    text = withHeader;
+    assert(PlayerCsv::verifyChecksum(text));
+    assert(text == rows);
+
+    const std::string lostFooter = header + rows;
+    text = lostFooter;
+    assert(!PlayerCsv::verifyChecksum(text));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 9: Sequence Line
+ *
+ * A sequence line at the end is read and removed; anything
+ * that is not exactly the prefix and a number is left alone
+ */
+void testSequence()
+{
+    std::cout << "Test 9: Sequence line..." << std::endl;
+
+    const std::string rows = "Alice,1245.5,15,10,3,2\nBob,1210,12,7,4,1\n";
+
+    std::string saved = rows;
+    PlayerCsv::appendSequence(saved, 18446744073709551615ull);
+    assert(saved == rows + "#sequence,18446744073709551615\n");
+
+    std::string_view text = saved;
+    std::uint64_t sequence = 0;
+    [[maybe_unused]] const bool found = PlayerCsv::readSequence(text, sequence);
+    assert(found);
+    assert(sequence == 18446744073709551615ull);
+    assert(text == rows);
+
+    const std::string windows = rows + "#sequence,7\r\n";
+    text = windows;
+    assert(PlayerCsv::readSequence(text, sequence));
+    assert(sequence == 7);
+    assert(text == rows);
+
+    for (const std::string last : {"#sequence,", "#sequence,12x", "#sequence,-1", "#sequence,1,2,3,4,5"})
+    {
+        const std::string other = rows + last + "\n";
+        text = other;
+        assert(!PlayerCsv::readSequence(text, sequence));
+        assert(text == other);
+    }
+
+    text = rows;
+    assert(!PlayerCsv::readSequence(text, sequence));
+    assert(text == rows);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running PlayerCsv Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testParseRow();
+        testVariations();
+        testMalformedRows();
+        testForEachRow();
+        testMappedFile();
+        testSplitChunks();
+        testAppendRow();
+        testChecksum();
+        testSequence();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All PlayerCsv tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
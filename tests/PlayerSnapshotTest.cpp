@@ -0,0 +1,305 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/PlayerSnapshot.h"
+#include "../src/MappedFile.h"
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * Write a snapshot of table to a file and return the file's bytes
+ */
+std::string snapshotBytes(const PlayerTable& table, std::span<const PlayerId> order, FileChecksum checksum,
+                          std::uint64_t logSequence = 0)
+{
+    const char* path = "test_player_snapshot.bin";
+    {
+        AtomicFileWriter file(path);
+        [[maybe_unused]] const bool written = PlayerSnapshot::write(file, table, order, logSequence, checksum);
+        assert(written);
+        [[maybe_unused]] const bool committed = file.commit();
+        assert(committed);
+    }
+
+    std::string bytes;
+    {
+        const MappedFile file(path);
+        assert(file.isOpen());
+        bytes = std::string(file.text());
+    }
+    std::remove(path);
+    return bytes;
+}
+
+/**
+ * A small table used by every test
+ */
+PlayerTable sampleTable()
+{
+    PlayerTable table;
+    table.addRow("Alice", 1245.5, PlayerStats{15, 10, 3, 2});
+    table.addRow("Bob", 1210.0);
+    table.addRow("", 1000.0);
+    table.addRow("Charlie the Great", 1388.9, PlayerStats{4, 1, 1, 2});
+    return table;
+}
+
+/**
+ * TEST 1: Write and Read Back
+ */
+void testRoundTrip()
+{
+    std::cout << "Test 1: Write and read back..." << std::endl;
+
+    const PlayerTable table = sampleTable();
+    const std::vector<PlayerId> order = {3, 0, 1, 2};
+
+    for (const FileChecksum checksum : {FileChecksum::None, FileChecksum::Crc32Footer})
+    {
+        const std::string bytes = snapshotBytes(table, order, checksum);
+        const auto snapshot = PlayerSnapshot::open(bytes);
+        assert(snapshot.has_value());
+
+        assert(snapshot->size() == 4);
+        for (size_t i = 0; i < table.size(); i++)
+        {
+            assert(snapshot->name(i) == table.getName(i));
+            assert(snapshot->record(i).rating == table.getRating(i));
+            assert(snapshot->stats(i).wins == table.getWins(i));
+            assert(snapshot->stats(i).gamesPlayed == table.getGamesPlayed(i));
+        }
+
+        assert(snapshot->hasLeaderboardOrder());
+        assert(snapshot->leaderboardOrder() == order);
+    }
+
+    const std::string withoutOrder = snapshotBytes(table, {}, FileChecksum::None);
+    const auto snapshot = PlayerSnapshot::open(withoutOrder);
+    assert(snapshot.has_value());
+    assert(!snapshot->hasLeaderboardOrder());
+    assert(snapshot->leaderboardOrder().empty());
+
+    const std::string empty = snapshotBytes(PlayerTable{}, {}, FileChecksum::Crc32Footer);
+    assert(PlayerSnapshot::open(empty).has_value());
+    assert(PlayerSnapshot::open(empty)->size() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Not a Snapshot
+ *
+ * Wrong magic, another version, or too short to hold a header
+ */
+void testRejectsHeader()
+{
+    std::cout << "Test 2: Rejects a bad header..." << std::endl;
+
+    const std::string bytes = snapshotBytes(sampleTable(), {}, FileChecksum::None);
+
+    assert(PlayerSnapshot::open("").error() == RankingError::InvalidSnapshot);
+    assert(PlayerSnapshot::open("Alice,1245.5,15,10,3,2\n").error() == RankingError::InvalidSnapshot);
+    assert(PlayerSnapshot::open(std::string_view(bytes).substr(0, 63)).error() == RankingError::InvalidSnapshot);
+
+    std::string wrongMagic = bytes;
+    wrongMagic[0] = 'X';
+    assert(PlayerSnapshot::open(wrongMagic).error() == RankingError::InvalidSnapshot);
+
+    std::string newerVersion = bytes;
+    const std::uint32_t version = PlayerSnapshot::Version + 1;
+    std::memcpy(newerVersion.data() + offsetof(SnapshotHeader, version), &version, sizeof(version));
+    assert(PlayerSnapshot::open(newerVersion).error() == RankingError::InvalidSnapshot);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Bad Contents
+ *
+ * A file cut short, name offsets out of order, counters that do not add up,
+ * a rating that is not a number, a name starting with '#'
+ */
+void testRejectsContents()
+{
+    std::cout << "Test 3: Rejects bad contents..." << std::endl;
+
+    const std::vector<PlayerId> order = {3, 0, 1, 2};
+    const std::string bytes = snapshotBytes(sampleTable(), order, FileChecksum::None);
+    const size_t recordsOffset = sizeof(SnapshotHeader);
+
+    assert(PlayerSnapshot::open(std::string_view(bytes).substr(0, bytes.size() - 1)).error() ==
+           RankingError::InvalidSnapshot);
+
+    std::string badOffset = bytes;
+    const std::uint64_t offset = 1000;
+    std::memcpy(badOffset.data() + recordsOffset + sizeof(SnapshotRecord), &offset, sizeof(offset));
+    assert(PlayerSnapshot::open(badOffset).error() == RankingError::InvalidSnapshot);
+
+    std::string badStats = bytes;
+    const std::int32_t wins = 99;
+    std::memcpy(badStats.data() + recordsOffset + offsetof(SnapshotRecord, wins), &wins, sizeof(wins));
+    assert(PlayerSnapshot::open(badStats).error() == RankingError::InvalidSnapshot);
+
+    std::string badRating = bytes;
+    const double rating = std::numeric_limits<double>::quiet_NaN();
+    std::memcpy(badRating.data() + recordsOffset + offsetof(SnapshotRecord, rating), &rating, sizeof(rating));
+    assert(PlayerSnapshot::open(badRating).error() == RankingError::InvalidSnapshot);
+
+    for (const std::string_view name : {"Bob", "Charlie"})
+    {
+        std::string reservedName = bytes;
+        reservedName[reservedName.find(name)] = '#';
+        assert(PlayerSnapshot::open(reservedName).error() == RankingError::InvalidSnapshot);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Checksum
+ *
+ * Without a checksum a changed name goes unnoticed;
+ * with one it is caught
+ */
+void testChecksum()
+{
+    std::cout << "Test 4: Checksum..." << std::endl;
+
+    const PlayerTable table = sampleTable();
+
+    std::string plain = snapshotBytes(table, {}, FileChecksum::None);
+    plain[plain.find("Alice")] = 'E';
+    assert(PlayerSnapshot::open(plain).has_value());
+
+    std::string checked = snapshotBytes(table, {}, FileChecksum::Crc32Footer);
+    checked[checked.find("Alice")] = 'E';
+    assert(PlayerSnapshot::open(checked).error() == RankingError::ChecksumMismatch);
+
+    const std::string cut = snapshotBytes(table, {}, FileChecksum::Crc32Footer);
+    assert(!PlayerSnapshot::open(std::string_view(cut).substr(0, cut.size() - 3)).has_value());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Log Sequence
+ *
+ * The log sequence comes back
+ */
+void testLogSequence()
+{
+    std::cout << "Test 5: Log sequence..." << std::endl;
+
+    const PlayerTable table = sampleTable();
+    const std::vector<PlayerId> order = {3, 0, 1, 2};
+
+    const std::string bytes = snapshotBytes(table, order, FileChecksum::None, 123456789012ull);
+    const auto snapshot = PlayerSnapshot::open(bytes);
+    assert(snapshot.has_value());
+    assert(snapshot->logSequence() == 123456789012ull);
+    assert(!snapshot->isDelta());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 6: Deltas
+ *
+ * A delta holds some players by id, and the sequences it goes from
+ * and to; ids out of order are refused
+ */
+void testDelta()
+{
+    std::cout << "Test 6: Deltas..." << std::endl;
+
+    PlayerTable rows;
+    rows.addRow("", 1250.5, PlayerStats{16, 11, 3, 2});
+    rows.addRow("Newcomer", 1200.0);
+    const std::vector<PlayerId> ids = {0, 4};
+
+    const char* path = "test_player_delta.bin";
+    {
+        AtomicFileWriter file(path);
+        [[maybe_unused]] const bool written = PlayerSnapshot::writeDelta(file, rows, ids, 40, 47, FileChecksum::Crc32Footer);
+        assert(written);
+        [[maybe_unused]] const bool committed = file.commit();
+        assert(committed);
+    }
+
+    {
+        const MappedFile file(path);
+        const auto delta = PlayerSnapshot::open(file.text());
+        assert(delta.has_value());
+        assert(delta->isDelta());
+        assert(delta->baseSequence() == 40);
+        assert(delta->logSequence() == 47);
+        assert(delta->size() == 2);
+        assert(delta->playerId(0) == 0 && delta->playerId(1) == 4);
+        assert(delta->name(0).empty() && delta->name(1) == "Newcomer");
+        assert(delta->stats(0).wins == 11);
+        assert(delta->record(1).rating == 1200.0);
+    }
+
+    const std::vector<PlayerId> backwards = {4, 0};
+    {
+        AtomicFileWriter file(path);
+        [[maybe_unused]] const bool written = PlayerSnapshot::writeDelta(file, rows, backwards, 40, 47, FileChecksum::None);
+        assert(written);
+        [[maybe_unused]] const bool committed = file.commit();
+        assert(committed);
+    }
+    {
+        const MappedFile file(path);
+        assert(PlayerSnapshot::open(file.text()).error() == RankingError::InvalidSnapshot);
+    }
+
+    /**
+     * A full snapshot numbers its players by row
+     */
+    const std::string bytes = snapshotBytes(sampleTable(), {}, FileChecksum::None);
+    assert(PlayerSnapshot::open(bytes)->playerId(2) == 2);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running PlayerSnapshot Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRoundTrip();
+        testRejectsHeader();
+        testRejectsContents();
+        testChecksum();
+        testLogSequence();
+        testDelta();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All PlayerSnapshot tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,255 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/PlayerTable.h"
+#include "../src/Player.h"
+#include <iostream>
+#include <cassert>
+
+/**
+ * TEST 1: Empty Table
+ *
+ * A new table has no rows
+ */
+void testEmptyTable()
+{
+    std::cout << "Test 1: Empty table..." << std::endl;
+
+    PlayerTable table;
+
+    assert(table.size() == 0);
+    assert(table.getRatingColumn().empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Add Rows
+ *
+ * Rows are numbered in the order they are added
+ * and every column gets one entry per row
+ */
+void testAddRows()
+{
+    std::cout << "Test 2: Add rows..." << std::endl;
+
+    PlayerTable table;
+
+    [[maybe_unused]] const size_t alice = table.addRow("Alice", 1200.0);
+    [[maybe_unused]] const size_t bob = table.addRow("Bob", 1500.0);
+
+    assert(alice == 0);
+    assert(bob == 1);
+    assert(table.size() == 2);
+
+    assert(table.getName(bob) == "Bob");
+    assert(table.getRating(bob) == 1500.0);
+    assert(table.getGamesPlayed(bob) == 0);
+
+    assert(table.getNameColumn().size() == 2);
+    assert(table.getWinsColumn().size() == 2);
+    assert(table.getDrawsColumn().size() == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Negative Rating Clamped
+ *
+ * addRow applies the same rule as the Player constructor
+ */
+void testNegativeRatingClamped()
+{
+    std::cout << "Test 3: Negative rating clamped..." << std::endl;
+
+    PlayerTable table;
+
+    [[maybe_unused]] const size_t row = table.addRow("Charlie", -50.0);
+
+    assert(table.getRating(row) == 0.0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Columns Are Contiguous
+ *
+ * The rating column is one array, in row order
+ */
+void testRatingColumn()
+{
+    std::cout << "Test 4: Rating column..." << std::endl;
+
+    PlayerTable table;
+
+    table.addRow("Alice", 1100.0);
+    table.addRow("Bob", 1200.0);
+    table.addRow("Charlie", 1300.0);
+
+    const std::span<const RatingValue> ratings = table.getRatingColumn();
+
+    assert(ratings.size() == 3);
+    assert(ratings[0] == toRatingValue(1100.0));
+    assert(ratings[1] == toRatingValue(1200.0));
+    assert(ratings[2] == toRatingValue(1300.0));
+
+    /**
+     * Consecutive players sit next to each other in memory
+     */
+    assert(&ratings[1] == &ratings[0] + 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 5: Counters Update One Row
+ *
+ * Recording a result only touches that player's row
+ */
+void testRecordResults()
+{
+    std::cout << "Test 5: Record results..." << std::endl;
+
+    PlayerTable table;
+
+    const size_t alice = table.addRow("Alice", 1200.0);
+    const size_t bob = table.addRow("Bob", 1200.0);
+
+    table.recordWin(alice);
+    table.recordLoss(bob);
+    table.recordDraw(alice);
+    table.updateRating(bob, 1184.0);
+
+    assert(table.getWins(alice) == 1);
+    assert(table.getDraws(alice) == 1);
+    assert(table.getGamesPlayed(alice) == 2);
+    assert(table.getLosses(alice) == 0);
+
+    assert(table.getLosses(bob) == 1);
+    assert(table.getGamesPlayed(bob) == 1);
+    assert(table.getRating(bob) == 1184.0);
+    assert(table.getRating(alice) == 1200.0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 6: Player Handle Views a Row
+ *
+ * A Player created from (table, row) reads and writes that row
+ */
+void testPlayerHandle()
+{
+    std::cout << "Test 6: Player handle views a row..." << std::endl;
+
+    PlayerTable table;
+
+    table.addRow("Alice", 1200.0);
+    const size_t bob = table.addRow("Bob", 1300.0);
+
+    Player handle{table, bob};
+
+    assert(handle.getName() == "Bob");
+    assert(handle.getRating() == 1300.0);
+
+    handle.recordWin();
+    handle.updateRating(1316.0);
+
+    /**
+     * The change is visible through the table itself
+     */
+    assert(table.getWins(bob) == 1);
+    assert(table.getRating(bob) == 1316.0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 7: Clear
+ *
+ * clear() removes every row from every column
+ */
+void testClear()
+{
+    std::cout << "Test 7: Clear..." << std::endl;
+
+    PlayerTable table;
+
+    table.addRow("Alice", 1200.0);
+    table.addRow("Bob", 1200.0);
+    table.clear();
+
+    assert(table.size() == 0);
+    assert(table.getGamesPlayedColumn().empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 8: Copy Values
+ *
+ * copyValues() takes one row's rating and counters from another
+ * table and leaves the name and the other rows alone
+ */
+void testCopyValues()
+{
+    std::cout << "Test 8: Copy values..." << std::endl;
+
+    PlayerTable table;
+    table.addRow("Alice", 1200.0);
+    table.addRow("Bob", 1200.0);
+
+    PlayerTable copy = table;
+
+    table.recordWin(1);
+    table.recordDraw(1);
+    table.updateRating(1, 1216.5);
+    table.recordLoss(0);
+
+    copy.copyValues(1, table, 1);
+
+    assert(copy.getName(1) == "Bob");
+    assert(copy.getRating(1) == 1216.5);
+    assert(copy.getGamesPlayed(1) == 2);
+    assert(copy.getWins(1) == 1);
+    assert(copy.getDraws(1) == 1);
+    assert(copy.getLosses(0) == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running PlayerTable Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testEmptyTable();
+        testAddRows();
+        testNegativeRatingClamped();
+        testRatingColumn();
+        testRecordResults();
+        testPlayerHandle();
+        testClear();
+        testCopyValues();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All PlayerTable tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}
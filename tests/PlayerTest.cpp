@@ -16,6 +16,7 @@
 #include "../src/Player.h"
 #include <iostream>
 #include <cassert>
+#include <limits>
 
 /**
  * ASSERTION HELPER
@@ -303,6 +304,41 @@ void testDecimalRatingPrecision()
     std::cout << "  PASSED" << std::endl;
 }
 
+/**
+ * TEST 11: Restore From Saved Counters
+ *
+ * Player::restore sets every counter in one step,
+ * and refuses counters that cannot be right
+ */
+void testRestore()
+{
+    std::cout << "Test 11: Restore from saved counters..." << std::endl;
+
+    std::expected<Player, RankingError> veteran = Player::restore("Kate", 1845.5, {50000, 30000, 15000, 5000});
+
+    assert(veteran.has_value());
+    assert(veteran->getName() == "Kate");
+    assert(veteran->getRating() == 1845.5);
+    assert(veteran->getGamesPlayed() == 50000);
+    assert(veteran->getWins() == 30000);
+    assert(veteran->getLosses() == 15000);
+    assert(veteran->getDraws() == 5000);
+
+    /**
+     * The restored player keeps counting from there
+     */
+    veteran->recordWin();
+    assert(veteran->getGamesPlayed() == 50001);
+    assert(veteran->getWins() == 30001);
+
+    assert(Player::restore("Liam", 1200.0, {10, 5, 3, 1}).error() == RankingError::InconsistentStats);
+    assert(Player::restore("Mia", 1200.0, {0, 1, -1, 0}).error() == RankingError::InconsistentStats);
+    assert(Player::restore("Noah", std::numeric_limits<double>::quiet_NaN(), {}).error() ==
+           RankingError::InvalidRating);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 /**
  * MAIN TEST RUNNER
  *
@@ -328,6 +364,7 @@ int main()
         testUpdateRating();
         testRatingAtZero();
         testDecimalRatingPrecision();
+        testRestore();
 
         std::cout << std::endl;
         std::cout << "========================================" << std::endl;
@@ -4,7 +4,15 @@
 #include "../src/RankingSystem.h"
 #include <iostream>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <vector>
 
 /**
  * TEST 1: Create Empty System
@@ -40,11 +48,17 @@ void testAddSinglePlayer()
     /**
      * Find the player to verify they exist
      */
-    Player* p = system.findPlayer("Alice");
+    [[maybe_unused]] const Player* p = system.findPlayer("Alice");
     assert(p != nullptr);
     assert(p->getName() == "Alice");
     assert(p->getRating() == 1200.0);
 
+    /**
+     * Handles are read-only: a write through one would skip the leaderboard and the match log
+     */
+    static_assert(std::is_same_v<decltype(system.findPlayer("Alice")), const Player*>);
+    static_assert(std::is_same_v<decltype(system.getPlayer(0)), const Player&>);
+
     std::cout << "  PASSED" << std::endl;
 }
 
@@ -85,7 +99,7 @@ void testAddPlayerCustomRating()
 
     system.addPlayer("Alice", 1500.0);
 
-    Player* p = system.findPlayer("Alice");
+    [[maybe_unused]] const Player* p = system.findPlayer("Alice");
     assert(p != nullptr);
     assert(p->getRating() == 1500.0);
 
@@ -127,7 +141,7 @@ void testFindNonexistent()
 
     system.addPlayer("Alice");
 
-    Player* p = system.findPlayer("Bob");
+    [[maybe_unused]] const Player* p = system.findPlayer("Bob");
     assert(p == nullptr);
 
     std::cout << "  PASSED" << std::endl;
@@ -147,11 +161,11 @@ void testRecordMatch()
     system.addPlayer("Alice", 1200.0);
     system.addPlayer("Bob", 1200.0);
 
-    Player* alice = system.findPlayer("Alice");
-    Player* bob = system.findPlayer("Bob");
+    const Player* alice = system.findPlayer("Alice");
+    const Player* bob = system.findPlayer("Bob");
 
-    double initialAliceRating = alice->getRating();
-    double initialBobRating = bob->getRating();
+    [[maybe_unused]] double initialAliceRating = alice->getRating();
+    [[maybe_unused]] double initialBobRating = bob->getRating();
 
     /**
      * Record a match where Alice wins
@@ -196,7 +210,7 @@ void testMatchNonexistent()
      * Alice should not have any games recorded
      * (because match failed)
      */
-    Player* alice = system.findPlayer("Alice");
+    [[maybe_unused]] const Player* alice = system.findPlayer("Alice");
     assert(alice->getGamesPlayed() == 0);
 
     std::cout << "  PASSED" << std::endl;
@@ -298,8 +312,8 @@ void testLoadFromFile()
          */
         assert(system2.getPlayerCount() == 2);
 
-        Player* alice = system2.findPlayer("Alice");
-        Player* bob = system2.findPlayer("Bob");
+        [[maybe_unused]] const Player* alice = system2.findPlayer("Alice");
+        [[maybe_unused]] const Player* bob = system2.findPlayer("Bob");
 
         assert(alice != nullptr);
         assert(bob != nullptr);
@@ -344,9 +358,9 @@ void testMultipleMatchesInSystem()
     /**
      * Verify game counts
      */
-    Player* alice = system.findPlayer("Alice");
-    Player* bob = system.findPlayer("Bob");
-    Player* charlie = system.findPlayer("Charlie");
+    [[maybe_unused]] const Player* alice = system.findPlayer("Alice");
+    [[maybe_unused]] const Player* bob = system.findPlayer("Bob");
+    [[maybe_unused]] const Player* charlie = system.findPlayer("Charlie");
 
     assert(alice->getGamesPlayed() == 2);
     assert(bob->getGamesPlayed() == 2);
@@ -379,6 +393,1303 @@ void testLoadNonexistent()
     std::cout << "  PASSED" << std::endl;
 }
 
+/**
+ * TEST 13: Player Ids
+ *
+ * Verify that addPlayer hands out dense ids in order
+ * and that duplicates are rejected
+ */
+void testPlayerIds()
+{
+    std::cout << "Test 13: Player ids..." << std::endl;
+
+    RankingSystem system;
+
+    [[maybe_unused]] const PlayerId alice = system.addPlayer("Alice").value();
+    [[maybe_unused]] const PlayerId bob = system.addPlayer("Bob", 1500.0).value();
+    const auto duplicate = system.addPlayer("Alice");
+
+    assert(alice == 0);
+    assert(bob == 1);
+    assert(!duplicate.has_value());
+
+    assert(system.findPlayerId("Bob") == bob);
+    assert(system.findPlayerId("Charlie") == InvalidPlayerId);
+
+    assert(system.hasPlayer(bob));
+    assert(!system.hasPlayer(InvalidPlayerId));
+
+    assert(system.getPlayer(bob).getName() == "Bob");
+    assert(system.getPlayer(bob).getRating() == 1500.0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 14: Record Match by Id
+ *
+ * Verify that the id-based overload updates ratings and counters
+ * exactly like the name-based one
+ */
+void testRecordMatchById()
+{
+    std::cout << "Test 14: Record match by id..." << std::endl;
+
+    RankingSystem byName;
+    byName.addPlayer("Alice", 1300.0);
+    byName.addPlayer("Bob", 1200.0);
+    byName.recordMatch("Alice", "Bob", -1);
+
+    RankingSystem byId;
+    const PlayerId alice = byId.addPlayer("Alice", 1300.0).value();
+    const PlayerId bob = byId.addPlayer("Bob", 1200.0).value();
+    [[maybe_unused]] const auto byIdStatus = byId.recordMatch(alice, bob, MatchResult::Player2Wins);
+    assert(byIdStatus == MatchStatus::Recorded);
+
+    assert(byId.getPlayer(alice).getRating() == byName.findPlayer("Alice")->getRating());
+    assert(byId.getPlayer(bob).getRating() == byName.findPlayer("Bob")->getRating());
+    assert(byId.getPlayer(alice).getLosses() == 1);
+    assert(byId.getPlayer(bob).getWins() == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 15: Record Match with Invalid Ids
+ *
+ * Verify that unknown ids, self-matches and bad K-factors are rejected
+ */
+void testRecordMatchInvalidIds()
+{
+    std::cout << "Test 15: Record match with invalid ids..." << std::endl;
+
+    RankingSystem system;
+    const PlayerId alice = system.addPlayer("Alice").value();
+
+    [[maybe_unused]] const auto status = system.recordMatch(alice, InvalidPlayerId, MatchResult::Player1Wins);
+    assert(status == MatchStatus::UnknownPlayer);
+    [[maybe_unused]] const auto statusAgain = system.recordMatch(alice, PlayerId{7}, MatchResult::Draw);
+    assert(statusAgain == MatchStatus::UnknownPlayer);
+    [[maybe_unused]] const auto status3 = system.recordMatch(alice, alice, MatchResult::Player1Wins);
+    assert(status3 == MatchStatus::SamePlayer);
+
+    /**
+     * A K-factor must be positive and finite
+     */
+    const PlayerId bob = system.addPlayer("Bob", 1300.0).value();
+    for (const double kFactor : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                                 -std::numeric_limits<double>::infinity(), -16.0, 0.0})
+    {
+        [[maybe_unused]] const MatchStatus status = system.recordMatch(alice, bob, MatchResult::Player1Wins, kFactor);
+        assert(status == MatchStatus::InvalidKFactor);
+    }
+    assert(system.getPlayer(alice).getRating() == 1200.0);
+    assert(system.getPlayer(bob).getRating() == 1300.0);
+    assert(system.getChangeSequence() == 2);
+
+    assert(system.getPlayer(alice).getGamesPlayed() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 16: Record Match Batch
+ *
+ * Verify that a batch gives the same ratings as recording
+ * the matches one at a time, and reports a status per match
+ */
+void testRecordMatchBatch()
+{
+    std::cout << "Test 16: Record match batch..." << std::endl;
+
+    RankingSystem single;
+    const PlayerId a1 = single.addPlayer("Alice").value();
+    const PlayerId b1 = single.addPlayer("Bob").value();
+    const PlayerId c1 = single.addPlayer("Charlie").value();
+    single.recordMatch(a1, b1, MatchResult::Player1Wins);
+    single.recordMatch(b1, c1, MatchResult::Draw, 16.0);
+    single.recordMatch(c1, a1, MatchResult::Player1Wins);
+
+    RankingSystem batched;
+    const PlayerId alice = batched.addPlayer("Alice").value();
+    const PlayerId bob = batched.addPlayer("Bob").value();
+    const PlayerId charlie = batched.addPlayer("Charlie").value();
+
+    const std::vector<MatchRecord> batch = {
+        {alice, bob, MatchResult::Player1Wins},
+        {bob, charlie, MatchResult::Draw, 16.0f},
+        {alice, PlayerId{99}, MatchResult::Draw},
+        {bob, bob, MatchResult::Player1Wins},
+        {alice, bob, static_cast<MatchResult>(5)},
+        {alice, bob, MatchResult::Player1Wins, std::numeric_limits<float>::infinity()},
+        {alice, bob, MatchResult::Player1Wins, std::numeric_limits<float>::quiet_NaN()},
+        {alice, bob, MatchResult::Player1Wins, -8.0f},
+        {charlie, alice, MatchResult::Player1Wins}
+    };
+
+    const std::vector<MatchStatus> statuses = batched.recordMatches(batch);
+
+    assert(statuses.size() == batch.size());
+    assert(statuses[0] == MatchStatus::Recorded);
+    assert(statuses[1] == MatchStatus::Recorded);
+    assert(statuses[2] == MatchStatus::UnknownPlayer);
+    assert(statuses[3] == MatchStatus::SamePlayer);
+    assert(statuses[4] == MatchStatus::InvalidResult);
+    assert(statuses[5] == MatchStatus::InvalidKFactor);
+    assert(statuses[6] == MatchStatus::InvalidKFactor);
+    assert(statuses[7] == MatchStatus::InvalidKFactor);
+    assert(statuses[8] == MatchStatus::Recorded);
+
+    /**
+     * Rejected records must not change anything
+     */
+    for (PlayerId id = 0; id < 3; id++)
+    {
+        assert(batched.getPlayer(id).getRating() == single.getPlayer(id).getRating());
+        assert(batched.getPlayer(id).getGamesPlayed() == single.getPlayer(id).getGamesPlayed());
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 17: Status Results
+ *
+ * Verify that operations report success and failure through their return values
+ */
+void testStatusResults()
+{
+    std::cout << "Test 17: Status results..." << std::endl;
+
+    RankingSystem system;
+
+    const auto alice = system.addPlayer("Alice");
+    const auto duplicate = system.addPlayer("Alice");
+    system.addPlayer("Bob");
+
+    assert(alice.has_value());
+    assert(*alice == 0);
+    assert(!duplicate.has_value());
+    assert(duplicate.error() == RankingError::DuplicatePlayer);
+
+    [[maybe_unused]] const auto status = system.recordMatch("Alice", "Bob", 1);
+    assert(status == MatchStatus::Recorded);
+    [[maybe_unused]] const auto statusAgain = system.recordMatch("Alice", "Nobody", 1);
+    assert(statusAgain == MatchStatus::UnknownPlayer);
+    [[maybe_unused]] const auto status3 = system.recordMatch("Alice", "Alice", 1);
+    assert(status3 == MatchStatus::SamePlayer);
+
+    const std::string testFile = "test_status.csv";
+    [[maybe_unused]] const auto saved = system.saveToFile(testFile);
+    assert(saved.has_value());
+
+    RankingSystem loaded;
+    const auto count = loaded.loadFromFile(testFile);
+    assert(count.has_value());
+    assert(*count == 2);
+    std::remove(testFile.c_str());
+
+    const auto missing = loaded.loadFromFile("nonexistent_file.csv");
+    assert(!missing.has_value());
+    assert(missing.error() == RankingError::FileOpenFailed);
+    assert(loaded.getPlayerCount() == 2);
+
+    [[maybe_unused]] const auto savedAgain = system.saveToFile("no_such_directory/players.csv");
+    assert(savedAgain.error() == RankingError::FileOpenFailed);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 18: No Console Output
+ *
+ * Verify that the core operations print nothing
+ * std::cout is pointed at a string buffer while they run
+ */
+void testNoConsoleOutput()
+{
+    std::cout << "Test 18: No console output..." << std::endl;
+
+    std::ostringstream captured;
+    std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+
+    {
+        RankingSystem system;
+        const auto alice = system.addPlayer("Alice");
+        const auto bob = system.addPlayer("Bob");
+        system.addPlayer("Alice");
+        system.recordMatch("Alice", "Bob", 1);
+        system.recordMatch("Alice", "Nobody", 1);
+        system.recordMatch(*alice, *bob, MatchResult::Draw);
+
+        const std::string testFile = "test_quiet.csv";
+        system.saveToFile(testFile);
+        system.loadFromFile(testFile);
+        system.loadFromFile("nonexistent_file.csv");
+        std::remove(testFile.c_str());
+    }
+
+    std::cout.rdbuf(original);
+
+    assert(captured.str().empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 19: Expected Score Mode
+ *
+ * Verify that a system using the lookup table gives
+ * (almost) the same ratings as one using the exact formula
+ */
+void testExpectedScoreMode()
+{
+    std::cout << "Test 19: Expected score mode..." << std::endl;
+
+    RankingSystem exact;
+    RankingSystem table;
+    table.setExpectedScoreMode(ExpectedScoreMode::LookupTable);
+
+    assert(exact.getExpectedScoreMode() == ExpectedScoreMode::Exact);
+    assert(table.getExpectedScoreMode() == ExpectedScoreMode::LookupTable);
+
+    for (RankingSystem* system : {&exact, &table})
+    {
+        system->addPlayer("Alice", 1450.0);
+        system->addPlayer("Bob", 1210.0);
+        system->addPlayer("Charlie", 1333.0);
+        system->recordMatch("Alice", "Bob", -1);
+        system->recordMatch("Bob", "Charlie", 0);
+        system->recordMatch("Charlie", "Alice", 1);
+    }
+
+    for (PlayerId id = 0; id < 3; id++)
+    {
+        assert(std::abs(exact.getPlayer(id).getRating() - table.getPlayer(id).getRating()) < 1e-3);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 20: Rank and Neighborhood
+ *
+ * Verify ranks follow the leaderboard and move after a match,
+ * and that the neighborhood window is cut off at both ends
+ */
+void testRankAndNeighborhood()
+{
+    std::cout << "Test 20: Rank and neighborhood..." << std::endl;
+
+    RankingSystem system;
+    const PlayerId alice = *system.addPlayer("Alice", 1500.0);
+    [[maybe_unused]] const PlayerId bob = *system.addPlayer("Bob", 1400.0);
+    [[maybe_unused]] const PlayerId charlie = *system.addPlayer("Charlie", 1300.0);
+    [[maybe_unused]] const PlayerId diana = *system.addPlayer("Diana", 1200.0);
+    const PlayerId eve = *system.addPlayer("Eve", 1100.0);
+
+    assert(*system.rankOf(alice) == 1);
+    assert(*system.rankOf(charlie) == 3);
+    assert(*system.rankOf(eve) == 5);
+
+    assert((*system.neighborhood(charlie, 1) == std::vector<PlayerId>{bob, charlie, diana}));
+    assert((*system.neighborhood(alice, 2) == std::vector<PlayerId>{alice, bob, charlie}));
+    assert((*system.neighborhood(eve, 1) == std::vector<PlayerId>{diana, eve}));
+    assert((*system.neighborhood(bob, 0) == std::vector<PlayerId>{bob}));
+    assert(system.neighborhood(charlie, std::numeric_limits<size_t>::max())->size() == 5);
+
+    /**
+     * Eve beats Alice with K = 400: Eve jumps to the top
+     */
+    system.recordMatch(eve, alice, MatchResult::Player1Wins, 400.0);
+    assert(*system.rankOf(eve) == 1);
+    assert(*system.rankOf(alice) == 5);
+
+    assert(system.rankOf(99).error() == RankingError::UnknownPlayer);
+    assert(system.neighborhood(99, 3).error() == RankingError::UnknownPlayer);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 21: Leaderboard Pages
+ *
+ * Verify structured rows, page text, and that a cached page
+ * is rendered again only when its rows change
+ */
+void testLeaderboardPages()
+{
+    std::cout << "Test 21: Leaderboard pages..." << std::endl;
+
+    RankingSystem system;
+    for (int i = 0; i < 10; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1000.0 + 10.0 * i);
+    }
+
+    /**
+     * Rows: Player9 is on top, ranks count from 1
+     */
+    const std::vector<LeaderboardRow> rows = system.getLeaderboardPage(3, 4);
+    assert(rows.size() == 4);
+    assert(rows[0].rank == 4);
+    assert(rows[0].name == "Player6");
+    assert(rows[3].name == "Player3");
+    assert(rows[3].rating == 1030.0);
+    assert(system.getLeaderboardPage(8, 5).size() == 2);
+    assert(system.getLeaderboardPage(10, 5).empty());
+
+    /**
+     * Page text holds the header and the page's rows only
+     */
+    const std::string page1 = system.getLeaderboardPageText(1, 3);
+    assert(page1.find("Name") != std::string::npos);
+    assert(page1.find("Player9") != std::string::npos);
+    assert(page1.find("Player7") != std::string::npos);
+    assert(page1.find("Player6") == std::string::npos);
+    assert(system.getLeaderboardPageText(5, 3).empty());
+
+    /**
+     * A page bigger than the leaderboard holds all of it
+     */
+    [[maybe_unused]] const size_t hugePage = std::numeric_limits<size_t>::max();
+    assert(system.getLeaderboardPageText(1, hugePage).find("Player0") != std::string::npos);
+    assert(system.getLeaderboardPageText(2, hugePage).empty());
+
+    /**
+     * Asking again returns the stored string
+     */
+    [[maybe_unused]] const std::string* cached = &system.getLeaderboardPageText(1, 3);
+    assert(&system.getLeaderboardPageText(1, 3) == cached);
+
+    /**
+     * A match at the bottom (positions 8 and 9) leaves page 1 alone
+     */
+    system.recordMatch("Player1", "Player0", 0);
+    assert(system.getLeaderboardPageText(1, 3) == page1);
+
+    /**
+     * A match that lifts Player0 to the top changes page 1
+     */
+    system.recordMatch(PlayerId{0}, PlayerId{9}, MatchResult::Player1Wins, 400.0);
+    [[maybe_unused]] const std::string& changed = system.getLeaderboardPageText(1, 3);
+    assert(changed != page1);
+    assert(changed.find("Player0") != std::string::npos);
+
+    std::ostringstream expected;
+    system.displayLeaderboard(expected);
+    assert(expected.str().find(changed.substr(changed.find("Player0"), 80)) != std::string::npos);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 22: Top K
+ *
+ * Verify the best k players are returned in order,
+ * and that the games filter skips players but keeps their ranks
+ */
+void testTopK()
+{
+    std::cout << "Test 22: Top K..." << std::endl;
+
+    RankingSystem system;
+    system.addPlayer("Alice", 1600.0);
+    system.addPlayer("Bob", 1500.0);
+    system.addPlayer("Charlie", 1400.0);
+    system.addPlayer("Diana", 1300.0);
+    system.addPlayer("Eve", 1000.0);
+
+    const std::vector<LeaderboardRow> top = system.topK(3);
+    assert(top.size() == 3);
+    assert(top[0].name == "Alice");
+    assert(top[1].name == "Bob");
+    assert(top[2].name == "Charlie");
+    assert(top[2].rank == 3);
+
+    assert(system.topK(10).size() == 5);
+    assert(system.topK(0).empty());
+
+    /**
+     * Only Charlie and Eve have played; Eve stays last
+     */
+    system.recordMatch("Charlie", "Eve", 0);
+
+    const std::vector<LeaderboardRow> played = system.topK(5, 1);
+    assert(played.size() == 2);
+    assert(played[0].name == "Charlie");
+    assert(played[0].rank == 3);
+    assert(played[1].name == "Eve");
+    assert(played[1].rank == 5);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 23: Restore Players
+ *
+ * Verify restorePlayer stores the counters directly, rejects bad ones
+ * and ratings that are not finite, and that loading skips such rows
+ */
+void testRestorePlayers()
+{
+    std::cout << "Test 23: Restore players..." << std::endl;
+
+    RankingSystem system;
+
+    const std::expected<PlayerId, RankingError> veteran =
+        system.restorePlayer("Veteran", 1900.0, PlayerStats{50000, 25000, 20000, 5000});
+    assert(veteran.has_value());
+    assert(system.getPlayer(*veteran).getGamesPlayed() == 50000);
+    assert(system.getPlayer(*veteran).getDraws() == 5000);
+    assert(*system.rankOf(*veteran) == 1);
+
+    [[maybe_unused]] const auto restored = system.restorePlayer("Veteran", 1500.0, PlayerStats{});
+    assert(restored.error() == RankingError::DuplicatePlayer);
+    [[maybe_unused]] const auto broken = system.restorePlayer("Broken", 1500.0, PlayerStats{3, 1, 1, 0});
+    assert(broken.error() == RankingError::InconsistentStats);
+    [[maybe_unused]] const auto unrated = system.restorePlayer("Unrated", std::numeric_limits<double>::quiet_NaN(), PlayerStats{});
+    assert(unrated.error() == RankingError::InvalidRating);
+    [[maybe_unused]] const auto infinite = system.addPlayer("Infinite", std::numeric_limits<double>::infinity());
+    assert(infinite.error() == RankingError::InvalidRating);
+    assert(system.getPlayerCount() == 1);
+
+    const char* path = "test_restore_players.csv";
+    {
+        std::ofstream file(path);
+        file << "Alice,1245.5,15,10,3,2\n";
+        file << "Bob,1210,99,7,4,1\n";
+        file << "Charlie,1188,0,0,0,0\n";
+        file << "Dana,nan,0,0,0,0\n";
+        file << "Eve,-inf,0,0,0,0\n";
+    }
+
+    [[maybe_unused]] const auto loaded = system.loadFromFile(path);
+    assert(*loaded == 2);
+    assert(system.findPlayer("Alice")->getGamesPlayed() == 15);
+    assert(system.findPlayer("Bob") == nullptr);
+    assert(system.findPlayer("Charlie") != nullptr);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 24: Parallel Load
+ *
+ * Verify that loading with several threads gives exactly the same
+ * players, ids and leaderboard as loading with one,
+ * including which of two duplicate rows is kept
+ */
+void testParallelLoad()
+{
+    std::cout << "Test 24: Parallel load..." << std::endl;
+
+    const char* path = "test_parallel_load.csv";
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 2000; i++)
+        {
+            file << "Player" << i << "," << 1000 + (i * 37) % 900 << ",2,1,1,0\n";
+        }
+        file << "Player5,1999,0,0,0,0\n";
+        file << "Player1999,1,0,0,0,0\n";
+    }
+
+    RankingSystem sequential;
+    [[maybe_unused]] const auto sequentialLoaded = sequential.loadFromFile(path);
+    assert(*sequentialLoaded == 2000);
+
+    for (unsigned threads : {2u, 3u, 8u, 0u})
+    {
+        RankingSystem parallel;
+        [[maybe_unused]] const auto parallelLoaded = parallel.loadFromFile(path, threads);
+        assert(*parallelLoaded == 2000);
+
+        assert(parallel.getAllPlayerNames() == sequential.getAllPlayerNames());
+        assert(parallel.findPlayer("Player5")->getRating() == sequential.findPlayer("Player5")->getRating());
+        assert(parallel.findPlayerId("Player1999") == 1999);
+
+        const std::vector<LeaderboardRow> a = parallel.topK(50);
+        const std::vector<LeaderboardRow> b = sequential.topK(50);
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            assert(a[i].id == b[i].id);
+        }
+    }
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 25: Save and Load Round Trip
+ *
+ * Verify that saving and loading again gives back every rating
+ * exactly, not rounded to a few digits, along with all counters
+ */
+void testSaveLoadRoundTrip()
+{
+    std::cout << "Test 25: Save and load round trip..." << std::endl;
+
+    RankingSystem system;
+    system.addPlayer("Alice", 1234.5678901234);
+    system.addPlayer("Bob", 0.1 + 0.2);
+    system.addPlayer("Charlie", 1500.0);
+    system.restorePlayer("Diana", 2012.0625, PlayerStats{9, 4, 3, 2});
+
+    for (int i = 0; i < 30; i++)
+    {
+        system.recordMatch(i % 4, (i + 1) % 4, static_cast<MatchResult>(i % 3 - 1));
+    }
+
+    const char* path = "test_round_trip.csv";
+    [[maybe_unused]] const auto saved = system.saveToFile(path);
+    assert(saved.has_value());
+
+    RankingSystem loaded;
+    [[maybe_unused]] const auto loadCount = loaded.loadFromFile(path);
+    assert(*loadCount == system.getPlayerCount());
+
+    for (const std::string& name : system.getAllPlayerNames())
+    {
+        [[maybe_unused]] const Player* before = system.findPlayer(name);
+        [[maybe_unused]] const Player* after = loaded.findPlayer(name);
+        assert(after != nullptr);
+        assert(after->getRating() == before->getRating());
+        assert(after->getRatingValue() == before->getRatingValue());
+        assert(after->getGamesPlayed() == before->getGamesPlayed());
+        assert(after->getWins() == before->getWins());
+        assert(after->getLosses() == before->getLosses());
+        assert(after->getDraws() == before->getDraws());
+    }
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 26: Safe Saves
+ *
+ * Verify that a save with a checksum loads back, that a damaged or
+ * cut-off file is refused without touching the current players, and
+ * that a failed save leaves the previous file in place
+ */
+void testSafeSave()
+{
+    std::cout << "Test 26: Safe saves..." << std::endl;
+
+    RankingSystem system;
+    system.addPlayer("Alice", 1245.5);
+    system.addPlayer("Bob", 1210.25);
+
+    const char* path = "test_safe_save.csv";
+    [[maybe_unused]] const auto saved = system.saveToFile(path, FileChecksum::Crc32Footer);
+    assert(saved.has_value());
+
+    RankingSystem loaded;
+    [[maybe_unused]] const auto loadCount = loaded.loadFromFile(path);
+    assert(*loadCount == 2);
+    assert(loaded.findPlayer("Bob")->getRating() == 1210.25);
+
+    std::string contents;
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::getline(file, contents, '\0');
+    }
+    contents[contents.find("1210")] = '9';
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    RankingSystem other;
+    other.addPlayer("Zed", 1000.0);
+    [[maybe_unused]] const auto otherLoaded = other.loadFromFile(path);
+    assert(otherLoaded.error() == RankingError::ChecksumMismatch);
+    assert(other.getPlayerCount() == 1);
+    assert(other.findPlayer("Zed") != nullptr);
+
+    /**
+     * Cut off after the first player, checksum line and all
+     */
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << contents.substr(0, contents.find('\n', contents.find("Alice")) + 1);
+    }
+    [[maybe_unused]] const auto otherLoadedAgain = other.loadFromFile(path);
+    assert(otherLoadedAgain.error() == RankingError::ChecksumMismatch);
+    assert(other.getPlayerCount() == 1);
+
+    /**
+     * Names starting with '#' are kept for the file's own lines
+     */
+    [[maybe_unused]] const auto added = system.addPlayer("#crc32");
+    assert(added.error() == RankingError::InvalidName);
+    [[maybe_unused]] const auto restored = system.restorePlayer("#sequence", 1200.0, PlayerStats{});
+    assert(restored.error() == RankingError::InvalidName);
+    [[maybe_unused]] const auto addedAgain = system.addPlayer("Not#first");
+    assert(addedAgain.has_value());
+
+    [[maybe_unused]] const auto savedAgain = system.saveToFile(path);
+    assert(savedAgain.has_value());
+    [[maybe_unused]] const auto otherLoaded3 = other.loadFromFile(path);
+    assert(*otherLoaded3 == 3);
+
+    [[maybe_unused]] const auto unsaved = system.saveToFile("no_such_directory/players.csv", FileChecksum::Crc32Footer);
+    assert(unsaved.error() == RankingError::FileOpenFailed);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 27: Binary Snapshot
+ *
+ * Verify that a snapshot brings back the same players, ratings,
+ * counters and leaderboard, and that a bad snapshot is refused
+ * without touching the current players
+ */
+void testSnapshot()
+{
+    std::cout << "Test 27: Binary snapshot..." << std::endl;
+
+    RankingSystem system;
+    for (int i = 0; i < 200; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1000.0 + (i * 53) % 700 + 0.1 * i);
+    }
+    for (int i = 0; i < 300; i++)
+    {
+        system.recordMatch(i % 200, (i * 7 + 3) % 200, static_cast<MatchResult>(i % 3 - 1));
+    }
+
+    const char* path = "test_snapshot.bin";
+    [[maybe_unused]] const auto saved = system.saveSnapshot(path, FileChecksum::Crc32Footer);
+    assert(saved.has_value());
+
+    RankingSystem loaded;
+    loaded.addPlayer("Someone", 1500.0);
+    [[maybe_unused]] const auto loadCount = loaded.loadSnapshot(path);
+    assert(*loadCount == 200);
+
+    assert(loaded.getAllPlayerNames() == system.getAllPlayerNames());
+    for (PlayerId id = 0; id < 200; id++)
+    {
+        assert(loaded.getPlayer(id).getRatingValue() == system.getPlayer(id).getRatingValue());
+        assert(loaded.getPlayer(id).getGamesPlayed() == system.getPlayer(id).getGamesPlayed());
+        assert(*loaded.rankOf(id) == *system.rankOf(id));
+    }
+    assert(loaded.findPlayer("Someone") == nullptr);
+    assert(loaded.findPlayerId("Player150") == 150);
+
+    loaded.recordMatch(0, 1, MatchResult::Draw);
+    system.recordMatch(0, 1, MatchResult::Draw);
+    assert(*loaded.rankOf(0) == *system.rankOf(0));
+
+    [[maybe_unused]] const auto loadCountAgain = loaded.loadSnapshot("no_such_file.bin");
+    assert(loadCountAgain.error() == RankingError::FileOpenFailed);
+
+    [[maybe_unused]] const auto savedAgain = system.saveToFile(path);
+    assert(savedAgain.has_value());
+    [[maybe_unused]] const auto loadCount3 = loaded.loadSnapshot(path);
+    assert(loadCount3.error() == RankingError::InvalidSnapshot);
+    assert(loaded.getPlayerCount() == 200);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 28: Match Log Recovery
+ *
+ * Verify that players and matches since the last save come back
+ * from the match log, with the exact same ratings, and that a log
+ * written on top of other players is refused
+ */
+void testMatchLog()
+{
+    std::cout << "Test 28: Match log recovery..." << std::endl;
+
+    const char* savePath = "test_match_log_players.csv";
+    const char* logPath = "test_match_log.wal";
+    std::remove(logPath);
+
+    RankingSystem system;
+    for (int i = 0; i < 20; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1100.0 + 10 * i);
+    }
+    [[maybe_unused]] const auto saved = system.saveToFile(savePath);
+    assert(saved.has_value());
+    [[maybe_unused]] const auto opened = system.openMatchLog(logPath);
+    assert(*opened == 0);
+
+    system.setExpectedScoreMode(ExpectedScoreMode::LookupTable);
+    for (int i = 0; i < 100; i++)
+    {
+        system.recordMatch(i % 20, (i * 3 + 1) % 20, static_cast<MatchResult>(i % 3 - 1), 10.0 + i % 7);
+    }
+    system.addPlayer("Latecomer", 1234.5);
+    system.recordMatch(20, 3, MatchResult::Player1Wins);
+    [[maybe_unused]] const auto closed = system.closeMatchLog();
+    assert(closed.has_value());
+
+    /**
+     * A new system loads the old save and replays the log on top
+     */
+    RankingSystem recovered;
+    [[maybe_unused]] const auto recoveredLoaded = recovered.loadFromFile(savePath);
+    assert(*recoveredLoaded == 20);
+    [[maybe_unused]] const auto recoveredOpened = recovered.openMatchLog(logPath);
+    assert(*recoveredOpened == 102);
+
+    assert(recovered.getPlayerCount() == 21);
+    for (PlayerId id = 0; id < 21; id++)
+    {
+        assert(recovered.getPlayer(id).getRatingValue() == system.getPlayer(id).getRatingValue());
+        assert(recovered.getPlayer(id).getWins() == system.getPlayer(id).getWins());
+        assert(*recovered.rankOf(id) == *system.rankOf(id));
+    }
+
+    /**
+     * New matches go to the end of the same log; after a save
+     * and clearMatchLog there is nothing left to replay
+     */
+    recovered.recordMatch(0, 1, MatchResult::Draw);
+    [[maybe_unused]] const auto recoveredSaved = recovered.saveToFile(savePath);
+    assert(recoveredSaved.has_value());
+    [[maybe_unused]] const auto recoveredCleared = recovered.clearMatchLog();
+    assert(recoveredCleared.has_value());
+    [[maybe_unused]] const auto recoveredClosed = recovered.closeMatchLog();
+    assert(recoveredClosed.has_value());
+
+    RankingSystem restarted;
+    restarted.loadFromFile(savePath);
+    [[maybe_unused]] const auto restartedOpened = restarted.openMatchLog(logPath);
+    assert(*restartedOpened == 0);
+    restarted.recordMatch(0, 1, MatchResult::Player2Wins);
+    [[maybe_unused]] const auto restartedClosed = restarted.closeMatchLog();
+    assert(restartedClosed.has_value());
+
+    /**
+     * The log now holds a match between players 0 and 1;
+     * with only one player loaded it does not fit
+     */
+    RankingSystem other;
+    other.addPlayer("Alone");
+    [[maybe_unused]] const auto otherOpened = other.openMatchLog(logPath);
+    assert(otherOpened.error() == RankingError::InvalidMatchLog);
+    assert(other.getPlayerCount() == 1);
+    assert(other.getPlayer(0).getGamesPlayed() == 0);
+
+    std::remove(savePath);
+    std::remove(logPath);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 29: Background Save
+ *
+ * Verify that a background save writes the players as they were when
+ * it was started, and that the next one picks up every change since
+ * (changed players, new players, and a load in between)
+ */
+void testSaveToFileAsync()
+{
+    std::cout << "Test 29: Background save..." << std::endl;
+
+    const char* path = "test_async_save.csv";
+
+    RankingSystem system;
+    for (int i = 0; i < 30; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1000.0 + 7 * i);
+    }
+    system.recordMatch(0, 1, MatchResult::Player1Wins);
+
+    const auto first = system.saveToFileAsync(path, FileChecksum::Crc32Footer);
+
+    /**
+     * Matches recorded meanwhile are not in this save
+     */
+    [[maybe_unused]] const double savedRating = system.getPlayer(2).getRating();
+    system.recordMatch(2, 3, MatchResult::Player2Wins);
+    [[maybe_unused]] const auto firstSaved = first.get();
+    assert(firstSaved.has_value());
+
+    RankingSystem loaded;
+    [[maybe_unused]] const auto loadCount = loaded.loadFromFile(path);
+    assert(*loadCount == 30);
+    assert(loaded.getPlayer(0).getWins() == 1);
+    assert(loaded.getPlayer(2).getRating() == savedRating);
+    assert(loaded.getPlayer(2).getGamesPlayed() == 0);
+
+    /**
+     * The next save has the match above, more matches and a new player
+     */
+    for (int i = 0; i < 40; i++)
+    {
+        system.recordMatch(i % 30, (i * 7 + 1) % 30, static_cast<MatchResult>(i % 3 - 1));
+    }
+    system.addPlayer("Latecomer", 1333.0);
+    system.recordMatch(30, 4, MatchResult::Draw);
+
+    [[maybe_unused]] const auto saved = system.saveToFileAsync(path).get();
+    assert(saved.has_value());
+    [[maybe_unused]] const auto loadCountAgain = loaded.loadFromFile(path);
+    assert(*loadCountAgain == 31);
+    for (PlayerId id = 0; id < 31; id++)
+    {
+        assert(loaded.getPlayer(id).getName() == system.getPlayer(id).getName());
+        assert(loaded.getPlayer(id).getRating() == system.getPlayer(id).getRating());
+        assert(loaded.getPlayer(id).getGamesPlayed() == system.getPlayer(id).getGamesPlayed());
+        assert(loaded.getPlayer(id).getDraws() == system.getPlayer(id).getDraws());
+    }
+
+    /**
+     * After a load the copy starts over from the new players
+     */
+    system.addPlayer("Gone");
+    [[maybe_unused]] const auto loadedAgain = system.loadFromFile(path);
+    assert(*loadedAgain == 31);
+    system.recordMatch(5, 6, MatchResult::Player1Wins);
+    [[maybe_unused]] const auto savedAgain = system.saveToFileAsync(path).get();
+    assert(savedAgain.has_value());
+    [[maybe_unused]] const auto loadCount3 = loaded.loadFromFile(path);
+    assert(*loadCount3 == 31);
+    assert(loaded.findPlayer("Gone") == nullptr);
+    assert(loaded.getPlayer(5).getWins() == system.getPlayer(5).getWins());
+
+    /**
+     * A save right after a background save waits for it,
+     * so the file ends up with the newer players
+     */
+    for (int i = 0; i < 20000; i++)
+    {
+        system.addPlayer("Extra" + std::to_string(i));
+    }
+    const auto background = system.saveToFileAsync(path, FileChecksum::Crc32Footer);
+    system.addPlayer("Newest");
+    [[maybe_unused]] const auto saved3 = system.saveToFile(path, FileChecksum::Crc32Footer);
+    assert(saved3.has_value());
+    [[maybe_unused]] const auto backgroundSaved = background.get();
+    assert(backgroundSaved.has_value());
+    [[maybe_unused]] const auto loadCount4 = loaded.loadFromFile(path);
+    assert(*loadCount4 == system.getPlayerCount());
+    assert(loaded.findPlayer("Newest") != nullptr);
+
+    [[maybe_unused]] const auto unsaved = system.saveToFileAsync("no_such_directory/players.csv").get();
+    assert(unsaved.error() == RankingError::FileOpenFailed);
+
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 30: Deltas
+ *
+ * Verify that a snapshot followed by its deltas brings back the same
+ * players, that a delta holds only the players that changed, and that
+ * a delta which does not continue the loaded players is refused
+ */
+void testDeltas()
+{
+    std::cout << "Test 30: Deltas..." << std::endl;
+
+    const char* snapshotPath = "test_deltas.bin";
+    const char* firstPath = "test_deltas_1.bin";
+    const char* secondPath = "test_deltas_2.bin";
+    const char* csvPath = "test_deltas.csv";
+
+    RankingSystem system;
+    for (int i = 0; i < 50; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1000.0 + 11 * i);
+    }
+    [[maybe_unused]] const auto written = system.saveDelta(firstPath);
+    assert(written.error() == RankingError::NoSnapshot);
+    assert(system.getDeltaSize() == 0);
+
+    [[maybe_unused]] const auto saved = system.saveSnapshot(snapshotPath);
+    assert(saved.has_value());
+
+    /**
+     * Players 0-5 play; one player is added
+     */
+    for (int i = 0; i < 10; i++)
+    {
+        system.recordMatch(i % 6, (i + 1) % 6, static_cast<MatchResult>(i % 3 - 1));
+    }
+    system.addPlayer("Latecomer", 1234.5);
+    assert(system.getDeltaSize() == 7);
+    [[maybe_unused]] const auto writtenAgain = system.saveDelta(firstPath, FileChecksum::Crc32Footer);
+    assert(*writtenAgain == 7);
+    assert(system.getDeltaSize() == 0);
+
+    system.recordMatch(50, 20, MatchResult::Player1Wins);
+    system.recordMatch(3, 20, MatchResult::Draw);
+    [[maybe_unused]] const auto written3 = system.saveDelta(secondPath);
+    assert(*written3 == 3);
+
+    /**
+     * Deltas only apply in order, on top of the snapshot
+     */
+    RankingSystem loaded;
+    [[maybe_unused]] const auto loadCount = loaded.loadSnapshot(snapshotPath);
+    assert(*loadCount == 50);
+    [[maybe_unused]] const auto loadedApplied = loaded.loadDelta(secondPath);
+    assert(loadedApplied.error() == RankingError::InvalidSnapshot);
+    [[maybe_unused]] const auto loadedAppliedAgain = loaded.loadDelta(firstPath);
+    assert(*loadedAppliedAgain == 7);
+    [[maybe_unused]] const auto loadedApplied3 = loaded.loadDelta(firstPath);
+    assert(loadedApplied3.error() == RankingError::InvalidSnapshot);
+    [[maybe_unused]] const auto loadedApplied4 = loaded.loadDelta(secondPath);
+    assert(*loadedApplied4 == 3);
+
+    assert(loaded.getPlayerCount() == 51);
+    assert(loaded.getChangeSequence() == system.getChangeSequence());
+    for (PlayerId id = 0; id < 51; id++)
+    {
+        assert(loaded.getPlayer(id).getName() == system.getPlayer(id).getName());
+        assert(loaded.getPlayer(id).getRatingValue() == system.getPlayer(id).getRatingValue());
+        assert(loaded.getPlayer(id).getGamesPlayed() == system.getPlayer(id).getGamesPlayed());
+        assert(loaded.getPlayer(id).getDraws() == system.getPlayer(id).getDraws());
+        assert(*loaded.rankOf(id) == *system.rankOf(id));
+    }
+    assert(loaded.findPlayer("Latecomer") != nullptr);
+
+    /**
+     * The loaded system keeps writing deltas where the files left off
+     */
+    loaded.recordMatch(10, 11, MatchResult::Player2Wins);
+    [[maybe_unused]] const auto loadedWritten = loaded.saveDelta(firstPath);
+    assert(*loadedWritten == 2);
+
+    /**
+     * A delta is not a snapshot; players loaded from a CSV file saved
+     * at the delta's base sequence take it, once
+     */
+    RankingSystem other;
+    [[maybe_unused]] const auto otherLoaded = other.loadSnapshot(firstPath);
+    assert(otherLoaded.error() == RankingError::InvalidSnapshot);
+    [[maybe_unused]] const auto savedAgain = system.saveToFile(csvPath);
+    assert(savedAgain.has_value());
+    [[maybe_unused]] const auto otherLoadedAgain = other.loadFromFile(csvPath);
+    assert(*otherLoadedAgain == 51);
+    [[maybe_unused]] const auto otherWritten = other.saveDelta(secondPath);
+    assert(otherWritten.error() == RankingError::NoSnapshot);
+    [[maybe_unused]] const auto otherApplied = other.loadDelta(firstPath);
+    assert(*otherApplied == 2);
+    assert(other.getPlayer(11).getRatingValue() == loaded.getPlayer(11).getRatingValue());
+    [[maybe_unused]] const auto otherAppliedAgain = other.loadDelta(firstPath);
+    assert(otherAppliedAgain.error() == RankingError::InvalidSnapshot);
+
+    /**
+     * A new player in a delta follows the same rules as addPlayer:
+     * a delta adding "#ed" is refused and changes nothing
+     */
+    RankingSystem base;
+    base.addPlayer("Alice");
+    base.addPlayer("Bob");
+    const auto baseSaved = base.saveSnapshot(snapshotPath);
+    assert(baseSaved.has_value());
+    base.addPlayer("Zed");
+    base.recordMatch(0, 1, MatchResult::Player1Wins);
+    const auto zedSaved = base.saveDelta(firstPath);
+    assert(zedSaved.has_value());
+
+    std::string bytes;
+    {
+        std::ifstream file(firstPath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    bytes[bytes.find("Zed")] = '#';
+    {
+        std::ofstream file(firstPath, std::ios::binary);
+        file << bytes;
+    }
+
+    RankingSystem reserved;
+    const auto reservedLoaded = reserved.loadSnapshot(snapshotPath);
+    assert(reservedLoaded.has_value());
+    [[maybe_unused]] const double aliceBefore = reserved.getPlayer(0).getRating();
+    const auto reservedDelta = reserved.loadDelta(firstPath);
+    assert(reservedDelta.error() == RankingError::InvalidSnapshot);
+    assert(reserved.getPlayerCount() == 2);
+    assert(reserved.getPlayer(0).getRating() == aliceBefore);
+    assert(reserved.getLeaderboardPage(0, 10).size() == 2);
+
+    std::remove(snapshotPath);
+    std::remove(firstPath);
+    std::remove(secondPath);
+    std::remove(csvPath);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 31: Match History
+ *
+ * Verify that with the history enabled every recorded match is kept
+ * with the ratings before it and the changes, that rejected matches
+ * are not, and that loading other players clears it
+ */
+void testMatchHistory()
+{
+    std::cout << "Test 31: Match history..." << std::endl;
+
+    RankingSystem system;
+    assert(system.getMatchHistory() == nullptr);
+
+    const PlayerId alice = *system.addPlayer("Alice", 1200.0);
+    const PlayerId bob = *system.addPlayer("Bob", 1300.0);
+    system.recordMatch(alice, bob, MatchResult::Player1Wins);
+
+    system.enableMatchHistory();
+    assert(system.getMatchHistory()->size() == 0);
+
+    [[maybe_unused]] const std::int64_t before = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::vector<double> ratingsBefore;
+    for (int i = 0; i < 10; i++)
+    {
+        ratingsBefore.push_back(system.getPlayer(alice).getRating());
+        system.recordMatch(alice, bob, static_cast<MatchResult>(i % 3 - 1));
+    }
+    [[maybe_unused]] const auto status = system.recordMatch(alice, alice, MatchResult::Draw);
+    assert(status == MatchStatus::SamePlayer);
+
+    [[maybe_unused]] const std::int64_t after = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    /**
+     * Calling it again keeps what was collected
+     */
+    system.enableMatchHistory();
+    assert(system.getMatchHistory()->size() == 10);
+
+    size_t seen = 0;
+    double rating = 0.0;
+    system.getMatchHistory()->forEach([&](const MatchHistoryEntry& match)
+    {
+        assert(match.player1 == alice && match.player2 == bob);
+        assert(match.result == static_cast<MatchResult>(static_cast<int>(seen % 3) - 1));
+        assert(match.timestamp >= before && match.timestamp <= after);
+        assert(std::abs(match.rating1 - ratingsBefore[seen]) < 0.001);
+        assert(std::abs(match.change1 + match.change2) < 0.002);
+        rating = match.rating1 + match.change1;
+        seen++;
+    });
+    assert(seen == 10);
+    assert(std::abs(rating - system.getPlayer(alice).getRating()) < 0.001);
+
+    const char* path = "test_history.bin";
+    [[maybe_unused]] const auto saved = system.saveSnapshot(path);
+    assert(saved.has_value());
+    [[maybe_unused]] const auto loaded = system.loadSnapshot(path);
+    assert(loaded.has_value());
+    assert(system.getMatchHistory()->size() == 0);
+    std::remove(path);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 32: Rating Timeline
+ *
+ * Verify that with the timeline enabled every recorded match adds
+ * both players' new ratings, and that a time range selects them
+ */
+void testRatingTimeline()
+{
+    std::cout << "Test 32: Rating timeline..." << std::endl;
+
+    RankingSystem system;
+    assert(system.getRatingTimeline() == nullptr);
+
+    const PlayerId alice = *system.addPlayer("Alice", 1200.0);
+    const PlayerId bob = *system.addPlayer("Bob", 1300.0);
+    const PlayerId carol = *system.addPlayer("Carol", 1250.0);
+    system.enableRatingTimeline();
+
+    std::vector<double> aliceRatings;
+    for (int i = 0; i < 20; i++)
+    {
+        system.recordMatch(alice, i % 2 == 0 ? bob : carol, static_cast<MatchResult>(i % 3 - 1));
+        aliceRatings.push_back(system.getPlayer(alice).getRating());
+    }
+    assert(system.getRatingTimeline()->size() == 40);
+
+    const std::vector<RatingPoint> points = system.getRatingTimeline()->pointsBetween(alice, INT64_MIN, INT64_MAX);
+    assert(points.size() == 20);
+
+    /**
+     * Within half a timeline step; a fixed-point rating ending in 5
+     * thousandths is exactly half a step away, so allow for the
+     * floating-point error on top
+     */
+    [[maybe_unused]] const double halfStep = 0.5 / RatingTimeline::RatingSteps + 1e-9;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        assert(std::abs(points[i].rating - aliceRatings[i]) <= halfStep);
+        assert(i == 0 || points[i].timestamp >= points[i - 1].timestamp);
+    }
+    assert(system.getRatingTimeline()->pointsBetween(bob, INT64_MIN, INT64_MAX).size() == 10);
+
+    /**
+     * Nothing in the future, everything in the last day
+     */
+    [[maybe_unused]] const std::int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    assert(system.getRatingTimeline()->pointsBetween(alice, now + 1000, INT64_MAX).empty());
+    assert(system.getRatingTimeline()->pointsBetween(carol, now - 86'400'000, now).size() == 10);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 33: Saved Sequence
+ *
+ * Verify that a CSV file remembers the change sequence it includes,
+ * so a log that was not cleared after the save (a crash right after
+ * it) is not applied a second time
+ */
+void testSavedSequence()
+{
+    std::cout << "Test 33: Saved sequence..." << std::endl;
+
+    const char* savePath = "test_saved_sequence.csv";
+    const char* logPath = "test_saved_sequence.wal";
+    std::remove(logPath);
+
+    RankingSystem system;
+    [[maybe_unused]] const auto opened = system.openMatchLog(logPath);
+    assert(*opened == 0);
+    for (int i = 0; i < 10; i++)
+    {
+        system.addPlayer("Player" + std::to_string(i), 1200.0 + 10 * i);
+    }
+    for (int i = 0; i < 20; i++)
+    {
+        system.recordMatch(i % 10, (i + 3) % 10, static_cast<MatchResult>(i % 3 - 1));
+    }
+    [[maybe_unused]] const auto saved = system.saveToFile(savePath, FileChecksum::Crc32Footer);
+    assert(saved.has_value());
+
+    /**
+     * Two more matches after the save, then the "crash":
+     * the log still holds everything
+     */
+    system.recordMatch(0, 1, MatchResult::Player1Wins);
+    system.recordMatch(2, 3, MatchResult::Draw);
+    [[maybe_unused]] const auto closed = system.closeMatchLog();
+    assert(closed.has_value());
+
+    RankingSystem restarted;
+    [[maybe_unused]] const auto restartedLoaded = restarted.loadFromFile(savePath);
+    assert(*restartedLoaded == 10);
+    assert(restarted.getChangeSequence() == 30);
+    [[maybe_unused]] const auto restartedOpened = restarted.openMatchLog(logPath);
+    assert(*restartedOpened == 2);
+    assert(restarted.getChangeSequence() == system.getChangeSequence());
+    for (PlayerId id = 0; id < 10; id++)
+    {
+        assert(restarted.getPlayer(id).getRatingValue() == system.getPlayer(id).getRatingValue());
+        assert(restarted.getPlayer(id).getGamesPlayed() == system.getPlayer(id).getGamesPlayed());
+    }
+    [[maybe_unused]] const auto restartedClosed = restarted.closeMatchLog();
+    assert(restartedClosed.has_value());
+
+    /**
+     * The background save writes the sequence of its copy
+     */
+    [[maybe_unused]] const auto savedAgain = system.saveToFileAsync(savePath).get();
+    assert(savedAgain.has_value());
+    RankingSystem again;
+    [[maybe_unused]] const auto againLoaded = again.loadFromFile(savePath);
+    assert(*againLoaded == 10);
+    assert(again.getChangeSequence() == 32);
+    [[maybe_unused]] const auto againOpened = again.openMatchLog(logPath);
+    assert(*againOpened == 0);
+    [[maybe_unused]] const auto againClosed = again.closeMatchLog();
+    assert(againClosed.has_value());
+
+    /**
+     * A file saved before the sequence line existed takes the whole log
+     */
+    {
+        std::ofstream file(savePath, std::ios::binary);
+        file << "Player0,1200,0,0,0,0\n";
+    }
+    std::remove(logPath);
+    RankingSystem legacy;
+    [[maybe_unused]] const auto legacyLoaded = legacy.loadFromFile(savePath);
+    assert(*legacyLoaded == 1);
+    assert(legacy.getChangeSequence() == 0);
+    [[maybe_unused]] const auto legacyOpened = legacy.openMatchLog(logPath);
+    assert(*legacyOpened == 0);
+
+    std::remove(savePath);
+    std::remove(logPath);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 34: Rating Limits
+ *
+ * Verify that ratings and K-factors that cannot be stored are refused,
+ * and that a match at the edge of the range stays in it
+ * (with fixed-point ratings the range is about +-2.1 million points)
+ */
+void testRatingLimits()
+{
+    std::cout << "Test 34: Rating limits..." << std::endl;
+
+    RankingSystem system;
+    const auto top = system.addPlayer("Top", MaxRating);
+    const auto bottom = system.addPlayer("Bottom", MinRating);
+    assert(top.has_value() && bottom.has_value());
+
+    if constexpr (FixedPointRatings)
+    {
+        [[maybe_unused]] const auto above = system.addPlayer("Above", MaxRating + 1.0);
+        [[maybe_unused]] const auto below = system.restorePlayer("Below", MinRating - 1.0, PlayerStats{});
+        assert(above.error() == RankingError::InvalidRating);
+        assert(below.error() == RankingError::InvalidRating);
+
+        [[maybe_unused]] const MatchStatus bigK = system.recordMatch(*top, *bottom, MatchResult::Player1Wins, MaxRating * 2.0);
+        assert(bigK == MatchStatus::InvalidKFactor);
+    }
+    assert(system.getPlayerCount() == 2);
+
+    /**
+     * The favourite winning with the biggest K cannot push
+     * either rating past the end of the range
+     */
+    [[maybe_unused]] const MatchStatus status = system.recordMatch(*top, *bottom, MatchResult::Player1Wins, MaxRating);
+    assert(status == MatchStatus::Recorded);
+    assert(system.getPlayer(*top).getRating() <= MaxRating);
+    assert(system.getPlayer(*bottom).getRating() >= MinRating);
+    assert(system.getPlayer(*top).getRating() >= system.getPlayer(*bottom).getRating());
+
+    [[maybe_unused]] const MatchStatus upset = system.recordMatch(*bottom, *top, MatchResult::Player1Wins, MaxRating);
+    assert(upset == MatchStatus::Recorded);
+    assert(isValidRating(system.getPlayer(*top).getRating()));
+    assert(isValidRating(system.getPlayer(*bottom).getRating()));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 /**
  * MAIN TEST RUNNER
  */
@@ -401,6 +1712,28 @@ int main()
         testLoadFromFile();
         testMultipleMatchesInSystem();
         testLoadNonexistent();
+        testPlayerIds();
+        testRecordMatchById();
+        testRecordMatchInvalidIds();
+        testRecordMatchBatch();
+        testStatusResults();
+        testNoConsoleOutput();
+        testExpectedScoreMode();
+        testRankAndNeighborhood();
+        testLeaderboardPages();
+        testTopK();
+        testRestorePlayers();
+        testParallelLoad();
+        testSaveLoadRoundTrip();
+        testSafeSave();
+        testSnapshot();
+        testMatchLog();
+        testSaveToFileAsync();
+        testDeltas();
+        testMatchHistory();
+        testRatingTimeline();
+        testSavedSequence();
+        testRatingLimits();
 
         std::cout << std::endl;
         std::cout << "========================================" << std::endl;
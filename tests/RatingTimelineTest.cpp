@@ -0,0 +1,220 @@
+// Aleksandar Panich
+// Version 1.0
+
+#include "../src/RatingTimeline.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+const std::int64_t Day = 86'400'000;
+const std::int64_t Start = 1'700'000'000'000;
+
+/**
+ * Player p's n-th point: an uneven pace (8 hours apart, give or take one)
+ * and rating changes of up to 30 points either way
+ */
+RatingPoint makePoint(PlayerId p, size_t n)
+{
+    RatingPoint point;
+    point.timestamp = Start + static_cast<std::int64_t>(n) * Day / 3 +
+                      static_cast<std::int64_t>((n * 7919 + p * 31) % 3'600'000);
+    point.rating = 1200.0 + 30.0 * std::sin(static_cast<double>(n + p)) + static_cast<double>(n % 7) * 0.123;
+    return point;
+}
+
+/**
+ * What the timeline keeps of a point: whole seconds, 0.01 points
+ */
+RatingPoint rounded(const RatingPoint& point)
+{
+    return {point.timestamp / 1000 * 1000, std::round(point.rating * 100.0) / 100.0};
+}
+
+void assertSamePoint([[maybe_unused]] const RatingPoint& a, [[maybe_unused]] const RatingPoint& b)
+{
+    assert(a.timestamp == b.timestamp);
+    assert(std::abs(a.rating - b.rating) < 1e-9);
+}
+
+/**
+ * TEST 1: Round Trip
+ *
+ * Several players' points, added in turns and spread over many
+ * blocks, come back in order for each player
+ */
+void testRoundTrip()
+{
+    std::cout << "Test 1: Round trip..." << std::endl;
+
+    RatingTimeline timeline;
+    const size_t pointsEach = 500;
+    for (size_t n = 0; n < pointsEach; n++)
+    {
+        for (PlayerId p = 0; p < 5; p++)
+        {
+            const RatingPoint point = makePoint(p * 3, n);
+            timeline.append(p * 3, point.timestamp, point.rating);
+        }
+    }
+    assert(timeline.size() == pointsEach * 5);
+
+    for (PlayerId p = 0; p < 5; p++)
+    {
+        const std::vector<RatingPoint> points = timeline.pointsBetween(p * 3, INT64_MIN, INT64_MAX);
+        assert(points.size() == pointsEach);
+        for (size_t n = 0; n < pointsEach; n++)
+        {
+            assertSamePoint(points[n], rounded(makePoint(p * 3, n)));
+        }
+    }
+
+    /**
+     * Players in between, or past the end, have no points
+     */
+    assert(timeline.pointsBetween(1, INT64_MIN, INT64_MAX).empty());
+    assert(timeline.pointsBetween(1000, INT64_MIN, INT64_MAX).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 2: Time Range
+ *
+ * Exactly the points in the range, both ends included, and
+ * only the blocks holding them are read
+ */
+void testRange()
+{
+    std::cout << "Test 2: Time range..." << std::endl;
+
+    RatingTimeline timeline;
+    const size_t count = 3000;
+    for (size_t n = 0; n < count; n++)
+    {
+        const RatingPoint point = makePoint(7, n);
+        timeline.append(7, point.timestamp, point.rating);
+    }
+
+    const std::int64_t end = rounded(makePoint(7, count - 1)).timestamp;
+    for (const std::int64_t from : {end - 90 * Day, end - Day, Start + 100 * Day, end + 1})
+    {
+        for (const std::int64_t to : {end, end - 30 * Day, from + 999})
+        {
+            std::vector<RatingPoint> expected;
+            for (size_t n = 0; n < count; n++)
+            {
+                const RatingPoint point = rounded(makePoint(7, n));
+                if (point.timestamp >= from && point.timestamp <= to)
+                {
+                    expected.push_back(point);
+                }
+            }
+
+            const std::vector<RatingPoint> points = timeline.pointsBetween(7, from, to);
+            assert(points.size() == expected.size());
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                assertSamePoint(points[i], expected[i]);
+            }
+        }
+    }
+
+    /**
+     * A day of points takes far fewer bytes than the whole timeline
+     */
+    assert(timeline.bytesBetween(7, end - Day, end) < 400);
+    assert(timeline.bytesBetween(7, end - Day, end) * 20 < timeline.bytesBetween(7, INT64_MIN, INT64_MAX));
+    assert(timeline.bytesBetween(7, end + 1, end + Day) == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 3: Unusual Points
+ *
+ * Equal times, a time that goes back (kept at the previous time),
+ * and big jumps in rating and time
+ */
+void testUnusualPoints()
+{
+    std::cout << "Test 3: Unusual points..." << std::endl;
+
+    RatingTimeline timeline;
+    timeline.append(0, Start, 1200.0);
+    timeline.append(0, Start, 1216.0);
+    timeline.append(0, Start - 5000, 1201.5);
+    timeline.append(0, Start + 400 * Day, 2900.25);
+    timeline.append(0, Start + 400 * Day + 1000, 100.0);
+
+    const std::vector<RatingPoint> points = timeline.pointsBetween(0, INT64_MIN, INT64_MAX);
+    assert(points.size() == 5);
+    assertSamePoint(points[0], {Start, 1200.0});
+    assertSamePoint(points[1], {Start, 1216.0});
+    assertSamePoint(points[2], {Start, 1201.5});
+    assertSamePoint(points[3], {Start + 400 * Day, 2900.25});
+    assertSamePoint(points[4], {Start + 400 * Day + 1000, 100.0});
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * TEST 4: Compact
+ *
+ * A few bytes per point, and clear frees it all
+ */
+void testMemory()
+{
+    std::cout << "Test 4: Compact..." << std::endl;
+
+    RatingTimeline timeline;
+    for (size_t n = 0; n < 2000; n++)
+    {
+        for (PlayerId p = 0; p < 50; p++)
+        {
+            const RatingPoint point = makePoint(p, n);
+            timeline.append(p, point.timestamp, point.rating);
+        }
+    }
+
+    assert(timeline.memoryBytes() < timeline.size() * sizeof(RatingPoint) / 2);
+
+    timeline.clear();
+    assert(timeline.size() == 0);
+    assert(timeline.memoryBytes() == sizeof(RatingTimeline));
+    assert(timeline.pointsBetween(0, INT64_MIN, INT64_MAX).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+/**
+ * MAIN TEST RUNNER
+ */
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "Running RatingTimeline Tests..." << std::endl;
+    std::cout << std::endl;
+
+    try
+    {
+        testRoundTrip();
+        testRange();
+        testUnusualPoints();
+        testMemory();
+
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "All RatingTimeline tests passed!" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+
+        return 0;
+    }
+    catch (...)
+    {
+        std::cout << std::endl;
+        std::cout << "TEST FAILED!" << std::endl;
+        return 1;
+    }
+}